@@ -6,6 +6,7 @@
 CC_SRCS += \
 ../src/PASER/tables/PASER_neighbor_entry.cc \
 ../src/PASER/tables/PASER_neighbor_table.cc \
+../src/PASER/tables/PASER_prefix_trie.cc \
 ../src/PASER/tables/PASER_routing_entry.cc \
 ../src/PASER/tables/PASER_routing_table.cc \
 ../src/PASER/tables/PASER_rreq_list.cc 
@@ -13,6 +14,7 @@ CC_SRCS += \
 OBJS += \
 ./src/PASER/tables/PASER_neighbor_entry.o \
 ./src/PASER/tables/PASER_neighbor_table.o \
+./src/PASER/tables/PASER_prefix_trie.o \
 ./src/PASER/tables/PASER_routing_entry.o \
 ./src/PASER/tables/PASER_routing_table.o \
 ./src/PASER/tables/PASER_rreq_list.o 
@@ -20,6 +22,7 @@ OBJS += \
 CC_DEPS += \
 ./src/PASER/tables/PASER_neighbor_entry.d \
 ./src/PASER/tables/PASER_neighbor_table.d \
+./src/PASER/tables/PASER_prefix_trie.d \
 ./src/PASER/tables/PASER_routing_entry.d \
 ./src/PASER/tables/PASER_routing_table.d \
 ./src/PASER/tables/PASER_rreq_list.d 
@@ -29,7 +32,7 @@ CC_DEPS += \
 src/PASER/tables/%.o: ../src/PASER/tables/%.cc
 	@echo 'Building file: $<'
 	@echo 'Invoking: Cross G++ Compiler'
-	g++ -I/usr/include/libnl3 -O0 -g3 -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	g++ -I/usr/include/libnl3 -DPASER_ROUTING_TABLE_CHECK -O0 -g3 -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -4,19 +4,28 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CC_SRCS += \
+../src/PASER/crypto/PASER_cert_context.cc \
 ../src/PASER/crypto/PASER_crypto_hash.cc \
 ../src/PASER/crypto/PASER_crypto_sign.cc \
-../src/PASER/crypto/PASER_root.cc 
+../src/PASER/crypto/PASER_root.cc \
+../src/PASER/crypto/PASER_sign_suite.cc \
+../src/PASER/crypto/PASER_verify_pool.cc 
 
 OBJS += \
+./src/PASER/crypto/PASER_cert_context.o \
 ./src/PASER/crypto/PASER_crypto_hash.o \
 ./src/PASER/crypto/PASER_crypto_sign.o \
-./src/PASER/crypto/PASER_root.o 
+./src/PASER/crypto/PASER_root.o \
+./src/PASER/crypto/PASER_sign_suite.o \
+./src/PASER/crypto/PASER_verify_pool.o 
 
 CC_DEPS += \
+./src/PASER/crypto/PASER_cert_context.d \
 ./src/PASER/crypto/PASER_crypto_hash.d \
 ./src/PASER/crypto/PASER_crypto_sign.d \
-./src/PASER/crypto/PASER_root.d 
+./src/PASER/crypto/PASER_root.d \
+./src/PASER/crypto/PASER_sign_suite.d \
+./src/PASER/crypto/PASER_verify_pool.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
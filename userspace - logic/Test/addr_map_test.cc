@@ -0,0 +1,247 @@
+/**
+ *\file  		addr_map_test.cc
+ *@brief       	Test of PASER_addr_map and benchmark against std::map.
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/tables/PASER_addr_map.h"
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+paserd_conf conf;
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+/**
+ * Compare the map with the reference: same size, every key is found with
+ * its value and the iteration visits each key once.
+ */
+static int check(PASER_addr_map<u_int32_t> &map, std::map<Uint128, u_int32_t> &reference) {
+    if (map.size() != reference.size()) {
+        printf("FAIL: map has %u entries, expected %u\n", (u_int32_t) map.size(), (u_int32_t) reference.size());
+        return 0;
+    }
+    for (std::map<Uint128, u_int32_t>::iterator it = reference.begin(); it != reference.end(); it++) {
+        PASER_addr_map<u_int32_t>::iterator found = map.find(it->first);
+        if (found == map.end() || found->second != it->second) {
+            printf("FAIL: key %u is not found\n", (u_int32_t) it->first);
+            return 0;
+        }
+    }
+    size_t visited = 0;
+    for (PASER_addr_map<u_int32_t>::iterator it = map.begin(); it != map.end(); it++) {
+        if (reference.find(it->first) == reference.end()) {
+            printf("FAIL: key %u is not expected\n", (u_int32_t) it->first);
+            return 0;
+        }
+        visited++;
+    }
+    if (visited != reference.size()) {
+        printf("FAIL: iteration visits %u entries, expected %u\n", (u_int32_t) visited, (u_int32_t) reference.size());
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Home slot of a key in a map of 2^bits slots, as computed by PASER_addr_map.
+ */
+static u_int32_t home(Uint128 key, int bits) {
+    return (u_int32_t) (key * 2654435769u) >> (32 - bits);
+}
+
+/**
+ * Fill the smallest map with keys whose probe sequences collide and wrap
+ * around the end of the slot array. Insert and erase them in every order;
+ * after each erase the remaining keys must still be found.
+ */
+static int test_backward_shift() {
+    int bits = 0;
+    while ((1 << bits) < PASER_ADDR_MAP_MIN_SIZE) {
+        bits++;
+    }
+    u_int32_t last = PASER_ADDR_MAP_MIN_SIZE - 1;
+    std::vector<Uint128> keys;
+    // three keys in the last slot, two in the first and one in the second
+    for (Uint128 key = 1; keys.size() < 6; key++) {
+        u_int32_t h = home(key, bits);
+        size_t inLast = 0, inFirst = 0, inSecond = 0;
+        for (size_t i = 0; i < keys.size(); i++) {
+            u_int32_t kh = home(keys[i], bits);
+            inLast += kh == last;
+            inFirst += kh == 0;
+            inSecond += kh == 1;
+        }
+        if ((h == last && inLast < 3) || (h == 0 && inFirst < 2) || (h == 1 && inSecond < 1)) {
+            keys.push_back(key);
+        }
+    }
+    std::vector<int> order;
+    for (size_t i = 0; i < keys.size(); i++) {
+        order.push_back(i);
+    }
+    std::vector<int> sorted = order;
+    int orders = 0;
+    do {
+        // the keys are inserted in one order and erased in the other one
+        for (int pass = 0; pass < 2; pass++) {
+            std::vector<int> &insertOrder = pass ? order : sorted;
+            std::vector<int> &eraseOrder = pass ? sorted : order;
+            PASER_addr_map<u_int32_t> map;
+            std::map<Uint128, u_int32_t> reference;
+            for (size_t i = 0; i < insertOrder.size(); i++) {
+                map.insert(std::make_pair(keys[insertOrder[i]], (u_int32_t) i));
+                reference[keys[insertOrder[i]]] = i;
+            }
+            for (size_t i = 0; i < eraseOrder.size(); i++) {
+                Uint128 key = keys[eraseOrder[i]];
+                if (map.erase(key) != 1 || reference.erase(key) != 1 || !check(map, reference)) {
+                    printf("FAIL: backward shift, order %d\n", orders);
+                    return 0;
+                }
+            }
+        }
+        orders++;
+    } while (std::next_permutation(order.begin(), order.end()));
+    printf("backward shift erase: OK, %d orders\n", orders);
+    return 1;
+}
+
+/**
+ * Insert, erase and find random keys of a small range, so the map grows,
+ * collides and empties again, and compare it with std::map.
+ */
+static int test_random() {
+    PASER_addr_map<u_int32_t> map;
+    std::map<Uint128, u_int32_t> reference;
+    int count = 1000000;
+    for (int i = 0; i < count; i++) {
+        // the range of the keys changes, so the map fills up and empties again
+        Uint128 range = (i / 100000) % 2 ? 64 : 4096;
+        Uint128 key = htonl(0x0A000000 + rand() % range);
+        int op = rand() % 3;
+        if (op == 0) {
+            std::pair<PASER_addr_map<u_int32_t>::iterator, bool> inserted = map.insert(std::make_pair(key, (u_int32_t) i));
+            bool expected = reference.insert(std::make_pair(key, (u_int32_t) i)).second;
+            if (inserted.second != expected || inserted.first->first != key || inserted.first->second != reference[key]) {
+                printf("FAIL: insert of key %u\n", (u_int32_t) key);
+                return 0;
+            }
+        } else if (op == 1) {
+            PASER_addr_map<u_int32_t>::iterator it = map.find(key);
+            if ((it == map.end()) != (reference.find(key) == reference.end())) {
+                printf("FAIL: find of key %u\n", (u_int32_t) key);
+                return 0;
+            }
+            if (it != map.end()) {
+                map.erase(it);
+                reference.erase(key);
+            }
+        } else if (map.erase(key) != reference.erase(key)) {
+            printf("FAIL: erase of key %u\n", (u_int32_t) key);
+            return 0;
+        }
+        if (i % 10000 == 9999 && !check(map, reference)) {
+            printf("FAIL: after %d operations\n", i + 1);
+            return 0;
+        }
+    }
+    map.clear();
+    reference.clear();
+    if (!check(map, reference)) {
+        return 0;
+    }
+    printf("random operations: OK, %d operations\n", count);
+    return 1;
+}
+
+/**
+ * Measure find, and insert and erase of a neighbor, in tables of a mesh
+ * size: the map against std::map.
+ */
+static void bench(u_int32_t size) {
+    std::vector<Uint128> keys(size);
+    for (u_int32_t i = 0; i < size; i++) {
+        keys[i] = htonl(0x0A000001 + rand() % 0xFFFF00);
+    }
+    PASER_addr_map<void *> map;
+    std::map<Uint128, void *> tree;
+    for (u_int32_t i = 0; i < size; i++) {
+        map.insert(std::make_pair(keys[i], (void *) &keys[i]));
+        tree.insert(std::make_pair(keys[i], (void *) &keys[i]));
+    }
+    int count = 2000000;
+    std::vector<u_int32_t> order(count);
+    for (int i = 0; i < count; i++) {
+        order[i] = rand() % size;
+    }
+
+    u_int32_t found = 0;
+    double start = now_us();
+    for (int i = 0; i < count; i++) {
+        found += map.find(keys[order[i]]) != map.end();
+    }
+    double mapFind = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < count; i++) {
+        found += tree.find(keys[order[i]]) != tree.end();
+    }
+    double treeFind = now_us() - start;
+
+    // a neighbor leaves and comes back
+    start = now_us();
+    for (int i = 0; i < count; i++) {
+        Uint128 key = keys[order[i]];
+        map.erase(key);
+        map.insert(std::make_pair(key, (void *) &keys[order[i]]));
+    }
+    double mapChurn = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < count; i++) {
+        Uint128 key = keys[order[i]];
+        tree.erase(key);
+        tree.insert(std::make_pair(key, (void *) &keys[order[i]]));
+    }
+    double treeChurn = now_us() - start;
+
+    printf("%6u entries: find %5.1f ns (std::map %5.1f ns), erase+insert %5.1f ns (std::map %5.1f ns) %c\n", size,
+            mapFind * 1000 / count, treeFind * 1000 / count, mapChurn * 1000 / count, treeChurn * 1000 / count,
+            found == 2 * (u_int32_t) count ? ' ' : '!');
+}
+
+int main() {
+    srand(1);
+    if (!test_backward_shift() || !test_random()) {
+        return 1;
+    }
+    bench(20);
+    bench(100);
+    bench(500);
+    bench(2000);
+    bench(10000);
+    return 0;
+}
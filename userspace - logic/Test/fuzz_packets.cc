@@ -0,0 +1,319 @@
+/**
+ *\file  		fuzz_packets.cc
+ *@brief       	Fuzz harness of the parsers of the signed flooded packets (UB-RREQ, UU-RREP,
+ *              B-ROOT, RESET) and of PASER_wire_reader.
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************
+ * The harness is built in three ways (see makefile):
+ *  - with -DPASER_LIBFUZZER and clang++ -fsanitize=fuzzer as libFuzzer target,
+ *  - with afl-g++ for AFL: the program reads the inputs from the files in argv
+ *    (use @@) or from stdin if the argument is "-",
+ *  - standalone: without arguments the program mutates built-in packets of
+ *    all four types at random and runs each mutation through the harness.
+ ********************************************************************************/
+
+#include "src/PASER/packet_structure/PASER_UB_RREQ_view.h"
+#include "src/PASER/packet_structure/PASER_UU_RREP_view.h"
+#include "src/PASER/packet_structure/PASER_B_ROOT_view.h"
+#include "src/PASER/packet_structure/PASER_RESET_view.h"
+#include "paser_packets.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+paserd_conf conf;
+
+#define FUZZ_CHECK(cond) \
+    if (!(cond)) { \
+        fprintf(stderr, "fuzz_packets: check failed at line %d: %s\n", __LINE__, #cond); \
+        abort(); \
+    }
+
+static bool inside(lv_block span, const uint8_t *data, size_t size) {
+    return span.len >= 0 && span.buf >= data && span.buf + span.len <= data + size;
+}
+
+static bool same(lv_block a, lv_block b) {
+    return a.len == b.len && memcmp(a.buf, b.buf, a.len) == 0;
+}
+
+/**
+ * Walk a route list which was checked by parse(): it must contain
+ * <b>count</b> entries and end with <b>last</b>.
+ */
+static void check_address_list(PASER_wire_reader list, u_int32_t count, struct in_addr last, const uint8_t *data,
+        size_t size) {
+    struct in_addr addr;
+    addr.s_addr = 0;
+    lv_block ranges;
+    u_int32_t found = 0;
+    while (PASER_wire_reader::nextAddress(&list, &addr, &ranges)) {
+        FUZZ_CHECK(inside(ranges, data, size) && ranges.len % (2 * sizeof(in_addr_t)) == 0);
+        found++;
+    }
+    FUZZ_CHECK(found == count && list.left() == 0);
+    FUZZ_CHECK(addr.s_addr == last.s_addr);
+}
+
+/**
+ * Parse the input as UB-RREQ. If it is valid, the spans must lie inside of
+ * the input, the route list must contain addressCount entries and the
+ * materialized message must be serialized to an array which is parsed to
+ * the same fields. The check functions of the other types work the same way.
+ *
+ *@return 1 if the input is a valid UB-RREQ
+ */
+static int check_ub_rreq(const uint8_t *data, size_t size) {
+    PASER_UB_RREQ_view view;
+    if (!view.parse(data, size)) {
+        FUZZ_CHECK(view.error != NULL);
+        return 0;
+    }
+    FUZZ_CHECK(view.addressCount > 0);
+    if (view.GFlag) {
+        FUZZ_CHECK(inside(view.cert, data, size));
+    }
+    FUZZ_CHECK(inside(view.certForw, data, size));
+    FUZZ_CHECK(inside(view.root, data, size) && view.root.len == PASER_SECRET_HASH_LEN);
+    FUZZ_CHECK(inside(view.sign, data, size));
+    check_address_list(view.getAddressList(), view.addressCount, view.forwarding, data, size);
+
+    PASER_UB_RREQ *msg = PASER_UB_RREQ::create(&view);
+    int len = 0;
+    uint8_t *out = msg->getCompleteByteArray(&len);
+    delete msg;
+    PASER_UB_RREQ_view copy;
+    FUZZ_CHECK(copy.parse(out, len));
+    FUZZ_CHECK(copy.srcAddress_var.s_addr == view.srcAddress_var.s_addr);
+    FUZZ_CHECK(copy.destAddress_var.s_addr == view.destAddress_var.s_addr);
+    FUZZ_CHECK(copy.seq == view.seq && copy.keyNr == view.keyNr && copy.seqForw == view.seqForw);
+    FUZZ_CHECK(copy.addressCount == view.addressCount && copy.forwarding.s_addr == view.forwarding.s_addr);
+    FUZZ_CHECK(copy.metricBetweenQueryingAndForw == view.metricBetweenQueryingAndForw);
+    FUZZ_CHECK((copy.GFlag != 0) == (view.GFlag != 0));
+    if (view.GFlag) {
+        FUZZ_CHECK(copy.nonce == view.nonce && same(copy.cert, view.cert));
+    }
+    FUZZ_CHECK(same(copy.certForw, view.certForw) && same(copy.root, view.root));
+    FUZZ_CHECK(copy.initVector == view.initVector && copy.timestamp == view.timestamp);
+    FUZZ_CHECK(same(copy.sign, view.sign));
+    free(out);
+    return 1;
+}
+
+static int check_uu_rrep(const uint8_t *data, size_t size) {
+    PASER_UU_RREP_view view;
+    if (!view.parse(data, size)) {
+        FUZZ_CHECK(view.error != NULL);
+        return 0;
+    }
+    FUZZ_CHECK(inside(view.certForw, data, size));
+    FUZZ_CHECK(inside(view.root, data, size) && view.root.len == PASER_SECRET_HASH_LEN);
+    if (view.GFlag) {
+        FUZZ_CHECK(inside(view.kdc_data.GTK, data, size) && inside(view.kdc_data.CRL, data, size));
+        FUZZ_CHECK(inside(view.kdc_data.cert_kdc, data, size) && inside(view.kdc_data.sign, data, size));
+        FUZZ_CHECK(inside(view.kdc_data.sign_key, data, size));
+    }
+    FUZZ_CHECK(inside(view.sign, data, size));
+    check_address_list(view.getAddressList(), view.addressCount, view.forwarding, data, size);
+
+    PASER_UU_RREP *msg = PASER_UU_RREP::create(&view);
+    FUZZ_CHECK(msg->AddressRangeList.size() == view.addressCount);
+    int len = 0;
+    uint8_t *out = msg->getCompleteByteArray(&len);
+    delete msg;
+    PASER_UU_RREP_view copy;
+    FUZZ_CHECK(copy.parse(out, len));
+    FUZZ_CHECK(copy.srcAddress_var.s_addr == view.srcAddress_var.s_addr);
+    FUZZ_CHECK(copy.destAddress_var.s_addr == view.destAddress_var.s_addr);
+    FUZZ_CHECK(copy.seq == view.seq && copy.keyNr == view.keyNr);
+    FUZZ_CHECK(copy.addressCount == view.addressCount && copy.forwarding.s_addr == view.forwarding.s_addr);
+    FUZZ_CHECK(copy.metricBetweenQueryingAndForw == view.metricBetweenQueryingAndForw);
+    FUZZ_CHECK(copy.metricBetweenDestAndForw == view.metricBetweenDestAndForw);
+    FUZZ_CHECK((copy.GFlag != 0) == (view.GFlag != 0));
+    FUZZ_CHECK(same(copy.certForw, view.certForw) && same(copy.root, view.root));
+    FUZZ_CHECK(copy.initVector == view.initVector && copy.timestamp == view.timestamp);
+    if (view.GFlag) {
+        FUZZ_CHECK(same(copy.kdc_data.GTK, view.kdc_data.GTK) && copy.kdc_data.nonce == view.kdc_data.nonce);
+        FUZZ_CHECK(same(copy.kdc_data.CRL, view.kdc_data.CRL) && same(copy.kdc_data.cert_kdc, view.kdc_data.cert_kdc));
+        FUZZ_CHECK(same(copy.kdc_data.sign, view.kdc_data.sign) && copy.kdc_data.key_nr == view.kdc_data.key_nr);
+        FUZZ_CHECK(same(copy.kdc_data.sign_key, view.kdc_data.sign_key));
+    }
+    FUZZ_CHECK(same(copy.sign, view.sign));
+    free(out);
+    return 1;
+}
+
+static int check_b_root(const uint8_t *data, size_t size) {
+    PASER_B_ROOT_view view;
+    if (!view.parse(data, size)) {
+        FUZZ_CHECK(view.error != NULL);
+        return 0;
+    }
+    FUZZ_CHECK(inside(view.cert, data, size));
+    FUZZ_CHECK(inside(view.root, data, size) && view.root.len == PASER_SECRET_HASH_LEN);
+    FUZZ_CHECK(inside(view.sign, data, size));
+
+    PASER_B_ROOT *msg = PASER_B_ROOT::create(&view);
+    int len = 0;
+    uint8_t *out = msg->getCompleteByteArray(&len);
+    delete msg;
+    PASER_B_ROOT_view copy;
+    FUZZ_CHECK(copy.parse(out, len));
+    FUZZ_CHECK(copy.srcAddress_var.s_addr == view.srcAddress_var.s_addr && copy.seq == view.seq);
+    FUZZ_CHECK(same(copy.cert, view.cert) && same(copy.root, view.root));
+    FUZZ_CHECK(copy.initVector == view.initVector && copy.timestamp == view.timestamp);
+    FUZZ_CHECK(same(copy.sign, view.sign));
+    free(out);
+    return 1;
+}
+
+static int check_reset(const uint8_t *data, size_t size) {
+    PASER_RESET_view view;
+    if (!view.parse(data, size)) {
+        FUZZ_CHECK(view.error != NULL);
+        return 0;
+    }
+    FUZZ_CHECK(inside(view.cert, data, size) && inside(view.sign, data, size));
+
+    PASER_RESET *msg = PASER_RESET::create(&view);
+    int len = 0;
+    uint8_t *out = msg->getCompleteByteArray(&len);
+    delete msg;
+    PASER_RESET_view copy;
+    FUZZ_CHECK(copy.parse(out, len));
+    FUZZ_CHECK(copy.srcAddress_var.s_addr == view.srcAddress_var.s_addr && copy.keyNr == view.keyNr);
+    FUZZ_CHECK(same(copy.cert, view.cert) && same(copy.sign, view.sign));
+    free(out);
+    return 1;
+}
+
+/**
+ * Run the input through all parsers. The parsers check the packet type,
+ * so at most one of them accepts the input.
+ *
+ *@return 1 if the input is a valid packet
+ */
+static int check_packet(const uint8_t *data, size_t size) {
+    int valid = check_ub_rreq(data, size) + check_uu_rrep(data, size) + check_b_root(data, size)
+            + check_reset(data, size);
+    FUZZ_CHECK(valid <= 1);
+    return valid;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    check_packet(data, size);
+    return 0;
+}
+
+#ifndef PASER_LIBFUZZER
+
+static void run_file(FILE *file) {
+    std::vector<uint8_t> input;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+        input.insert(input.end(), buf, buf + n);
+    }
+    LLVMFuzzerTestOneInput(input.empty() ? NULL : &input[0], input.size());
+}
+
+/**
+ * Flip bytes, overwrite 32 bit fields (lengths and counts) and cut the packet.
+ */
+static void mutate(std::vector<uint8_t> *packet) {
+    int changes = 1 + rand() % 4;
+    for (int i = 0; i < changes && !packet->empty(); i++) {
+        size_t pos = rand() % packet->size();
+        switch (rand() % 4) {
+        case 0:
+            (*packet)[pos] ^= (uint8_t) (1 << (rand() % 8));
+            break;
+        case 1:
+            (*packet)[pos] = (uint8_t) rand();
+            break;
+        case 2: {
+            static const u_int32_t values[] = { 0, 1, 2, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0x40000000 };
+            u_int32_t value = values[rand() % (sizeof(values) / sizeof(values[0]))];
+            if (pos + sizeof(value) <= packet->size()) {
+                memcpy(&(*packet)[pos], &value, sizeof(value));
+            }
+            break;
+        }
+        default:
+            packet->resize(pos);
+            break;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "-") == 0) {
+                run_file(stdin);
+                continue;
+            }
+            FILE *file = fopen(argv[i], "rb");
+            if (file == NULL) {
+                perror(argv[i]);
+                return 1;
+            }
+            run_file(file);
+            fclose(file);
+        }
+        return 0;
+    }
+    std::vector<std::vector<uint8_t> > seeds;
+    int shapes[][4] = { { 1, 0, 0, 0 }, { 1, 1, 16, 1 }, { 3, 2, 64, 0 }, { 8, 4, 700, 1 } };
+    for (size_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+        uint8_t *packets[4];
+        int lens[4];
+        packets[0] = build_ub_rreq(shapes[i][0], shapes[i][1], shapes[i][2], shapes[i][3], &lens[0]);
+        packets[1] = build_uu_rrep(shapes[i][0], shapes[i][1], shapes[i][2], shapes[i][3], &lens[1]);
+        packets[2] = build_b_root(shapes[i][2], &lens[2]);
+        packets[3] = build_reset(shapes[i][2], &lens[3]);
+        for (int j = 0; j < 4; j++) {
+            seeds.push_back(std::vector<uint8_t>(packets[j], packets[j] + lens[j]));
+            free(packets[j]);
+            // the seeds must be valid
+            if (!check_packet(&seeds.back()[0], lens[j])) {
+                fprintf(stderr, "FAIL: seed %u of type %u is not parsed\n", (unsigned int) i, seeds.back()[0]);
+                return 1;
+            }
+        }
+    }
+    srand(1);
+    int iterations = 400000;
+    for (int i = 0; i < iterations; i++) {
+        std::vector<uint8_t> packet = seeds[rand() % seeds.size()];
+        mutate(&packet);
+        // a copy of exactly the packet size lets the sanitizers see overreads
+        uint8_t *input = (uint8_t *) malloc(packet.size() > 0 ? packet.size() : 1);
+        if (!packet.empty()) {
+            memcpy(input, &packet[0], packet.size());
+        }
+        LLVMFuzzerTestOneInput(input, packet.size());
+        free(input);
+    }
+    printf("%d mutated UB-RREQ, UU-RREP, B-ROOT and RESET packets: OK\n", iterations);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ *\file  		packet_parse_bench.cc
+ *@brief       	Benchmark of the parsers of the signed flooded packets (views against create()).
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/packet_structure/PASER_UB_RREQ_view.h"
+#include "src/PASER/packet_structure/PASER_UU_RREP_view.h"
+#include "src/PASER/packet_structure/PASER_B_ROOT_view.h"
+#include "src/PASER/packet_structure/PASER_RESET_view.h"
+#include "paser_packets.h"
+
+#include <sys/time.h>
+#include <stdio.h>
+
+paserd_conf conf;
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+/**
+ * Read the fields of a view which the packet processing uses before the
+ * message is materialized: the route list of the RREQ and RREP, else the
+ * signature.
+ */
+static u_int32_t walk(PASER_wire_reader list) {
+    u_int32_t sum = 0;
+    struct in_addr addr;
+    lv_block span;
+    while (PASER_wire_reader::nextAddress(&list, &addr, &span)) {
+        sum += addr.s_addr;
+    }
+    return sum;
+}
+
+static u_int32_t walk(const PASER_UB_RREQ_view &view) {
+    return walk(view.getAddressList());
+}
+
+static u_int32_t walk(const PASER_UU_RREP_view &view) {
+    return walk(view.getAddressList());
+}
+
+static u_int32_t walk(const PASER_B_ROOT_view &view) {
+    return view.sign.len;
+}
+
+static u_int32_t walk(const PASER_RESET_view &view) {
+    return view.sign.len;
+}
+
+/**
+ * Measure the view (parse and walk) and the materialized message (create())
+ * for one packet. The packet is freed.
+ */
+template<class VIEW, class MSG>
+static int bench(const char *name, uint8_t *packet, int len) {
+    int count = 200000;
+
+    u_int32_t sum = 0;
+    double start = now_us();
+    for (int i = 0; i < count; i++) {
+        VIEW view;
+        if (!view.parse(packet, len)) {
+            printf("FAIL: %s is not parsed (%s)\n", name, view.error);
+            free(packet);
+            return 0;
+        }
+        sum += walk(view);
+    }
+    double viewTime = now_us() - start;
+
+    start = now_us();
+    for (int i = 0; i < count; i++) {
+        VIEW view;
+        view.parse(packet, len);
+        MSG *msg = MSG::create(&view);
+        sum += msg->seq;
+        delete msg;
+    }
+    double createTime = now_us() - start;
+
+    printf("%-30s %5d bytes: view %7.1f ns (%6.0f MB/s), create %7.1f ns (%6.0f MB/s) %c\n", name, len,
+            viewTime * 1000 / count, (double) len * count / viewTime, createTime * 1000 / count,
+            (double) len * count / createTime, sum ? ' ' : '-');
+    free(packet);
+    return 1;
+}
+
+static int bench_ub_rreq(const char *name, int routes, int ranges, int certLen, bool gateway) {
+    int len = 0;
+    uint8_t *packet = build_ub_rreq(routes, ranges, certLen, gateway, &len);
+    return bench<PASER_UB_RREQ_view, PASER_UB_RREQ>(name, packet, len);
+}
+
+static int bench_uu_rrep(const char *name, int routes, int ranges, int certLen, bool gateway) {
+    int len = 0;
+    uint8_t *packet = build_uu_rrep(routes, ranges, certLen, gateway, &len);
+    return bench<PASER_UU_RREP_view, PASER_UU_RREP>(name, packet, len);
+}
+
+static int bench_b_root(const char *name, int certLen) {
+    int len = 0;
+    uint8_t *packet = build_b_root(certLen, &len);
+    return bench<PASER_B_ROOT_view, PASER_B_ROOT>(name, packet, len);
+}
+
+static int bench_reset(const char *name, int certLen) {
+    int len = 0;
+    uint8_t *packet = build_reset(certLen, &len);
+    return bench<PASER_RESET_view, PASER_RESET>(name, packet, len);
+}
+
+int main() {
+    if (!bench_ub_rreq("UB-RREQ 1 hop", 1, 0, 700, false)
+            || !bench_ub_rreq("UB-RREQ 1 hop, gateway", 1, 1, 700, true)
+            || !bench_ub_rreq("UB-RREQ 8 hops", 8, 1, 700, false)
+            || !bench_ub_rreq("UB-RREQ 32 hops, 4 subnets", 32, 4, 700, false)
+            || !bench_uu_rrep("UU-RREP 1 hop", 1, 0, 700, false)
+            || !bench_uu_rrep("UU-RREP 8 hops", 8, 1, 700, false)
+            || !bench_uu_rrep("UU-RREP 8 hops, KDC block", 8, 1, 700, true)
+            || !bench_b_root("B-ROOT", 700)
+            || !bench_reset("RESET", 700)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ *\file  		paser_packets.h
+ *@brief       	Signed flooded PASER packets for the fuzz harness and the parser benchmark.
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#ifndef PASER_PACKETS_H_
+#define PASER_PACKETS_H_
+
+#include "src/PASER/packet_structure/PASER_UB_RREQ.h"
+#include "src/PASER/packet_structure/PASER_UU_RREP.h"
+#include "src/PASER/packet_structure/PASER_B_ROOT.h"
+#include "src/PASER/packet_structure/PASER_RESET.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static lv_block make_blob(int len, uint8_t fill) {
+    lv_block blob;
+    blob.buf = (uint8_t *) malloc(len > 0 ? len : 1);
+    blob.len = len;
+    memset(blob.buf, fill, len);
+    return blob;
+}
+
+/**
+ * Fill a route list with <b>routes</b> entries of <b>ranges</b> subnetworks.
+ */
+static void make_route_list(std::list<address_list> *list, int routes, int ranges) {
+    for (int i = 0; i < routes; i++) {
+        address_list entry;
+        entry.ipaddr.s_addr = htonl(0x0A000001 + i);
+        for (int j = 0; j < ranges; j++) {
+            address_range range;
+            range.ipaddr.s_addr = htonl(0xC0A80000 + (i << 8) + j);
+            range.mask.s_addr = htonl(0xFFFFFF00);
+            entry.range.push_back(range);
+        }
+        list->push_back(entry);
+    }
+}
+
+/**
+ * Build the wire format of an UB-RREQ.
+ *
+ *@param routes number of entries of the route list
+ *@param ranges number of subnetworks per entry
+ *@param certLen length of the certificates
+ *@param gateway set GFlag (adds nonce and certificate of the querying node)
+ *@param len length of the returned array
+ *
+ *@return array which must be freed with free()
+ */
+static uint8_t *build_ub_rreq(int routes, int ranges, int certLen, bool gateway, int *len) {
+    struct in_addr src, dest;
+    src.s_addr = htonl(0x0A000001);
+    dest.s_addr = htonl(0x0A0000FE);
+    PASER_UB_RREQ packet(src, dest, 42);
+    packet.keyNr = 3;
+    packet.seqForw = 17;
+    packet.searchGW = 1;
+    packet.GFlag = gateway ? 1 : 0;
+    make_route_list(&packet.AddressRangeList, routes, ranges);
+    packet.metricBetweenQueryingAndForw = routes;
+    packet.nonce = 0x12345678;
+    if (gateway) {
+        packet.cert = make_blob(certLen, 0xC1);
+    }
+    packet.certForw = make_blob(certLen, 0xC2);
+    packet.root = make_blob(PASER_SECRET_HASH_LEN, 0x52).buf;
+    packet.initVector = 7;
+    packet.geoQuerying.lat = 51.49;
+    packet.geoQuerying.lon = 7.41;
+    packet.geoForwarding.lat = 51.5;
+    packet.geoForwarding.lon = 7.42;
+    packet.timestamp = 1000;
+    packet.sign = make_blob(256, 0x53);
+    return packet.getCompleteByteArray(len);
+}
+
+/**
+ * Build the wire format of an UU-RREP.
+ *
+ *@param routes number of entries of the route list
+ *@param ranges number of subnetworks per entry
+ *@param certLen length of the certificates
+ *@param gateway set GFlag (adds the KDC block)
+ *@param len length of the returned array
+ *
+ *@return array which must be freed with free()
+ */
+static uint8_t *build_uu_rrep(int routes, int ranges, int certLen, bool gateway, int *len) {
+    struct in_addr src, dest;
+    src.s_addr = htonl(0x0A000001);
+    dest.s_addr = htonl(0x0A0000FE);
+    PASER_UU_RREP packet(src, dest, 42);
+    packet.keyNr = 3;
+    packet.searchGW = 0;
+    packet.GFlag = gateway ? 1 : 0;
+    make_route_list(&packet.AddressRangeList, routes, ranges);
+    packet.metricBetweenQueryingAndForw = routes;
+    packet.metricBetweenDestAndForw = 1;
+    packet.certForw = make_blob(certLen, 0xC2);
+    packet.root = make_blob(PASER_SECRET_HASH_LEN, 0x52).buf;
+    packet.initVector = 7;
+    packet.geoDestination.lat = 51.49;
+    packet.geoDestination.lon = 7.41;
+    packet.geoForwarding.lat = 51.5;
+    packet.geoForwarding.lon = 7.42;
+    if (gateway) {
+        packet.kdc_data.GTK = make_blob(32, 0x47);
+        packet.kdc_data.nonce = 0x12345678;
+        packet.kdc_data.CRL = make_blob(64, 0x43);
+        packet.kdc_data.cert_kdc = make_blob(certLen, 0xC3);
+        packet.kdc_data.sign = make_blob(256, 0x54);
+        packet.kdc_data.key_nr = 3;
+        packet.kdc_data.sign_key = make_blob(256, 0x55);
+    }
+    packet.timestamp = 1000;
+    packet.sign = make_blob(256, 0x53);
+    return packet.getCompleteByteArray(len);
+}
+
+/**
+ * Build the wire format of a B-ROOT.
+ *
+ *@param certLen length of the certificate
+ *@param len length of the returned array
+ *
+ *@return array which must be freed with free()
+ */
+static uint8_t *build_b_root(int certLen, int *len) {
+    struct in_addr src;
+    src.s_addr = htonl(0x0A000001);
+    PASER_B_ROOT packet(src, 42);
+    // the destructor frees only a certificate which is not empty
+    if (certLen > 0) {
+        packet.cert = make_blob(certLen, 0xC1);
+    }
+    packet.root = make_blob(PASER_SECRET_HASH_LEN, 0x52).buf;
+    packet.initVector = 7;
+    packet.geoQuerying.lat = 51.49;
+    packet.geoQuerying.lon = 7.41;
+    packet.timestamp = 1000;
+    packet.sign = make_blob(256, 0x53);
+    return packet.getCompleteByteArray(len);
+}
+
+/**
+ * Build the wire format of a RESET.
+ *
+ *@param certLen length of the certificate of the KDC
+ *@param len length of the returned array
+ *
+ *@return array which must be freed with free()
+ */
+static uint8_t *build_reset(int certLen, int *len) {
+    struct in_addr src;
+    src.s_addr = htonl(0x0A000001);
+    PASER_RESET packet(src);
+    packet.keyNr = 3;
+    packet.cert = make_blob(certLen, 0xC3);
+    packet.sign = make_blob(256, 0x53);
+    return packet.getCompleteByteArray(len);
+}
+
+#endif /* PASER_PACKETS_H_ */
@@ -0,0 +1,170 @@
+/**
+ *\file  		paser_stubs.cc
+ *@brief       	Stubs of the daemon for the standalone tests.
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************
+ * The tested modules are created without a PASER_global object (pGlobal == NULL).
+ * Logging is discarded. The modules which keep pointers to other modules in
+ * their constructor get NULL. All other functions of the daemon abort the test.
+ ********************************************************************************/
+
+#include "src/PASER/config/PASER_global.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+paserd_conf conf;
+
+static void unavailable(const char *function) {
+    fprintf(stderr, "%s is not available in the tests\n", function);
+    abort();
+}
+
+PASER_syslog *PASER_global::getSyslog() {
+    return NULL;
+}
+
+void PASER_syslog::PASER_log(int level, const char *format, ...) {
+}
+
+PASER_timer_queue *PASER_global::getTimer_queue() {
+    return NULL;
+}
+
+PASER_neighbor_table *PASER_global::getNeighbor_table() {
+    return NULL;
+}
+
+PASER_routing_table *PASER_global::getRouting_table() {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+PASER_socket *PASER_global::getPASER_socket() {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+PASER_statistics *PASER_global::getPaserStatistic() {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+bool PASER_global::isSeqNew(u_int32_t oldSeq, u_int32_t newSeq) {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+PASER_config *PASER_global::getPaser_configuration() {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+PASER_packet_sender *PASER_global::getPacketSender() {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+void PASER_global::incSeqNr() {
+    unavailable(__FUNCTION__);
+}
+
+int PASER_global::getPASERtimeofday(struct timeval *val) {
+    unavailable(__FUNCTION__);
+    return 0;
+}
+
+int PASER_config::getIfIdFromIfIndex(u_int32_t ifIndex) {
+    unavailable(__FUNCTION__);
+    return -1;
+}
+
+network_device *PASER_config::getNetDevice() {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+std::list<address_range> PASER_config::getAddL() {
+    unavailable(__FUNCTION__);
+    return std::list<address_range>();
+}
+
+u_int32_t PASER_config::getRootRepetitionsTimeout() {
+    unavailable(__FUNCTION__);
+    return 0;
+}
+
+u_int32_t PASER_config::getRootRepetitions() {
+    unavailable(__FUNCTION__);
+    return 0;
+}
+
+void PASER_packet_sender::send_root() {
+    unavailable(__FUNCTION__);
+}
+
+PASER_neighbor_entry *PASER_neighbor_table::findNeigh(struct in_addr addr) {
+    unavailable(__FUNCTION__);
+    return NULL;
+}
+
+void PASER_neighbor_table::updateNeighborTableTimeout(struct in_addr neighbor, struct timeval now) {
+    unavailable(__FUNCTION__);
+}
+
+bool PASER_socket::replaceRouteDev(in_addr destIP, in_addr destMask, network_device *netDevice, bool isNew) {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+bool PASER_socket::replaceRouteVia(in_addr destIP, in_addr destMask, in_addr neighborIP, bool isNew) {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+bool PASER_socket::deleteRoute(in_addr destIP, in_addr destMask) {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+bool PASER_socket::addDefaultRoute(in_addr destIP, network_device *netDevice, int metric) {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+bool PASER_socket::deleteDefaultRoute() {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+bool PASER_socket::setGWFlag(bool flag) {
+    unavailable(__FUNCTION__);
+    return false;
+}
+
+void PASER_socket::getFailedRoutes(std::list<std::pair<Uint128, Uint128> > *routes) {
+    unavailable(__FUNCTION__);
+}
+
+void PASER_statistics::routingTableModificationAdd(struct in_addr dest, struct in_addr nextHop) {
+    unavailable(__FUNCTION__);
+}
+
+void PASER_statistics::routingTableModificationDelete(struct in_addr dest) {
+    unavailable(__FUNCTION__);
+}
@@ -0,0 +1,159 @@
+/**
+ *\file  		root_test.cc
+ *@brief       	Test and benchmark of the authentication tree (PASER_root).
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/crypto/PASER_root.h"
+
+#include <openssl/sha.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static void free_path(std::list<uint8_t *> *path) {
+    for (std::list<uint8_t *>::iterator it = path->begin(); it != path->end(); it++) {
+        free(*it);
+    }
+    path->clear();
+}
+
+/**
+ * Compute the root of the secrets level by level, like the former list based tree.
+ */
+static std::vector<uint8_t> reference_root(const std::vector<uint8_t> &secrets, uint32_t count) {
+    std::vector<uint8_t> level(count * SHA256_DIGEST_LENGTH);
+    for (uint32_t i = 0; i < count; i++) {
+        SHA256(&secrets[i * PASER_SECRET_LEN], SHA256_DIGEST_LENGTH, &level[i * SHA256_DIGEST_LENGTH]);
+    }
+    while (count > 1) {
+        count /= 2;
+        std::vector<uint8_t> upper(count * SHA256_DIGEST_LENGTH);
+        for (uint32_t i = 0; i < count; i++) {
+            SHA256(&level[2 * i * SHA256_DIGEST_LENGTH], 2 * SHA256_DIGEST_LENGTH, &upper[i * SHA256_DIGEST_LENGTH]);
+        }
+        level.swap(upper);
+    }
+    return level;
+}
+
+/**
+ * Use all secrets of a tree with 2^param secrets. Each authentication path
+ * must lead to the root, the root must match the reference and a modified
+ * path must be rejected.
+ */
+static int test_tree(int param) {
+    PASER_root root(NULL);
+    if (!root.init(param)) {
+        printf("FAIL: init(%d)\n", param);
+        return 0;
+    }
+    uint8_t *rootElem = root.getRoot();
+    uint32_t count = 1 << param;
+    std::vector<uint8_t> secrets(count * PASER_SECRET_LEN);
+    uint32_t iv = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int nr = -1;
+        uint8_t *secret = &secrets[i * PASER_SECRET_LEN];
+        std::list<uint8_t *> path = root.getNextSecret(&nr, secret);
+        if (nr != (int) i || path.size() != (size_t) param) {
+            printf("FAIL: param %d secret %u has IV %d and %u path nodes\n", param, i, nr, (u_int32_t) path.size());
+            return 0;
+        }
+        uint32_t newIV = 0;
+        if (root.checkRoot(rootElem, secret, path, iv, &newIV) != 1 || newIV != i + 1) {
+            printf("FAIL: param %d secret %u is rejected\n", param, i);
+            return 0;
+        }
+        if (param > 0) {
+            path.front()[0] ^= 0x01;
+            uint32_t wrongIV = 0;
+            if (root.checkRoot(rootElem, secret, path, iv, &wrongIV) == 1) {
+                printf("FAIL: param %d secret %u is accepted with a wrong path\n", param, i);
+                return 0;
+            }
+        }
+        iv = newIV;
+        free_path(&path);
+    }
+    std::vector<uint8_t> expected = reference_root(secrets, count);
+    if (memcmp(&expected[0], rootElem, SHA256_DIGEST_LENGTH) != 0) {
+        printf("FAIL: param %d root differs from the reference\n", param);
+        return 0;
+    }
+    free(rootElem);
+    printf("tree with 2^%d secrets: OK\n", param);
+    return 1;
+}
+
+/**
+ * Measure the generation of a tree and the cost of getNextSecret and checkRoot.
+ */
+static void bench(int param) {
+    PASER_root root(NULL);
+    double start = now_us();
+    root.init(param);
+    double generate = now_us() - start;
+
+    uint8_t *rootElem = root.getRoot();
+    uint32_t calls = 1 << param;
+    if (calls > 4096) {
+        calls = 4096;
+    }
+    std::vector<std::list<uint8_t *> > paths(calls);
+    std::vector<uint8_t> secrets(calls * PASER_SECRET_LEN);
+    start = now_us();
+    for (uint32_t i = 0; i < calls; i++) {
+        int nr;
+        paths[i] = root.getNextSecret(&nr, &secrets[i * PASER_SECRET_LEN]);
+    }
+    double next = now_us() - start;
+
+    start = now_us();
+    for (uint32_t i = 0; i < calls; i++) {
+        uint32_t newIV;
+        root.checkRoot(rootElem, &secrets[i * PASER_SECRET_LEN], paths[i], 0, &newIV);
+    }
+    double check = now_us() - start;
+
+    printf("2^%d secrets: generate %9.1f ms, getNextSecret %6.2f us, checkRoot %6.2f us\n", param, generate / 1000,
+            next / calls, check / calls);
+    for (uint32_t i = 0; i < calls; i++) {
+        free_path(&paths[i]);
+    }
+    free(rootElem);
+}
+
+int main() {
+    for (int param = 1; param <= 10; param++) {
+        if (!test_tree(param)) {
+            return 1;
+        }
+    }
+    for (int param = 10; param <= 18; param += 2) {
+        bench(param);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ *\file  		root_tree_bench.cc
+ *@brief       	Benchmark of the parallel calculation of the authentication tree (PASER_root).
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+// calculateTree and calculateSubtree are private. The system headers
+// are included before the access of the PASER classes is changed.
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
+#include <openssl/ssl.h>
+#include <iostream>
+#include <sstream>
+#include <list>
+#include <map>
+#include <vector>
+#define private public
+#include "src/PASER/crypto/PASER_root.h"
+#undef private
+
+#include <openssl/sha.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+/**
+ * Calculate the tree of 2^param secrets on one thread and with calculateTree,
+ * which uses several threads from PASER_ROOT_PARALLEL_MIN_SECRETS secrets on.
+ * Both trees must be equal.
+ */
+static int bench(int param) {
+    PASER_root root(NULL);
+    if (!root.init(param)) {
+        printf("FAIL: init(%d)\n", param);
+        return 0;
+    }
+    size_t treeLen = (size_t) SHA256_DIGEST_LENGTH * 2 * root.secret_count;
+    uint8_t *serialTree = (uint8_t *) malloc(treeLen);
+
+    double start = now_us();
+    root.calculateSubtree(root.secrets, serialTree, 1, param);
+    double serial = now_us() - start;
+
+    start = now_us();
+    root.calculateTree(root.secrets, root.tree);
+    double parallel = now_us() - start;
+
+    // node 0 is not used
+    int equal = memcmp(serialTree + SHA256_DIGEST_LENGTH, root.tree + SHA256_DIGEST_LENGTH, treeLen - SHA256_DIGEST_LENGTH) == 0;
+    free(serialTree);
+    if (!equal) {
+        printf("FAIL: parallel tree with 2^%d secrets differs\n", param);
+        return 0;
+    }
+    printf("2^%d secrets: one thread %9.1f ms, calculateTree %9.1f ms, speedup %4.2f\n", param, serial / 1000,
+            parallel / 1000, serial / parallel);
+    return 1;
+}
+
+int main() {
+    printf("hardware threads: %u\n", boost::thread::hardware_concurrency());
+    for (int param = 10; param <= 20; param += 2) {
+        if (!bench(param)) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ *\file  		routing_table_bench.cc
+ *@brief       	Benchmark of route refreshes in PASER_routing_table.
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/tables/PASER_routing_table.h"
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <vector>
+
+/// Number of neighbors over which the destinations are reached
+#define BENCH_NEIGHBORS 200
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static struct in_addr dest_addr(u_int32_t i) {
+    struct in_addr addr;
+    addr.s_addr = htonl(0x0A000001 + i);
+    return addr;
+}
+
+static struct in_addr neighbor_addr(u_int32_t i) {
+    struct in_addr addr;
+    addr.s_addr = htonl(0xAC100001 + i);
+    return addr;
+}
+
+/**
+ * Fill a table with <b>count</b> destinations and refresh random routes
+ * like a received RREQ or RREP does: find the entry and update it in place.
+ */
+static int bench(u_int32_t count) {
+    PASER_routing_table table(NULL);
+    std::list<address_range> noRanges;
+    std::vector<PASER_routing_entry *> entries(count);
+    for (u_int32_t i = 0; i < count; i++) {
+        entries[i] = table.insert(dest_addr(i), neighbor_addr(i % BENCH_NEIGHBORS), NULL, NULL, 1, 2 + i % 8, 0, noRanges, NULL);
+    }
+    int refreshes = 1000000;
+    std::vector<u_int32_t> order(refreshes);
+    for (int i = 0; i < refreshes; i++) {
+        order[i] = rand() % count;
+    }
+
+    u_int32_t found = 0;
+    double start = now_us();
+    for (int i = 0; i < refreshes; i++) {
+        found += table.findDest(dest_addr(order[i])) != NULL;
+    }
+    double findTime = now_us() - start;
+
+    start = now_us();
+    for (int i = 0; i < refreshes; i++) {
+        u_int32_t index = order[i];
+        struct in_addr dest = dest_addr(index);
+        PASER_routing_entry *entry = table.findDest(dest);
+        // every fourth refresh comes over another neighbor
+        struct in_addr nextHop = neighbor_addr((index + (i % 4 == 0)) % BENCH_NEIGHBORS);
+        table.update(entry, dest, nextHop, NULL, NULL, i, 2 + i % 8, 0, noRanges, NULL);
+    }
+    double refreshTime = now_us() - start;
+
+    for (u_int32_t i = 0; i < count; i++) {
+        if (table.findDest(dest_addr(i)) != entries[i]) {
+            printf("FAIL: entry %u is moved by update()\n", i);
+            return 0;
+        }
+    }
+    if (found != (u_int32_t) refreshes || table.getSize() != (int) count) {
+        printf("FAIL: %u of %d destinations found, table has %d entries\n", found, refreshes, table.getSize());
+        return 0;
+    }
+    printf("%6u destinations: findDest %6.1f ns, refresh %6.1f ns\n", count, findTime * 1000 / refreshes,
+            refreshTime * 1000 / refreshes);
+    return 1;
+}
+
+int main() {
+    srand(1);
+    if (!bench(1000) || !bench(10000) || !bench(100000)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ *\file  		routing_table_test.cc
+ *@brief       	Churn test of the next hop and gateway indexes of PASER_routing_table.
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/tables/PASER_routing_table.h"
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <map>
+#include <set>
+#include <vector>
+
+/// Number of neighbors over which the routes are churned
+#define TEST_NEIGHBORS 200
+/// Number of routes in the table
+#define TEST_ROUTES 10000
+/// Every TEST_GW_EVERY-th route is a route to a gateway
+#define TEST_GW_EVERY 50
+
+/**
+ * Expected state of a routing entry.
+ */
+struct route_model {
+    PASER_routing_entry *entry;
+    u_int32_t nextHop;
+    u_int8_t hopcnt;
+    u_int8_t isGW;
+    u_int8_t isValid;
+};
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static struct in_addr neighbor_addr(int i) {
+    struct in_addr addr;
+    addr.s_addr = htonl(0x0A010001 + i);
+    return addr;
+}
+
+static struct in_addr dest_addr(int i) {
+    struct in_addr addr;
+    addr.s_addr = htonl(0x0A020001 + i);
+    return addr;
+}
+
+static struct in_addr random_neighbor() {
+    return neighbor_addr(rand() % TEST_NEIGHBORS);
+}
+
+/**
+ * Compare the table with the expected state: all entries must be found,
+ * each next hop must list exactly its entries and the best gateway must
+ * be a valid gateway with the lowest metric.
+ */
+static int check(PASER_routing_table *table, std::vector<route_model> &model) {
+    if (table->getSize() != (int) model.size()) {
+        printf("FAIL: table has %d entries, expected %u\n", table->getSize(), (u_int32_t) model.size());
+        return 0;
+    }
+    std::map<u_int32_t, std::set<PASER_routing_entry *> > expected;
+    u_int32_t gateways = 0;
+    int bestMetric = -1;
+    for (u_int32_t i = 0; i < model.size(); i++) {
+        route_model &m = model[i];
+        if (table->findDest(dest_addr(i)) != m.entry || m.entry->nxthop_addr.s_addr != m.nextHop
+                || m.entry->hopcnt != m.hopcnt || m.entry->isValid != m.isValid) {
+            printf("FAIL: entry %u is not found or changed\n", i);
+            return 0;
+        }
+        expected[m.nextHop].insert(m.entry);
+        if (m.isGW && m.isValid) {
+            gateways++;
+            if (bestMetric < 0 || m.hopcnt < bestMetric) {
+                bestMetric = m.hopcnt;
+            }
+        }
+    }
+    for (int i = 0; i < TEST_NEIGHBORS; i++) {
+        std::list<PASER_routing_entry *> list = table->getListWithNextHop(neighbor_addr(i));
+        std::set<PASER_routing_entry *> found(list.begin(), list.end());
+        if (found.size() != list.size() || found != expected[neighbor_addr(i).s_addr]) {
+            printf("FAIL: next hop %d lists %u entries, expected %u\n", i, (u_int32_t) list.size(),
+                    (u_int32_t) expected[neighbor_addr(i).s_addr].size());
+            return 0;
+        }
+    }
+    PASER_routing_entry *best = table->findBestGW();
+    if (table->getRoutesToGw().size() != gateways) {
+        printf("FAIL: %u routes to gateways, expected %u\n", (u_int32_t) table->getRoutesToGw().size(), gateways);
+        return 0;
+    }
+    if (gateways == 0 ? best != NULL : (!best || !best->is_gw || !best->isValid || best->hopcnt != bestMetric)) {
+        printf("FAIL: wrong best gateway\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main() {
+    PASER_routing_table table(NULL);
+    std::vector<route_model> model(TEST_ROUTES);
+    std::list<address_range> noRanges;
+    srand(1);
+
+    for (u_int32_t i = 0; i < model.size(); i++) {
+        route_model &m = model[i];
+        m.nextHop = random_neighbor().s_addr;
+        m.hopcnt = 2 + rand() % 10;
+        m.isGW = (i % TEST_GW_EVERY) == 0;
+        m.isValid = 1;
+        struct in_addr nextHop;
+        nextHop.s_addr = m.nextHop;
+        m.entry = table.insert(dest_addr(i), nextHop, NULL, NULL, 1, m.hopcnt, m.isGW, noRanges, NULL);
+    }
+    if (!check(&table, model)) {
+        return 1;
+    }
+
+    // churn: move, update, replace, invalidate and re-rate the routes
+    int count = 200000;
+    double churnTime = 0;
+    for (int i = 0; i < count; i++) {
+        u_int32_t index = rand() % model.size();
+        route_model &m = model[index];
+        struct in_addr nextHop = random_neighbor();
+        int op = rand() % 100;
+        double start = now_us();
+        if (op < 30) {
+            m.hopcnt = 2 + rand() % 10;
+            table.update(m.entry, dest_addr(index), nextHop, NULL, NULL, 0, m.hopcnt, m.isGW, noRanges, NULL);
+            m.nextHop = nextHop.s_addr;
+            m.isValid = 1;
+        } else if (op < 55) {
+            table.setNextHop(m.entry, nextHop);
+            m.nextHop = nextHop.s_addr;
+        } else if (op < 70) {
+            table.delete_entry(m.entry);
+            delete m.entry;
+            m.hopcnt = 2 + rand() % 10;
+            m.entry = table.insert(dest_addr(index), nextHop, NULL, NULL, 1, m.hopcnt, m.isGW, noRanges, NULL);
+            m.nextHop = nextHop.s_addr;
+            m.isValid = 1;
+        } else if (op < 85) {
+            m.isValid = !m.isValid;
+            table.setValid(m.entry, m.isValid);
+        } else {
+            m.hopcnt = 2 + rand() % 10;
+            table.setMetric(m.entry, m.hopcnt);
+        }
+        churnTime += now_us() - start;
+        if (i % 1000 == 999 && !check(&table, model)) {
+            printf("FAIL: after %d operations\n", i + 1);
+            return 1;
+        }
+    }
+
+    // link loss of every neighbor: the routes over it are found by the index
+    // and, as before the index, by a scan of all routes
+    u_int32_t found = 0;
+    double start = now_us();
+    for (int i = 0; i < TEST_NEIGHBORS; i++) {
+        found += table.getListWithNextHop(neighbor_addr(i)).size();
+    }
+    double indexTime = now_us() - start;
+    u_int32_t scanned = 0;
+    start = now_us();
+    for (int i = 0; i < TEST_NEIGHBORS; i++) {
+        struct in_addr nextHop = neighbor_addr(i);
+        std::list<PASER_routing_entry *> list;
+        for (u_int32_t j = 0; j < model.size(); j++) {
+            if (model[j].entry->nxthop_addr.s_addr == nextHop.s_addr) {
+                list.push_back(model[j].entry);
+            }
+        }
+        scanned += list.size();
+    }
+    double scanTime = now_us() - start;
+    if (found != model.size() || scanned != model.size()) {
+        printf("FAIL: %u routes found over the next hops, expected %u\n", found, (u_int32_t) model.size());
+        return 1;
+    }
+
+    printf("%d routes, %d neighbors: OK, %d operations %.1f ns/op\n", TEST_ROUTES, TEST_NEIGHBORS, count,
+            churnTime * 1000 / count);
+    printf("routes over a lost neighbor: index %.2f us, scan of all routes %.2f us\n", indexTime / TEST_NEIGHBORS,
+            scanTime / TEST_NEIGHBORS);
+    return 0;
+}
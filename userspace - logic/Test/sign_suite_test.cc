@@ -0,0 +1,240 @@
+/**
+ *\file  		sign_suite_test.cc
+ *@brief       	Test and benchmark of the signature suites and the GTK encryption (PASER_sign_suite).
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/crypto/PASER_sign_suite.h"
+
+#include <openssl/rsa.h>
+#include <openssl/ec.h>
+#include <openssl/x509.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+paserd_conf conf;
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static EVP_PKEY *generate_key(int suite) {
+    EVP_PKEY_CTX *ctx = NULL;
+    switch (suite) {
+    case PASER_SIGN_SUITE_RSA:
+        ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+        break;
+    case PASER_SIGN_SUITE_ECDSA_P256:
+        ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+        break;
+    case PASER_SIGN_SUITE_ED25519:
+        ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
+        break;
+    }
+    EVP_PKEY *key = NULL;
+    if (ctx == NULL || EVP_PKEY_keygen_init(ctx) != 1) {
+        EVP_PKEY_CTX_free(ctx);
+        return NULL;
+    }
+    if (suite == PASER_SIGN_SUITE_RSA) {
+        EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, 2048);
+    } else if (suite == PASER_SIGN_SUITE_ECDSA_P256) {
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1);
+    }
+    EVP_PKEY_keygen(ctx, &key);
+    EVP_PKEY_CTX_free(ctx);
+    return key;
+}
+
+/**
+ * Create a self-signed certificate of the key.
+ */
+static X509 *create_cert(EVP_PKEY *key, long serial) {
+    X509 *cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), serial);
+    X509_gmtime_adj(X509_get_notBefore(cert), 0);
+    X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME *name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const u_int8_t *) "paser-test", -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    const EVP_MD *md = EVP_PKEY_id(key) == EVP_PKEY_ED25519 ? NULL : EVP_sha256();
+    if (X509_sign(cert, key, md) <= 0) {
+        X509_free(cert);
+        return NULL;
+    }
+    return cert;
+}
+
+static lv_block make_data(int len) {
+    lv_block data;
+    data.buf = (u_int8_t *) malloc(len);
+    data.len = len;
+    for (int i = 0; i < len; i++) {
+        data.buf[i] = (u_int8_t) (i * 7);
+    }
+    return data;
+}
+
+/**
+ * Sign and verify data with the suite. A signature must be rejected for
+ * modified data and for a key of another suite. Then measure sign and verify.
+ */
+static int test_sign(int suite, EVP_PKEY *key, EVP_PKEY *otherKey, int otherSuite) {
+    lv_block data = make_data(200);
+    lv_block sign;
+    if (PASER_sign_suite::sign(suite, key, data, &sign) != 1) {
+        printf("FAIL: %s can't sign\n", PASER_sign_suite::getName(suite));
+        return 0;
+    }
+    if (PASER_sign_suite::verify(suite, key, data, sign) != 1) {
+        printf("FAIL: %s signature is rejected\n", PASER_sign_suite::getName(suite));
+        return 0;
+    }
+    data.buf[0] ^= 0x01;
+    if (PASER_sign_suite::verify(suite, key, data, sign) == 1) {
+        printf("FAIL: %s signature of modified data is accepted\n", PASER_sign_suite::getName(suite));
+        return 0;
+    }
+    data.buf[0] ^= 0x01;
+    if (PASER_sign_suite::verify(otherSuite, otherKey, data, sign) == 1
+            || PASER_sign_suite::verify(suite, otherKey, data, sign) == 1) {
+        printf("FAIL: %s signature is accepted with a key of another suite\n", PASER_sign_suite::getName(suite));
+        return 0;
+    }
+    int signLen = sign.len;
+    free(sign.buf);
+
+    int count = 200;
+    double start = now_us();
+    for (int i = 0; i < count; i++) {
+        PASER_sign_suite::sign(suite, key, data, &sign);
+        free(sign.buf);
+    }
+    double signTime = now_us() - start;
+    PASER_sign_suite::sign(suite, key, data, &sign);
+    start = now_us();
+    for (int i = 0; i < count; i++) {
+        PASER_sign_suite::verify(suite, key, data, sign);
+    }
+    double verifyTime = now_us() - start;
+    free(sign.buf);
+    free(data.buf);
+    printf("%-10s: OK, %3d byte signature, sign %8.1f us, verify %8.1f us\n", PASER_sign_suite::getName(suite), signLen,
+            signTime / count, verifyTime / count);
+    return 1;
+}
+
+/**
+ * Encrypt a GTK to the certificate. Only the key of this certificate must
+ * decrypt it and a modified ciphertext must be rejected.
+ */
+static int test_encrypt(const char *name, EVP_PKEY *key, X509 *cert, X509 *otherCert) {
+    lv_block gtk = make_data(32);
+    lv_block enc, dec;
+    if (PASER_sign_suite::encrypt(gtk, &enc, cert) != 1) {
+        printf("FAIL: %s can't encrypt\n", name);
+        return 0;
+    }
+    if (PASER_sign_suite::decrypt(enc, &dec, key, cert) != 1 || dec.len != gtk.len
+            || memcmp(dec.buf, gtk.buf, gtk.len) != 0) {
+        printf("FAIL: %s can't decrypt\n", name);
+        return 0;
+    }
+    free(dec.buf);
+    if (otherCert && PASER_sign_suite::decrypt(enc, &dec, key, otherCert) == 1) {
+        printf("FAIL: %s is decrypted for another certificate\n", name);
+        return 0;
+    }
+    enc.buf[enc.len - 1] ^= 0x01;
+    if (PASER_sign_suite::decrypt(enc, &dec, key, cert) == 1 && memcmp(dec.buf, gtk.buf, gtk.len) == 0) {
+        printf("FAIL: %s modified ciphertext is decrypted\n", name);
+        return 0;
+    }
+    free(enc.buf);
+
+    int count = 200;
+    double start = now_us();
+    for (int i = 0; i < count; i++) {
+        PASER_sign_suite::encrypt(gtk, &enc, cert);
+        free(enc.buf);
+    }
+    double encTime = now_us() - start;
+    PASER_sign_suite::encrypt(gtk, &enc, cert);
+    start = now_us();
+    for (int i = 0; i < count; i++) {
+        PASER_sign_suite::decrypt(enc, &dec, key, cert);
+        free(dec.buf);
+    }
+    double decTime = now_us() - start;
+    printf("%-10s: OK, %3d byte GTK block, encrypt %8.1f us, decrypt %8.1f us\n", name, enc.len, encTime / count,
+            decTime / count);
+    free(enc.buf);
+    free(gtk.buf);
+    return 1;
+}
+
+int main() {
+    EVP_PKEY *rsa = generate_key(PASER_SIGN_SUITE_RSA);
+    EVP_PKEY *ec = generate_key(PASER_SIGN_SUITE_ECDSA_P256);
+    EVP_PKEY *ed = generate_key(PASER_SIGN_SUITE_ED25519);
+    if (!rsa || !ec || !ed) {
+        printf("FAIL: can't generate keys\n");
+        return 1;
+    }
+    if (!PASER_sign_suite::checkKey(rsa, PASER_SIGN_SUITE_RSA) || PASER_sign_suite::checkKey(rsa, PASER_SIGN_SUITE_ECDSA_P256)
+            || !PASER_sign_suite::checkKey(ec, PASER_SIGN_SUITE_ECDSA_P256) || PASER_sign_suite::checkKey(ec, PASER_SIGN_SUITE_ED25519)
+            || !PASER_sign_suite::checkKey(ed, PASER_SIGN_SUITE_ED25519) || PASER_sign_suite::checkKey(ed, PASER_SIGN_SUITE_RSA)) {
+        printf("FAIL: checkKey\n");
+        return 1;
+    }
+    if (!test_sign(PASER_SIGN_SUITE_RSA, rsa, ec, PASER_SIGN_SUITE_ECDSA_P256)
+            || !test_sign(PASER_SIGN_SUITE_ECDSA_P256, ec, ed, PASER_SIGN_SUITE_ED25519)
+            || !test_sign(PASER_SIGN_SUITE_ED25519, ed, rsa, PASER_SIGN_SUITE_RSA)) {
+        return 1;
+    }
+
+    X509 *rsaCert = create_cert(rsa, 1);
+    X509 *ecCert = create_cert(ec, 2);
+    // same key, other certificate
+    X509 *ecCert2 = create_cert(ec, 3);
+    X509 *edCert = create_cert(ed, 4);
+    if (!test_encrypt("rsa", rsa, rsaCert, NULL) || !test_encrypt("ecies", ec, ecCert, ecCert2)) {
+        return 1;
+    }
+    lv_block gtk = make_data(32);
+    lv_block enc;
+    if (PASER_sign_suite::encrypt(gtk, &enc, edCert) == 1) {
+        printf("FAIL: GTK is encrypted to an ed25519 certificate\n");
+        return 1;
+    }
+    free(gtk.buf);
+
+    X509_free(rsaCert);
+    X509_free(ecCert);
+    X509_free(ecCert2);
+    X509_free(edCert);
+    EVP_PKEY_free(rsa);
+    EVP_PKEY_free(ec);
+    EVP_PKEY_free(ed);
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ *\file  		timer_queue_test.cc
+ *@brief       	Test and benchmark of the timer queue (PASER_timer_queue).
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "src/PASER/timer_management/PASER_timer_queue.h"
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+paserd_conf conf;
+
+static double now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static void set_timeout(PASER_timer_packet *t, long ms) {
+    t->timeout.tv_sec = ms / 1000;
+    t->timeout.tv_usec = (ms % 1000) * 1000;
+}
+
+static long get_timeout(PASER_timer_packet *t) {
+    return t->timeout.tv_sec * 1000 + t->timeout.tv_usec / 1000;
+}
+
+static std::vector<PASER_timer_packet *> make_timers(u_int32_t n) {
+    std::vector<PASER_timer_packet *> timers;
+    for (u_int32_t i = 0; i < n; i++) {
+        PASER_timer_packet *t = new PASER_timer_packet();
+        t->handler = ROUTINGTABLE_VALID_ENTRY;
+        t->destAddr.s_addr = htonl(0x0A000000 + i);
+        timers.push_back(t);
+    }
+    return timers;
+}
+
+static void free_timers(std::vector<PASER_timer_packet *> *timers) {
+    for (u_int32_t i = 0; i < timers->size(); i++) {
+        delete (*timers)[i];
+    }
+    timers->clear();
+}
+
+/**
+ * Add, re-arm and remove random timers and check the queue after each step.
+ * At the end the queue is drained and the order of the timeouts is checked.
+ */
+static int test_random_ops() {
+    PASER_timer_queue queue;
+    std::vector<PASER_timer_packet *> timers = make_timers(500);
+    srand(1);
+    for (int step = 0; step < 20000; step++) {
+        PASER_timer_packet *t = timers[rand() % timers.size()];
+        if (rand() % 4 == 0) {
+            queue.timer_remove(t);
+            if (t->queueIndex != -1) {
+                printf("FAIL: removed timer is still queued\n");
+                return 0;
+            }
+        } else {
+            set_timeout(t, rand() % 100000);
+            queue.timer_add(t);
+        }
+        queue.timer_check();
+    }
+
+    // a timer with the same key replaces the queued one
+    PASER_timer_packet *copy = new PASER_timer_packet();
+    copy->handler = timers[0]->handler;
+    copy->destAddr = timers[0]->destAddr;
+    queue.timer_add(timers[0]);
+    int size = queue.getTimerQueueSize();
+    queue.timer_add(copy);
+    queue.timer_check();
+    if (queue.getTimerQueueSize() != size || timers[0]->queueIndex != -1) {
+        printf("FAIL: timer with the same key is not replaced\n");
+        return 0;
+    }
+    queue.timer_remove(copy);
+    delete copy;
+
+    long last = -1;
+    while (PASER_timer_packet *t = queue.timer_get_next_timer()) {
+        if (get_timeout(t) < last) {
+            printf("FAIL: timeout %ld after %ld\n", get_timeout(t), last);
+            return 0;
+        }
+        last = get_timeout(t);
+        queue.timer_remove(t);
+    }
+    free_timers(&timers);
+    printf("random operations: OK\n");
+    return 1;
+}
+
+/**
+ * Measure the add, re-arm and expire cost for <b>n</b> queued timers.
+ * Re-arming moves a timer to a later timeout, like a refreshed route.
+ */
+static void bench(u_int32_t n) {
+    PASER_timer_queue queue;
+    std::vector<PASER_timer_packet *> timers = make_timers(n);
+    srand(2);
+
+    double start = now_us();
+    for (u_int32_t i = 0; i < n; i++) {
+        set_timeout(timers[i], rand() % 100000);
+        queue.timer_add(timers[i]);
+    }
+    double add = now_us() - start;
+
+    start = now_us();
+    for (u_int32_t i = 0; i < n; i++) {
+        PASER_timer_packet *t = timers[rand() % n];
+        set_timeout(t, get_timeout(t) + rand() % 10000);
+        queue.timer_add(t);
+    }
+    double rearm = now_us() - start;
+
+    start = now_us();
+    while (PASER_timer_packet *t = queue.timer_get_next_timer()) {
+        queue.timer_remove(t);
+    }
+    double expire = now_us() - start;
+
+    printf("%7u timers: add %7.1f ns, re-arm %7.1f ns, expire %7.1f ns per timer\n", n, add * 1000 / n, rearm * 1000 / n,
+            expire * 1000 / n);
+    free_timers(&timers);
+}
+
+int main() {
+    if (!test_random_ops()) {
+        return 1;
+    }
+    bench(1000);
+    bench(10000);
+    bench(100000);
+    return 0;
+}
@@ -92,6 +92,11 @@ struct paserd_conf {
 
     int PASER_radius;
     int PASER_NUMBER_OF_SECRETS;
+    double PASER_ROOT_PREGEN_THRESHOLD;
+    int PASER_VERIFY_THREADS;
+    int PASER_VERIFY_QUEUE_LEN;
+    int PASER_SIGN_SUITE;
+    int PASER_KDC_SIGN_SUITE;
 
     double PASER_CONF_ROUTE_DELETE_TIMEOUT;
     double PASER_CONF_ROUTE_VALID_TIMEOUT;
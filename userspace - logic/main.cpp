@@ -260,7 +260,11 @@ int main(int argc, char *argv[]) {
 	PASER_syslog *Syslog;
 	Syslog = new PASER_syslog(conf.logFile.c_str());
 
-	load_config(PASERD_GLOBAL_CONF_FILE, Syslog);
+	if (load_config(PASERD_GLOBAL_CONF_FILE, Syslog) != EXIT_SUCCESS) {
+		fprintf(stderr, "Cann't load configuration file, see %s\n", conf.logFile.c_str());
+		delete Syslog;
+		exit(1);
+	}
 
 //	if (atoi(conf.debuglevel.c_str()))
 		print_conf(Syslog);
@@ -40,6 +40,8 @@ KDC_config::KDC_config() {
 
     logFile = new char[strlen(KDC_log_file) + 1];
     strcpy(logFile, KDC_log_file);
+
+    signSuite = PASER_SIGN_SUITE_RSA;
 }
 
 KDC_config::KDC_config(struct paserd_conf *configData) {
@@ -59,6 +61,8 @@ KDC_config::KDC_config(struct paserd_conf *configData) {
     strcpy(logFile, configData->logFile.c_str());
 //    logFile = new char[strlen(KDC_log_file) + 1];
 //    strcpy(logFile, KDC_log_file);
+
+    signSuite = configData->PASER_KDC_SIGN_SUITE;
 }
 
 KDC_config::~KDC_config() {
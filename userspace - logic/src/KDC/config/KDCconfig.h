@@ -31,6 +31,7 @@ class KDC_config {
 private:
     char *certfile, *keyfile, *cafile, *crlfile; ///< Path to KDC's Certificate, Key, CA and CRL file
     char *logFile;  ///< Path to Log file
+    int signSuite;  ///< Signature suite of the KDC key
 
 public:
     KDC_config();
@@ -57,6 +58,10 @@ public:
         return logFile;
     }
 
+    int getSignSuite() const {
+        return signSuite;
+    }
+
 
 };
 
@@ -21,6 +21,7 @@
  ********************************************************************************/
 
 #include "KDCcryptosign.h"
+#include "../../PASER/crypto/PASER_sign_suite.h"
 
 #include <openssl/x509.h>
 #include <openssl/err.h>
@@ -36,6 +37,7 @@
 
 KDC_crypto_sign::KDC_crypto_sign(KDC_config *conf) {
     FILE *fp;
+    sign_suite = conf->getSignSuite();
 
     // load CRL
     fp = fopen(conf->getCrlfile(), "r");
@@ -93,6 +95,10 @@ KDC_crypto_sign::KDC_crypto_sign(KDC_config *conf) {
         exit(1);
     }
     fclose(fp);
+    if (PASER_sign_suite::checkKey(pkey, sign_suite) != 1) {
+        printf("Private key does not match the signature suite %s", PASER_sign_suite::getName(sign_suite));
+        exit(1);
+    }
 
     // read CA_file
     fp = fopen(conf->getCafile(), "r");
@@ -171,25 +177,22 @@ void KDC_crypto_sign::resetGTK(){
 }
 
 int KDC_crypto_sign::computeRESETSign(){
-    u_int32_t sig_len = PASER_sign_len;
-    u_int8_t *sign = (u_int8_t *)malloc(sizeof(u_int8_t) * sig_len);
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_SignInit   (md_ctx, EVP_sha1());
-
-    EVP_SignUpdate(md_ctx, &key_nr, sizeof(key_nr));
-
-    EVP_SignUpdate(md_ctx, &x509_DER.len, sizeof(x509_DER.len));
-    EVP_SignUpdate(md_ctx, x509_DER.buf, x509_DER.len);
-
-    int err = EVP_SignFinal (md_ctx, sign, &sig_len, pkey);
-    EVP_MD_CTX_destroy(md_ctx);
+    lv_block data;
+    data.len = sizeof(key_nr) + sizeof(x509_DER.len) + x509_DER.len;
+    data.buf = (u_int8_t *)malloc(data.len);
+    u_int8_t *temp = data.buf;
+    memcpy(temp, &key_nr, sizeof(key_nr));
+    temp += sizeof(key_nr);
+    memcpy(temp, &x509_DER.len, sizeof(x509_DER.len));
+    temp += sizeof(x509_DER.len);
+    memcpy(temp, x509_DER.buf, x509_DER.len);
+
+    int err = PASER_sign_suite::sign(sign_suite, pkey, data, &sign_key);
+    free(data.buf);
     if (err != 1) {
         ERR_print_errors_fp(stderr);
         exit(1);
     }
-    sign_key.buf = sign;
-    sign_key.len = sig_len;
     return 1;
 }
 
@@ -301,35 +304,22 @@ int KDC_crypto_sign::rsa_encrypt(lv_block in, lv_block *out, X509 *cert){
     if(!cert){
         return 0;
     }
-    EVP_PKEY *pubKey;
-    pubKey = X509_get_pubkey(cert);
-
-    RSA *rsa = EVP_PKEY_get1_RSA(pubKey);
-    out->buf = (u_int8_t *)malloc( RSA_size(rsa) );
-    int i = RSA_public_encrypt(in.len, in.buf, out->buf, rsa, RSA_PKCS1_PADDING);
-    out->len = i;
-    EVP_PKEY_free (pubKey);
-    RSA_free(rsa);
-    if(i<0){
+    int err = PASER_sign_suite::encrypt(in, out, cert);
+    if(err != 1){
+        ERR_print_errors_fp(stderr);
         return 0;
     }
     return 1;
 }
 
 int KDC_crypto_sign::signResponse(PASER_GTKREP * packet){
-    u_int32_t sig_len = PASER_sign_len;
-    u_int8_t *sign = (u_int8_t *)malloc(sizeof(u_int8_t) * sig_len);
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_SignInit   (md_ctx, EVP_sha1());
-
+    lv_block data;
+    lv_block sign;
     int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    EVP_SignUpdate (md_ctx, data, len);
-    free(data);
-
-    int err = EVP_SignFinal (md_ctx, sign, &sig_len, pkey);
-    EVP_MD_CTX_destroy(md_ctx);
+    data.buf = packet->toByteArray(&len);
+    data.len = len;
+    int err = PASER_sign_suite::sign(sign_suite, pkey, data, &sign);
+    free(data.buf);
     if (err != 1) {
         ERR_print_errors_fp(stderr);
         return 0;
@@ -337,8 +327,7 @@ int KDC_crypto_sign::signResponse(PASER_GTKREP * packet){
     if(packet->sign.len != 0){
         free(packet->sign.buf);
     }
-    packet->sign.buf = sign;
-    packet->sign.len = sig_len;
+    packet->sign = sign;
 
     return 1;
 }
@@ -399,11 +388,6 @@ int KDC_crypto_sign::checkOneCert(X509 *cert){
 
 int KDC_crypto_sign::computeSignOfKDCBlock(PASER_GTKREP* packet){
     //sign
-    u_int32_t sig_len = PASER_sign_len;
-    u_int8_t *sign = (u_int8_t *)malloc(sizeof(u_int8_t) * sig_len);
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_SignInit   (md_ctx, EVP_sha1());
     int kdc_data_len = packet->gtk.len + sizeof(packet->nonce) + sizeof(packet->kdc_key_nr)
             + packet->crl.len + packet->kdc_cert.len;
     u_int8_t *temp = (u_int8_t*)malloc(kdc_data_len);
@@ -418,15 +402,14 @@ int KDC_crypto_sign::computeSignOfKDCBlock(PASER_GTKREP* packet){
     temp += packet->crl.len;
     memcpy(temp, (u_int8_t *)packet->kdc_cert.buf, packet->kdc_cert.len);
     temp += packet->kdc_cert.len;
-    EVP_SignUpdate(md_ctx, tempData, kdc_data_len);
+    lv_block data;
+    data.buf = tempData;
+    data.len = kdc_data_len;
+    int err = PASER_sign_suite::sign(sign_suite, pkey, data, &packet->sign_kdc_block);
     free(tempData);
-    int err = EVP_SignFinal (md_ctx, sign, &sig_len, pkey);
-    EVP_MD_CTX_destroy(md_ctx);
     if (err != 1) {
         ERR_print_errors_fp(stderr);
         return 0;
     }
-    packet->sign_kdc_block.buf = sign;
-    packet->sign_kdc_block.len = sig_len;
     return 1;
 }
@@ -50,6 +50,7 @@ private:
     lv_block sign_key;      ///< Signature of RESET message
     int key_nr;             ///< Number of GTK
     lv_block GTK;           ///< GTK
+    int sign_suite;         ///< Signature suite of the KDC key
 
 public:
     KDC_crypto_sign(KDC_config *conf);
@@ -29,6 +29,7 @@
 
 #include "../config/PASER_defs.h"
 #include "../config/PASER_global.h"
+#include "../crypto/PASER_sign_suite.h"
 
 using namespace libconfig;
 using namespace std;
@@ -201,6 +202,61 @@ int load_config(string filename, PASER_syslog * tmp_log) {
         conf.PASER_NUMBER_OF_SECRETS = 16;
     }
 
+    try {
+        string value = cfg.lookup("PASER_ROOT_PREGEN_THRESHOLD");
+        std::istringstream stm;
+        stm.str(value);
+        stm >> conf.PASER_ROOT_PREGEN_THRESHOLD;
+    } catch (...) {
+        tmp_log->PASER_log(1, "No 'PASER_ROOT_PREGEN_THRESHOLD' setting in configuration file.");
+        conf.PASER_ROOT_PREGEN_THRESHOLD = 0.75;
+    }
+
+    try {
+        string value = cfg.lookup("PASER_VERIFY_THREADS");
+        conf.PASER_VERIFY_THREADS = atoi(value.c_str());
+    } catch (...) {
+        tmp_log->PASER_log(1, "No 'PASER_VERIFY_THREADS' setting in configuration file.");
+        conf.PASER_VERIFY_THREADS = 2;
+    }
+
+    try {
+        string value = cfg.lookup("PASER_VERIFY_QUEUE_LEN");
+        conf.PASER_VERIFY_QUEUE_LEN = atoi(value.c_str());
+    } catch (...) {
+        tmp_log->PASER_log(1, "No 'PASER_VERIFY_QUEUE_LEN' setting in configuration file.");
+        conf.PASER_VERIFY_QUEUE_LEN = 64;
+    }
+
+    try {
+        string value = cfg.lookup("PASER_SIGN_SUITE");
+        conf.PASER_SIGN_SUITE = PASER_sign_suite::getSuite(value.c_str());
+        if (conf.PASER_SIGN_SUITE < 0) {
+            tmp_log->PASER_log(1, "Unknown 'PASER_SIGN_SUITE' setting in configuration file. Use rsa.");
+            conf.PASER_SIGN_SUITE = PASER_SIGN_SUITE_RSA;
+        }
+    } catch (...) {
+        tmp_log->PASER_log(1, "No 'PASER_SIGN_SUITE' setting in configuration file.");
+        conf.PASER_SIGN_SUITE = PASER_SIGN_SUITE_RSA;
+    }
+    // Ed25519 keys can't decrypt the GTK, so routers and gateways with such keys can't join the network
+    if (conf.PASER_SIGN_SUITE == PASER_SIGN_SUITE_ED25519) {
+        tmp_log->PASER_log(1, "'PASER_SIGN_SUITE' can't be ed25519. Use rsa or ecdsa-p256.");
+        return (EXIT_FAILURE);
+    }
+
+    try {
+        string value = cfg.lookup("PASER_KDC_SIGN_SUITE");
+        conf.PASER_KDC_SIGN_SUITE = PASER_sign_suite::getSuite(value.c_str());
+        if (conf.PASER_KDC_SIGN_SUITE < 0) {
+            tmp_log->PASER_log(1, "Unknown 'PASER_KDC_SIGN_SUITE' setting in configuration file. Use rsa.");
+            conf.PASER_KDC_SIGN_SUITE = PASER_SIGN_SUITE_RSA;
+        }
+    } catch (...) {
+        tmp_log->PASER_log(1, "No 'PASER_KDC_SIGN_SUITE' setting in configuration file.");
+        conf.PASER_KDC_SIGN_SUITE = PASER_SIGN_SUITE_RSA;
+    }
+
     try {
         string value = cfg.lookup("PASERkdcPort");
         conf.KDCPort = atoi(value.c_str());
@@ -553,6 +609,16 @@ void print_conf(PASER_syslog * tmp_log) {
 
     message += "\n     PASER_NUMBER_OF_SECRETS: ";
     message += convertInt(conf.PASER_NUMBER_OF_SECRETS);
+    message += "\n     PASER_ROOT_PREGEN_THRESHOLD: ";
+    message += convertDouble(conf.PASER_ROOT_PREGEN_THRESHOLD);
+    message += "\n     PASER_VERIFY_THREADS: ";
+    message += convertInt(conf.PASER_VERIFY_THREADS);
+    message += "\n     PASER_VERIFY_QUEUE_LEN: ";
+    message += convertInt(conf.PASER_VERIFY_QUEUE_LEN);
+    message += "\n     PASER_SIGN_SUITE: ";
+    message += PASER_sign_suite::getName(conf.PASER_SIGN_SUITE);
+    message += "\n     PASER_KDC_SIGN_SUITE: ";
+    message += PASER_sign_suite::getName(conf.PASER_KDC_SIGN_SUITE);
     message += "\n";
 
     message += "\n     LOG_LVL: ";
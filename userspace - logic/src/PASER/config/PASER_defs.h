@@ -115,9 +115,19 @@ extern paserd_conf conf;
 #define PASERD_ROUTE_TIMEOUT_LOG_FILE PASER_PATH_TO_PASER_FILES "log_route_timeout.txt"
 
 #define PASERD_OVERHEAD_LOG_FILE PASER_PATH_TO_PASER_FILES "log_overhead.txt"
-
-/// Maximum length of the PASER signature
-#define PASER_sign_len 4096
+#define PASERD_RECEIVE_LOG_FILE PASER_PATH_TO_PASER_FILES "log_receive.txt"
+#define PASERD_SEND_LOG_FILE PASER_PATH_TO_PASER_FILES "log_send.txt"
+#define PASERD_CRYPTO_LOG_FILE PASER_PATH_TO_PASER_FILES "log_crypto.txt"
+#define PASERD_VERIFY_LOG_FILE PASER_PATH_TO_PASER_FILES "log_verify.txt"
+
+/// Signature suites of PASER control messages (see PASER_sign_suite)
+#define PASER_SIGN_SUITE_RSA 0
+#define PASER_SIGN_SUITE_ECDSA_P256 1
+#define PASER_SIGN_SUITE_ED25519 2
+/// Signature suite of the router and gateway keys
+#define PASER_node_sign_suite conf.PASER_SIGN_SUITE
+/// Signature suite of the KDC key
+#define PASER_kdc_sign_suite conf.PASER_KDC_SIGN_SUITE
 
 /// Maximum transmitting range of wireless card
 #define PASER_radius conf.GPS_MAX_NEIGHBOR_DISTANCE
@@ -162,11 +172,18 @@ extern paserd_conf conf;
 #define PASER_SECRET_HASH_LEN 32
 /// Number of generated secrets 2^secret_parameter
 #define PASER_root_param conf.PASER_NUMBER_OF_SECRETS
+/// Fraction of used secrets after which the next authentication tree is generated in background
+#define PASER_root_pregen_threshold conf.PASER_ROOT_PREGEN_THRESHOLD
 /// Max wait time for a new root broadcast replay
 #define PASER_root_repeat_timeout 1.0
 /// Number of new root broadcast repetitions
 #define PASER_root_repeat 2
 
+/// Number of threads which verify signatures of incoming messages (0 - verify on the scheduler thread)
+#define PASER_verify_threads conf.PASER_VERIFY_THREADS
+/// Maximum number of pending signature verifications. Further signed messages are dropped
+#define PASER_verify_queue_len conf.PASER_VERIFY_QUEUE_LEN
+
 /// Broadcast address (255.255.255.255)
 #define PASER_BROADCAST ((in_addr_t) 0xFFFFFFFF)
 
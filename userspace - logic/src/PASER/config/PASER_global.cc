@@ -51,6 +51,8 @@ PASER_global::PASER_global(PASER_config *pConfig, PASER_syslog* tmplog) {
 
     crypto_hash = new PASER_crypto_hash(this);
 
+    verify_pool = new PASER_verify_pool(this);
+
     socket = new PASER_socket(this);
     scheduler = new PASER_scheduler(this);
 
@@ -88,6 +90,8 @@ PASER_global::PASER_global(PASER_config *pConfig, PASER_syslog* tmplog) {
 }
 
 PASER_global::~PASER_global() {
+    // stop the verification threads before the crypto modules are deleted
+    delete verify_pool;
     delete crypto_sign;
     delete crypto_hash;
     delete root;
@@ -135,6 +139,10 @@ PASER_crypto_sign *PASER_global::getCrypto_sign() {
     return crypto_sign;
 }
 
+PASER_verify_pool *PASER_global::getVerify_pool() {
+    return verify_pool;
+}
+
 lv_block PASER_global::getGTK() {
     return GTK;
 }
@@ -277,7 +285,6 @@ void PASER_global::activateHelloPacketTimer() {
         getPASERtimeofday(&(hello_packet_interval->timeout));
         hello_packet_interval->timeout = timeval_add(hello_packet_interval->timeout, PASER_TB_HELLO_Interval);
         timer_queue->timer_add(hello_packet_interval);
-        timer_queue->timer_sort();
     }
 }
 
@@ -288,7 +295,7 @@ void PASER_global::resetHelloTimer() {
     }
     getPASERtimeofday(&(hello_packet_interval->timeout));
     hello_packet_interval->timeout = timeval_add(hello_packet_interval->timeout, PASER_TB_HELLO_Interval);
-    timer_queue->timer_sort();
+    timer_queue->timer_add(hello_packet_interval);
 }
 
 void PASER_global::resetPASER() {
@@ -303,11 +310,7 @@ void PASER_global::resetPASER() {
     neighbor_table->clearTable();
 
     //reset TimerQueue
-    for (std::list<PASER_timer_packet *>::iterator it = timer_queue->timer_queue.begin(); it != timer_queue->timer_queue.end(); it++) {
-        PASER_timer_packet *temp = (PASER_timer_packet*) *it;
-        delete temp;
-    }
-    timer_queue->timer_queue.clear();
+    timer_queue->timer_clear();
 
     hello_packet_interval = NULL;
 
@@ -329,6 +332,7 @@ void PASER_global::resetPASER() {
     }
     GTK.len = 0;
     GTK.buf = NULL;
+    crypto_hash->resetGTK();
 
     isRegistered = false;
     wasRegistered = false;
@@ -367,6 +371,7 @@ void PASER_global::setGTK(lv_block _GTK) {
     if (GTK.len > 0) {
         free(GTK.buf);
     }
+    crypto_hash->resetGTK();
     if (_GTK.len == 0) {
         GTK.len = 0;
         GTK.buf = NULL;
@@ -35,6 +35,7 @@ class PASER_global;
 #include "../crypto/PASER_crypto_hash.h"
 #include "../crypto/PASER_root.h"
 #include "../crypto/PASER_crypto_sign.h"
+#include "../crypto/PASER_verify_pool.h"
 #include "../timer_management/PASER_timer_queue.h"
 #include "../syslog/PASER_syslog.h"
 #include "../tables/PASER_neighbor_table.h"
@@ -60,6 +61,7 @@ public:
     PASER_scheduler *getScheduler();
     PASER_crypto_hash *getCrypto_hash();
     PASER_crypto_sign *getCrypto_sign();
+    PASER_verify_pool *getVerify_pool();
     PASER_neighbor_table *getNeighbor_table();
     PASER_routing_table *getRouting_table();
 //    PASER_packet_queue *getPacket_queue();
@@ -147,6 +149,7 @@ private:
     PASER_root *root;
     PASER_crypto_sign *crypto_sign;
     PASER_crypto_hash *crypto_hash;
+    PASER_verify_pool *verify_pool;
 
     PASER_blacklist *blackList;
     PASER_packet_sender *packetSender;
@@ -0,0 +1,82 @@
+/**
+ *\class  		PASER_cert_context
+ *@brief       	Class holds the certificates of one incoming PASER message.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_cert_context.h"
+
+PASER_cert_context::PASER_cert_context(PASER_crypto_sign *crypto_sign) {
+    this->crypto_sign = crypto_sign;
+}
+
+PASER_cert_context::~PASER_cert_context() {
+    for (std::map<const u_int8_t *, cert_context_entry>::iterator it = certs.begin(); it != certs.end(); it++) {
+        if (it->second.cert) {
+            X509_free(it->second.cert);
+        }
+    }
+    certs.clear();
+}
+
+cert_context_entry *PASER_cert_context::getEntry(lv_block der) {
+    if (der.buf == NULL) {
+        return NULL;
+    }
+    std::map<const u_int8_t *, cert_context_entry>::iterator it = certs.find(der.buf);
+    if (it != certs.end()) {
+        return &it->second;
+    }
+    cert_context_entry entry;
+    entry.cert = crypto_sign->extractCert(der);
+    entry.valid = -1;
+    return &certs.insert(std::make_pair((const u_int8_t *) der.buf, entry)).first->second;
+}
+
+X509 *PASER_cert_context::getCert(lv_block der) {
+    cert_context_entry *entry = getEntry(der);
+    if (entry == NULL) {
+        return NULL;
+    }
+    return entry->cert;
+}
+
+X509 *PASER_cert_context::getCertRef(lv_block der) {
+    X509 *cert = getCert(der);
+    if (cert == NULL) {
+        return NULL;
+    }
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    X509_up_ref(cert);
+#else
+    CRYPTO_add(&cert->references, 1, CRYPTO_LOCK_X509);
+#endif
+    return cert;
+}
+
+int PASER_cert_context::checkCert(lv_block der) {
+    cert_context_entry *entry = getEntry(der);
+    if (entry == NULL || entry->cert == NULL) {
+        return 0;
+    }
+    if (entry->valid == -1) {
+        entry->valid = crypto_sign->checkOneCert(entry->cert);
+    }
+    return entry->valid;
+}
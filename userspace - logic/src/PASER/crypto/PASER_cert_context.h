@@ -0,0 +1,89 @@
+/**
+ *\class  		PASER_cert_context
+ *@brief       	Class holds the certificates of one incoming PASER message.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_cert_context;
+
+#ifndef PASER_CERT_CONTEXT_H_
+#define PASER_CERT_CONTEXT_H_
+
+#include "../config/PASER_defs.h"
+#include "PASER_crypto_sign.h"
+
+#include <openssl/x509.h>
+
+#include <map>
+
+/**
+ * Entry of the certificate context.
+ */
+struct cert_context_entry {
+    X509 *cert;     ///< Decoded certificate or NULL if the certificate can not be decoded
+    int valid;      ///< Result of the verification (1 - valid, 0 - invalid, -1 - not checked)
+};
+
+/**
+ * The certificate context of an incoming PASER message. Each certificate
+ * (DER format) of the message is decoded and verified only once.
+ * The context must not live longer than the message.
+ */
+class PASER_cert_context {
+private:
+    PASER_crypto_sign *crypto_sign;
+    std::map<const u_int8_t *, cert_context_entry> certs; ///< Decoded certificates by DER buffer
+
+public:
+    PASER_cert_context(PASER_crypto_sign *crypto_sign);
+    ~PASER_cert_context();
+
+    /**
+     * Get the decoded certificate. The certificate is owned by the context.
+     *
+     *@param der certificate in DER format
+     *
+     *@return certificate on successful or NULL on error
+     */
+    X509 *getCert(lv_block der);
+
+    /**
+     * Get a new reference to the decoded certificate, e.g. for the neighbor
+     * or routing table. The reference must be freed with X509_free().
+     *
+     *@param der certificate in DER format
+     *
+     *@return certificate on successful or NULL on error
+     */
+    X509 *getCertRef(lv_block der);
+
+    /**
+     * Check whether the certificate is valid.
+     *
+     *@param der certificate in DER format
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int checkCert(lv_block der);
+
+private:
+    cert_context_entry *getEntry(lv_block der);
+};
+
+#endif /* PASER_CERT_CONTEXT_H_ */
@@ -21,10 +21,15 @@
  ********************************************************************************/
 
 #include "PASER_crypto_hash.h"
+#include "PASER_digest_sink.h"
 
 #include <openssl/engine.h>
 #include <openssl/hmac.h>
 #include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+
+#include <string.h>
 
 //#define CRYPTOHASHTIMEMEASUREMENT
 
@@ -42,240 +47,204 @@
 #define CRYTO_HASH_TIME_END
 #endif
 
-PASER_crypto_hash::PASER_crypto_hash(PASER_global * paser_global) {
-    pGlobal = paser_global;
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+static HMAC_CTX *HMAC_CTX_new() {
+    HMAC_CTX *ctx = (HMAC_CTX *) malloc(sizeof(HMAC_CTX));
+    if (ctx != NULL) {
+        HMAC_CTX_init(ctx);
+    }
+    return ctx;
 }
 
-int PASER_crypto_hash::computeHmacTURREQ(PASER_TU_RREQ * packet, lv_block GTK) {
-    CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
+static void HMAC_CTX_free(HMAC_CTX *ctx) {
+    if (ctx != NULL) {
+        HMAC_CTX_cleanup(ctx);
+        free(ctx);
+    }
+}
+#endif
 
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-//printf("GTK:0x");
-//for (int n = 0; n < GTK.len; n++)
-//    printf("%02x", GTK.buf[n]);
-//putchar('\n');
-    free(data);
+PASER_crypto_hash::PASER_crypto_hash(PASER_global * paser_global) {
+    pGlobal = paser_global;
+    for (int i = 0; i < PASER_HMAC_CTX_COUNT; i++) {
+        hmacCtx[i] = NULL;
+        hmacKey[i].buf = NULL;
+        hmacKey[i].len = 0;
+    }
+    hmacCurrent = 0;
+    msgCtx = HMAC_CTX_new();
+}
 
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
+PASER_crypto_hash::~PASER_crypto_hash() {
+    for (int i = 0; i < PASER_HMAC_CTX_COUNT; i++) {
+        HMAC_CTX_free(hmacCtx[i]);
+        if (hmacKey[i].len > 0) {
+            OPENSSL_cleanse(hmacKey[i].buf, hmacKey[i].len);
+            free(hmacKey[i].buf);
+        }
+    }
+    HMAC_CTX_free(msgCtx);
+}
 
-    packet->hash = result;
-    CRYTO_HASH_TIME_END
-    return 1;
+void PASER_crypto_hash::resetGTK() {
+    hmacCurrent = (hmacCurrent + 1) % PASER_HMAC_CTX_COUNT;
+    HMAC_CTX_free(hmacCtx[hmacCurrent]);
+    hmacCtx[hmacCurrent] = NULL;
+    if (hmacKey[hmacCurrent].len > 0) {
+        OPENSSL_cleanse(hmacKey[hmacCurrent].buf, hmacKey[hmacCurrent].len);
+        free(hmacKey[hmacCurrent].buf);
+    }
+    hmacKey[hmacCurrent].buf = NULL;
+    hmacKey[hmacCurrent].len = 0;
 }
 
-int PASER_crypto_hash::checkHmacTURREQ(PASER_TU_RREQ * packet, lv_block GTK) {
-    CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
+HMAC_CTX *PASER_crypto_hash::getHmacCtx(lv_block GTK) {
+    // current GTK first, then the previous GTK
+    for (int j = 0; j < PASER_HMAC_CTX_COUNT; j++) {
+        int i = (hmacCurrent + PASER_HMAC_CTX_COUNT - j) % PASER_HMAC_CTX_COUNT;
+        if (hmacCtx[i] != NULL && hmacKey[i].len == GTK.len && (GTK.len == 0 || memcmp(hmacKey[i].buf, GTK.buf, GTK.len) == 0)) {
+            return hmacCtx[i];
+        }
+    }
 
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
+    // compute the key schedule of the new GTK
+    if (hmacCtx[hmacCurrent] != NULL) {
+        resetGTK();
+    }
+    static const u_int8_t emptyKey[1] = { 0x00 };
+    HMAC_CTX *ctx = HMAC_CTX_new();
+    if (ctx == NULL || HMAC_Init_ex(ctx, GTK.len > 0 ? GTK.buf : emptyKey, GTK.len, EVP_sha256(), NULL) != 1) {
+        HMAC_CTX_free(ctx);
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't initialize HMAC context\n");
+        return NULL;
+    }
+    if (GTK.len > 0) {
+        hmacKey[hmacCurrent].buf = (u_int8_t *) malloc(GTK.len);
+        memcpy(hmacKey[hmacCurrent].buf, GTK.buf, GTK.len);
+    }
+    hmacKey[hmacCurrent].len = GTK.len;
+    hmacCtx[hmacCurrent] = ctx;
+    return ctx;
+}
 
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
+int PASER_crypto_hash::computeHmac(lv_block GTK, PASER_MSG *packet, u_int8_t *result) {
+    HMAC_CTX *keyCtx = getHmacCtx(GTK);
+    if (keyCtx == NULL || msgCtx == NULL) {
+        return 0;
+    }
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+    // HMAC_CTX_copy of OpenSSL < 1.1.0 does not free the old digest contexts
+    HMAC_CTX_cleanup(msgCtx);
+    HMAC_CTX_init(msgCtx);
+#endif
     u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
+    if (HMAC_CTX_copy(msgCtx, keyCtx) != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't compute HMAC\n");
+        return 0;
+    }
+    PASER_digest_sink sink(msgCtx);
+    packet->writeFields(&sink);
+    if (HMAC_Final(msgCtx, result, &result_len) != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't compute HMAC\n");
+        return 0;
+    }
+    return 1;
+}
 
-    if (memcmp(packet->hash, result, (sizeof(u_int8_t) * result_len)) == 0) {
-        free(result);
-        CRYTO_HASH_TIME_END
+int PASER_crypto_hash::checkHmac(lv_block GTK, PASER_MSG *packet, u_int8_t *hash) {
+    u_int8_t result[SHA256_DIGEST_LENGTH];
+    if (hash == NULL || !computeHmac(GTK, packet, result)) {
+        return 0;
+    }
+    if (CRYPTO_memcmp(hash, result, (sizeof(u_int8_t) * SHA256_DIGEST_LENGTH)) == 0) {
         return 1;
     }
-    free(result);
     return 0;
 }
 
-int PASER_crypto_hash::computeHmacTURREP(PASER_TU_RREP * packet, lv_block GTK) {
+int PASER_crypto_hash::computeHmacTURREQ(PASER_TU_RREQ * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
+    if (packet->hash == NULL) {
+        packet->hash = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
+    }
+    int ok = computeHmac(GTK, packet, packet->hash);
+    CRYTO_HASH_TIME_END
+    return ok;
+}
 
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
+int PASER_crypto_hash::checkHmacTURREQ(PASER_TU_RREQ * packet, lv_block GTK) {
+    CRYTO_HASH_TIME_BEGIN
+    int ok = checkHmac(GTK, packet, packet->hash);
+    CRYTO_HASH_TIME_END
+    return ok;
+}
 
-    packet->hash = result;
+int PASER_crypto_hash::computeHmacTURREP(PASER_TU_RREP * packet, lv_block GTK) {
+    CRYTO_HASH_TIME_BEGIN
+    if (packet->hash == NULL) {
+        packet->hash = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
+    }
+    int ok = computeHmac(GTK, packet, packet->hash);
     CRYTO_HASH_TIME_END
-    return 1;
+    return ok;
 }
 
 int PASER_crypto_hash::checkHmacTURREP(PASER_TU_RREP * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    if (memcmp(packet->hash, result, (sizeof(u_int8_t) * result_len)) == 0) {
-        free(result);
-        CRYTO_HASH_TIME_END
-        return 1;
-    }
-    free(result);
-    return 0;
+    int ok = checkHmac(GTK, packet, packet->hash);
+    CRYTO_HASH_TIME_END
+    return ok;
 }
 
 int PASER_crypto_hash::computeHmacTURREPACK(PASER_TU_RREP_ACK * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    packet->hash = result;
+    if (packet->hash == NULL) {
+        packet->hash = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
+    }
+    int ok = computeHmac(GTK, packet, packet->hash);
     CRYTO_HASH_TIME_END
-    return 1;
+    return ok;
 }
 
 int PASER_crypto_hash::checkHmacTURREPACK(PASER_TU_RREP_ACK * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    if (memcmp(packet->hash, result, (sizeof(u_int8_t) * result_len)) == 0) {
-        free(result);
-        CRYTO_HASH_TIME_END
-        return 1;
-    }
-    free(result);
-    return 0;
+    int ok = checkHmac(GTK, packet, packet->hash);
+    CRYTO_HASH_TIME_END
+    return ok;
 }
 
 int PASER_crypto_hash::computeHmacRERR(PASER_TB_RERR * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    packet->hash = result;
+    if (packet->hash == NULL) {
+        packet->hash = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
+    }
+    int ok = computeHmac(GTK, packet, packet->hash);
     CRYTO_HASH_TIME_END
-    return 1;
+    return ok;
 }
 
 int PASER_crypto_hash::checkHmacRERR(PASER_TB_RERR * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    if (memcmp(packet->hash, result, (sizeof(u_int8_t) * result_len)) == 0) {
-        free(result);
-        CRYTO_HASH_TIME_END
-        return 1;
-    }
-    free(result);
-    return 0;
+    int ok = checkHmac(GTK, packet, packet->hash);
+    CRYTO_HASH_TIME_END
+    return ok;
 }
 
 int PASER_crypto_hash::computeHmacHELLO(PASER_TB_HELLO * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    packet->hash = result;
+    if (packet->hash == NULL) {
+        packet->hash = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
+    }
+    int ok = computeHmac(GTK, packet, packet->hash);
     CRYTO_HASH_TIME_END
-    return 1;
+    return ok;
 }
 
 int PASER_crypto_hash::checkHmacHELLO(PASER_TB_HELLO * packet, lv_block GTK) {
     CRYTO_HASH_TIME_BEGIN
-    HMAC_CTX ctx;
-    HMAC_CTX_init(&ctx);
-    HMAC_Init_ex(&ctx, GTK.buf, GTK.len, EVP_sha256(), NULL);
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    HMAC_Update(&ctx, data, len);
-    free(data);
-
-    u_int8_t *result = (u_int8_t *) malloc(sizeof(u_int8_t) * SHA256_DIGEST_LENGTH);
-    u_int32_t result_len = SHA256_DIGEST_LENGTH;
-    HMAC_Final(&ctx, result, &result_len);
-    HMAC_CTX_cleanup(&ctx);
-
-    if (memcmp(packet->hash, result, (sizeof(u_int8_t) * result_len)) == 0) {
-        free(result);
-        CRYTO_HASH_TIME_END
-        return 1;
-    }
-    free(result);
-    return 0;
+    int ok = checkHmac(GTK, packet, packet->hash);
+    CRYTO_HASH_TIME_END
+    return ok;
 }
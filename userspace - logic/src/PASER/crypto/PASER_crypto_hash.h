@@ -27,6 +27,7 @@ class PASER_crypto_hash;
 
 #include "../config/PASER_defs.h"
 #include <openssl/engine.h>
+#include <openssl/hmac.h>
 
 #include "../packet_structure/PASER_TU_RREQ.h"
 #include "../packet_structure/PASER_TU_RREP_ACK.h"
@@ -36,6 +37,9 @@ class PASER_crypto_hash;
 
 #include "../config/PASER_global.h"
 
+/// Number of cached HMAC contexts (current and previous GTK)
+#define PASER_HMAC_CTX_COUNT 2
+
 /**
  * Implementation of PASER_crypto_hash classes.
  */
@@ -43,6 +47,11 @@ class PASER_crypto_hash {
 private:
     PASER_global* pGlobal; // Pointer to global object
 
+    HMAC_CTX *hmacCtx[PASER_HMAC_CTX_COUNT];      ///< HMAC contexts initialized with a GTK (key schedule is computed)
+    lv_block hmacKey[PASER_HMAC_CTX_COUNT];       ///< GTK of each HMAC context
+    int hmacCurrent;                              ///< Index of the HMAC context of the current GTK
+    HMAC_CTX *msgCtx;                             ///< HMAC context of the current message (copy of hmacCtx)
+
 public:
     /**
      * Constructor of PASER_crypto_hash Object.
@@ -52,6 +61,14 @@ public:
      *@return nada
      */
     PASER_crypto_hash(PASER_global * paser_global);
+    ~PASER_crypto_hash();
+
+    /**
+     * The GTK is changed. The HMAC context of the current GTK is kept as
+     * the context of the previous GTK, the context of the new GTK will be
+     * computed with the next message.
+     */
+    void resetGTK();
     /**
      * Compute a hash value from PASER_TU_RREQ packet and GTK and
      * write the hash value to packet
@@ -156,6 +173,38 @@ public:
      *@return 1 on successful or 0 on error
      */
     int checkHmacHELLO(PASER_TB_HELLO * packet, lv_block GTK);
+
+private:
+    /**
+     * Get the HMAC context of the GTK. The context is computed only once per GTK.
+     *
+     *@param GTK GTK
+     *
+     *@return HMAC context on successful or NULL on error
+     */
+    HMAC_CTX *getHmacCtx(lv_block GTK);
+
+    /**
+     * Compute a hash value of the secured fields of a packet with GTK
+     *
+     *@param GTK current GTK
+     *@param packet packet which will be hashed
+     *@param result pointer to the buffer (SHA256_DIGEST_LENGTH bytes) which will be set to the hash value
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int computeHmac(lv_block GTK, PASER_MSG *packet, u_int8_t *result);
+
+    /**
+     * Check a hash value of the secured fields of a packet in constant time
+     *
+     *@param GTK current GTK
+     *@param packet packet which hash will be checked
+     *@param hash hash value (SHA256_DIGEST_LENGTH bytes) which will be checked
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int checkHmac(lv_block GTK, PASER_MSG *packet, u_int8_t *hash);
 };
 
 #endif /* PASER_CRYPTO_HASH_H_ */
@@ -21,9 +21,13 @@
  ********************************************************************************/
 
 #include "PASER_crypto_sign.h"
+#include "PASER_digest_sink.h"
+#include "PASER_sign_suite.h"
 
 #include <stdio.h>
 #include <list>
+#include <sys/time.h>
+#include <time.h>
 
 #include <openssl/pem.h>
 
@@ -103,7 +107,19 @@ PASER_crypto_sign::PASER_crypto_sign(char *certPath, char *keyPath, char *CAcert
         exit(1);
     }
 
+    if (PASER_sign_suite::checkKey(pkey, PASER_node_sign_suite) != 1) {
+        PASER_LOG_WRITE_LOG(0, "Private key does not match the signature suite %s\n", PASER_sign_suite::getName(PASER_node_sign_suite));
+        std::cout << "Private key does not match the signature suite " << PASER_sign_suite::getName(PASER_node_sign_suite) << std::endl;
+        exit(1);
+    }
+
     crl = NULL;
+    ca_store = createStore(NULL);
+    if (ca_store == NULL) {
+        PASER_LOG_WRITE_LOG(0, "Cann't create X509_STORE\n");
+        std::cout << "Cann't create X509_STORE" << std::endl;
+        exit(1);
+    }
 }
 
 PASER_crypto_sign::~PASER_crypto_sign() {
@@ -121,6 +137,10 @@ PASER_crypto_sign::~PASER_crypto_sign() {
     if (crl) {
         X509_CRL_free(crl);
     }
+    clearCertCache();
+    if (ca_store) {
+        X509_STORE_free(ca_store);
+    }
 }
 
 int PASER_crypto_sign::getCert(lv_block *cert) {
@@ -158,26 +178,18 @@ int PASER_crypto_sign::setCRL(lv_block in) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't convert CRL from DER to x509 format\n");
         return 0;
     }
+    boost::mutex::scoped_lock lock(certCacheMutex);
+    if (crl) {
+        X509_CRL_free(crl);
+    }
     crl = x;
-    return 1;
+    return updateStore();
 }
 
 int PASER_crypto_sign::signUBRREQ(PASER_UB_RREQ * packet) {
     CRYTO_TIME_BEGIN
-    u_int32_t sig_len = PASER_sign_len;
-    u_int8_t *sign = (u_int8_t *) malloc(sizeof(u_int8_t) * sig_len);
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_SignInit(md_ctx, EVP_sha1());
-
-    int len = 0;
-    u_int8_t *data = packet->toByteArray(&len);
-    EVP_SignUpdate(md_ctx, data, len);
-    free(data);
-
-    int err = EVP_SignFinal(md_ctx, sign, &sig_len, pkey);
-    EVP_MD_CTX_destroy(md_ctx);
-    if (err != 1) {
+    lv_block sign;
+    if (PASER_sign_suite::sign(PASER_node_sign_suite, pkey, packet, &sign) != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't sign an UBRREQ packet\n");
         return 0;
@@ -185,50 +197,26 @@ int PASER_crypto_sign::signUBRREQ(PASER_UB_RREQ * packet) {
     if (packet->sign.buf != NULL) {
         free(packet->sign.buf);
     }
-    packet->sign.buf = sign;
-    packet->sign.len = sig_len;
+    packet->sign = sign;
     CRYTO_TIME_END
     return 1;
 }
 
-int PASER_crypto_sign::checkSignUBRREQ(PASER_UB_RREQ * packet) {
+int PASER_crypto_sign::checkSignUBRREQ(PASER_UB_RREQ * packet, X509 *certForw) {
     CRYTO_TIME_BEGIN
-    X509 *x;
-    const u_int8_t *buf, *p;
-    int len;
-    buf = packet->certForw.buf;
-    len = packet->certForw.len;
-    p = buf;
-    x = d2i_X509(NULL, &p, len);
-    if (x == NULL) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    if (certForw == NULL) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't read a certificate from UBRREQ packet\n");
         return 0;
     }
-    if (checkOneCert(x) != 1) {
+    EVP_PKEY *pubKey = NULL;
+    if (checkCert(certForw, &pubKey) != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "UBRREQ packet contains invalid certificate\n");
-        X509_free(x);
         return 0;
     }
-    EVP_PKEY *pubKey = X509_get_pubkey(x);
-    X509_free(x);
-    u_int32_t sig_len = packet->sign.len;
-    u_int8_t *sign = packet->sign.buf;
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_VerifyInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_VerifyUpdate(md_ctx, data, packet_len);
-    free(data);
-
-    int err = EVP_VerifyFinal(md_ctx, sign, sig_len, pubKey);
+    int valid = verifySign(packet, packet->sign, certForw, pubKey, PASER_node_sign_suite);
     EVP_PKEY_free(pubKey);
-    EVP_MD_CTX_destroy(md_ctx);
 
-    if (err != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    if (valid != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "UBRREQ packet contains invalid signature\n");
         return 0;
     }
@@ -238,19 +226,8 @@ int PASER_crypto_sign::checkSignUBRREQ(PASER_UB_RREQ * packet) {
 
 int PASER_crypto_sign::signUURREP(PASER_UU_RREP * packet) {
     CRYTO_TIME_BEGIN
-    u_int32_t sig_len = PASER_sign_len;
-    u_int8_t *sign = (u_int8_t *) malloc(sizeof(u_int8_t) * sig_len);
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_SignInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_SignUpdate(md_ctx, data, packet_len);
-
-    int err = EVP_SignFinal(md_ctx, sign, &sig_len, pkey);
-    EVP_MD_CTX_destroy(md_ctx);
-    if (err != 1) {
+    lv_block sign;
+    if (PASER_sign_suite::sign(PASER_node_sign_suite, pkey, packet, &sign) != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't sign an UURREP packet\n");
         return 0;
@@ -258,52 +235,26 @@ int PASER_crypto_sign::signUURREP(PASER_UU_RREP * packet) {
     if (packet->sign.buf != NULL) {
         free(packet->sign.buf);
     }
-    packet->sign.buf = sign;
-    packet->sign.len = sig_len;
-
-    free(data);
+    packet->sign = sign;
     CRYTO_TIME_END
     return 1;
 }
 
-int PASER_crypto_sign::checkSignUURREP(PASER_UU_RREP * packet) {
+int PASER_crypto_sign::checkSignUURREP(PASER_UU_RREP * packet, X509 *certForw) {
     CRYTO_TIME_BEGIN
-    X509 *x;
-    const u_int8_t *buf, *p;
-    int len;
-    buf = packet->certForw.buf;
-    len = packet->certForw.len;
-    p = buf;
-    x = d2i_X509(NULL, &p, len);
-    if (x == NULL) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    if (certForw == NULL) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't read a certificate from UURREP packet\n");
         return 0;
     }
-    if (checkOneCert(x) != 1) {
+    EVP_PKEY *pubKey = NULL;
+    if (checkCert(certForw, &pubKey) != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "UURREP packet contains invalid certificate\n");
-        X509_free(x);
         return 0;
     }
-    EVP_PKEY *pubKey = X509_get_pubkey(x);
-    X509_free(x);
-    u_int32_t sig_len = packet->sign.len;
-    u_int8_t *sign = packet->sign.buf;
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_VerifyInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_VerifyUpdate(md_ctx, data, packet_len);
-
-    free(data);
-    int err = EVP_VerifyFinal(md_ctx, sign, sig_len, pubKey);
+    int valid = verifySign(packet, packet->sign, certForw, pubKey, PASER_node_sign_suite);
     EVP_PKEY_free(pubKey);
-    EVP_MD_CTX_destroy(md_ctx);
 
-    if (err != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    if (valid != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "UURREP packet contains invalid signature\n");
         return 0;
     }
@@ -313,19 +264,8 @@ int PASER_crypto_sign::checkSignUURREP(PASER_UU_RREP * packet) {
 
 int PASER_crypto_sign::signB_ROOT(PASER_B_ROOT * packet) {
     CRYTO_TIME_BEGIN
-    u_int32_t sig_len = PASER_sign_len;
-    u_int8_t *sign = (u_int8_t *) malloc(sizeof(u_int8_t) * sig_len);
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_SignInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_SignUpdate(md_ctx, data, packet_len);
-
-    int err = EVP_SignFinal(md_ctx, sign, &sig_len, pkey);
-    EVP_MD_CTX_destroy(md_ctx);
-    if (err != 1) {
+    lv_block sign;
+    if (PASER_sign_suite::sign(PASER_node_sign_suite, pkey, packet, &sign) != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't sign an B_ROOT packet\n");
         return 0;
@@ -333,9 +273,7 @@ int PASER_crypto_sign::signB_ROOT(PASER_B_ROOT * packet) {
     if (packet->sign.buf != NULL) {
         free(packet->sign.buf);
     }
-    packet->sign.buf = sign;
-    packet->sign.len = sig_len;
-    free(data);
+    packet->sign = sign;
     CRYTO_TIME_END
     return 1;
 }
@@ -354,29 +292,17 @@ int PASER_crypto_sign::checkSignB_ROOT(PASER_B_ROOT * packet) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't read a certificate from B_ROOT packet\n");
         return 0;
     }
-    if (checkOneCert(x) != 1) {
+    EVP_PKEY *pubKey = NULL;
+    if (checkCert(x, &pubKey) != 1) {
         X509_free(x);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "B_ROOT packet contains invalid certificate\n");
         return 0;
     }
-    EVP_PKEY *pubKey = X509_get_pubkey(x);
-    X509_free(x);
-    u_int32_t sig_len = packet->sign.len;
-    u_int8_t *sign = packet->sign.buf;
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_VerifyInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_VerifyUpdate(md_ctx, data, packet_len);
-    free(data);
-    int err = EVP_VerifyFinal(md_ctx, sign, sig_len, pubKey);
+    int valid = verifySign(packet, packet->sign, x, pubKey, PASER_node_sign_suite);
     EVP_PKEY_free(pubKey);
-    EVP_MD_CTX_destroy(md_ctx);
+    X509_free(x);
 
-    if (err != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    if (valid != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "B_ROOT packet contains invalid signature\n");
         return 0;
     }
@@ -398,34 +324,23 @@ int PASER_crypto_sign::checkSignRESET(PASER_RESET * packet) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't read a certificate from RESET packet\n");
         return 0;
     }
-    if (checkOneCert(x) != 1) {
+    EVP_PKEY *pubKey = NULL;
+    if (checkCert(x, &pubKey) != 1) {
         X509_free(x);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "RESET packet contains invalid certificate\n");
         return 0;
     }
     if (isKdcCert(x) != 1) {
+        EVP_PKEY_free(pubKey);
         X509_free(x);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "RESET certificate is NOT a KDC certificate\n");
         return 0;
     }
-    EVP_PKEY *pubKey = X509_get_pubkey(x);
-    X509_free(x);
-    u_int32_t sig_len = packet->sign.len;
-    u_int8_t *sign = packet->sign.buf;
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_VerifyInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_VerifyUpdate(md_ctx, data, packet_len);
-    free(data);
-    int err = EVP_VerifyFinal(md_ctx, sign, sig_len, pubKey);
+    int valid = verifySign(packet, packet->sign, x, pubKey, PASER_kdc_sign_suite);
     EVP_PKEY_free(pubKey);
-    EVP_MD_CTX_destroy(md_ctx);
+    X509_free(x);
 
-    if (err != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    if (valid != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "RESET packet contains invalid signature\n");
         return 0;
     }
@@ -447,31 +362,21 @@ int PASER_crypto_sign::checkSignGTKResponse(PASER_GTKREP * packet) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't read a certificate from GTKResponse packet\n");
         return 0;
     }
-    if (checkOneCert(x) != 1) {
+    EVP_PKEY *pubKey = NULL;
+    if (checkCert(x, &pubKey) != 1) {
         X509_free(x);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "GTKResponse packet contains invalid certificate\n");
         return 0;
     }
     if (isKdcCert(x) != 1) {
+        EVP_PKEY_free(pubKey);
         X509_free(x);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "GTKResponse certificate is NOT a KDC certificate\n");
         return 0;
     }
-    EVP_PKEY *pubKey = X509_get_pubkey(x);
     X509_free(x);
-    u_int32_t sig_len = packet->sign.len;
-    u_int8_t *sign = packet->sign.buf;
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_VerifyInit(md_ctx, EVP_sha1());
-
-    int packet_len = 0;
-    u_int8_t *data = packet->toByteArray(&packet_len);
-    EVP_VerifyUpdate(md_ctx, data, packet_len);
-    free(data);
-    int err = EVP_VerifyFinal(md_ctx, sign, sig_len, pubKey);
+    int err = PASER_sign_suite::verify(PASER_kdc_sign_suite, pubKey, packet, packet->sign);
     EVP_PKEY_free(pubKey);
-    EVP_MD_CTX_destroy(md_ctx);
 
     if (err != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
@@ -520,81 +425,25 @@ int PASER_crypto_sign::checkSignKDC(kdc_block data) {
         return 0;
     }
 
-    //check KDC cert
-    X509_STORE *ca_store;
-    ca_store = X509_STORE_new();
-    if (X509_STORE_add_cert(ca_store, ca_cert) != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    //check KDC cert with the new CRL
+    X509_STORE *kdc_store = createStore(crl_x);
+    if (kdc_store == NULL) {
         X509_CRL_free(crl_x);
         X509_free(kdc_cert);
-        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't add certificate to X509_STORE\n");
         return 0;
     }
-    if (X509_STORE_set_default_paths(ca_store) != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
-        X509_CRL_free(crl_x);
-        X509_free(kdc_cert);
-        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't set default path in X509_STORE\n");
-        return 0;
-    }
-    if (crl_x) {
-        if (X509_STORE_add_crl(ca_store, crl_x) != 1) {
-            ERR_print_errors_fp(PASER_LOG_GET_FD);
-            X509_CRL_free(crl_x);
-            X509_free(kdc_cert);
-            PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't add CRL to X509_STORE\n");
-            return 0;
-        }
-#if (OPENSSL_VERSION_NUMBER > 0x00907000L)
-        //set the flag of the store so that CRLs are consulted
-        X509_STORE_set_flags(ca_store, X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL);
-#endif
-    }
-
-    X509_STORE_CTX *verify_ctx;
-    //create a verification context and initialize it
-    if (!(verify_ctx = X509_STORE_CTX_new())) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
-        X509_CRL_free(crl_x);
-        X509_free(kdc_cert);
-        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't create verification context\n");
-        return 0;
-    }
-    //X509_STORE_CTX_init did not return an error condition in prior versions
-#if (OPENSSL_VERSION_NUMBER > 0x00907000L)
-    if (X509_STORE_CTX_init(verify_ctx, ca_store, kdc_cert, NULL) != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
-        X509_CRL_free(crl_x);
-        X509_free(kdc_cert);
-        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't initialize verification context\n");
-        return 0;
-    }
-#else
-    X509_STORE_CTX_init(verify_ctx, ca_store, kdc_cert, NULL);
-#endif
-
-    //verify the certificate
-    if (X509_verify_cert(verify_ctx) != 1) {
-        ERR_print_errors_fp(PASER_LOG_GET_FD);
-        X509_STORE_free(ca_store);
-        X509_STORE_CTX_free(verify_ctx);
+    int valid = verifyCert(kdc_store, kdc_cert);
+    X509_STORE_free(kdc_store);
+    if (valid != 1) {
         X509_CRL_free(crl_x);
         X509_free(kdc_cert);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't verify the certificate\n");
         return 0;
-    } else {
-        X509_STORE_free(ca_store);
-        X509_STORE_CTX_free(verify_ctx);
     }
 
     //check KDC Sign
     EVP_PKEY *pubKey = X509_get_pubkey(kdc_cert);
     X509_free(kdc_cert);
-    u_int32_t sig_len = data.sign.len;
-    u_int8_t *sign = data.sign.buf;
-    EVP_MD_CTX *md_ctx;
-    md_ctx = EVP_MD_CTX_create();
-    EVP_VerifyInit(md_ctx, EVP_sha1());
 
     int kdc_data_len = data.GTK.len + sizeof(data.nonce) + sizeof(data.key_nr) + data.CRL.len + data.cert_kdc.len;
     u_int8_t *temp = (u_int8_t*) malloc(kdc_data_len);
@@ -609,12 +458,12 @@ int PASER_crypto_sign::checkSignKDC(kdc_block data) {
     temp += data.CRL.len;
     memcpy(temp, (u_int8_t *) data.cert_kdc.buf, data.cert_kdc.len);
     temp += data.cert_kdc.len;
-    EVP_SignUpdate(md_ctx, tempData, kdc_data_len);
+    lv_block kdc_data;
+    kdc_data.buf = tempData;
+    kdc_data.len = kdc_data_len;
+    int err = PASER_sign_suite::verify(PASER_kdc_sign_suite, pubKey, kdc_data, data.sign);
     free(tempData);
-
-    int err = EVP_VerifyFinal(md_ctx, sign, sig_len, pubKey);
     EVP_PKEY_free(pubKey);
-    EVP_MD_CTX_destroy(md_ctx);
 
     if (err != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
@@ -623,10 +472,14 @@ int PASER_crypto_sign::checkSignKDC(kdc_block data) {
         return 0;
     }
     //aktualisiere CRL
+    boost::mutex::scoped_lock lock(certCacheMutex);
     if (crl) {
         X509_CRL_free(crl);
     }
     crl = crl_x;
+    if (updateStore() != 1) {
+        return 0;
+    }
     CRYTO_TIME_END
     return 1;
 }
@@ -692,20 +545,13 @@ bool PASER_crypto_sign::isKdcCert(X509 *cert) {
 
 int PASER_crypto_sign::rsa_encrypt(lv_block in, lv_block *out, X509 *cert) {
     CRYTO_TIME_BEGIN
-    EVP_PKEY *pubKey;
-    if (cert != NULL) {
-        pubKey = X509_get_pubkey(cert);
-    } else {
-        pubKey = X509_get_pubkey(x509);
+    if (cert == NULL) {
+        cert = x509;
     }
 
-    RSA *rsa = EVP_PKEY_get1_RSA(pubKey);
-    out->buf = (u_int8_t *) malloc(RSA_size(rsa));
-    int i = RSA_public_encrypt(in.len, in.buf, out->buf, rsa, RSA_PKCS1_PADDING);
-    out->len = i;
-    EVP_PKEY_free(pubKey);
-    RSA_free(rsa);
-    if (i < 0) {
+    int err = PASER_sign_suite::encrypt(in, out, cert);
+    if (err != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't encrypt lv_block\n");
         return 0;
     }
@@ -719,54 +565,218 @@ int PASER_crypto_sign::rsa_dencrypt(lv_block in, lv_block *out) {
         free(out->buf);
         out->len = 0;
     }
-    RSA *rsa = EVP_PKEY_get1_RSA(pkey);
-    u_int8_t *buf = (u_int8_t *) malloc(RSA_size(rsa));
-    int i = RSA_private_decrypt(in.len, in.buf, buf, rsa, RSA_PKCS1_PADDING);
-    if (i < 0) {
-        free(buf);
-        RSA_free(rsa);
+    if (PASER_sign_suite::decrypt(in, out, pkey, x509) != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't dencrypt lv_block\n");
         return 0;
     }
-    out->len = i;
-    out->buf = (u_int8_t *) malloc(i);
-    memcpy(out->buf, buf, i);
-    free(buf);
-    RSA_free(rsa);
     CRYTO_TIME_END
     return 1;
 }
 
 int PASER_crypto_sign::checkOneCert(X509 *cert) {
+    return checkCert(cert, NULL);
+}
+
+int PASER_crypto_sign::checkCert(X509 *cert, EVP_PKEY **pubKey) {
     CRYTO_TIME_BEGIN
     if (!cert) {
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Certificate == NULL\n");
         return 0;
     }
-    X509_STORE *ca_store;
-    ca_store = X509_STORE_new();
-    if (X509_STORE_add_cert(ca_store, ca_cert) != 1) {
+    struct timeval start;
+    struct timeval end;
+    gettimeofday(&start, NULL);
+
+    u_int8_t md[EVP_MAX_MD_SIZE];
+    u_int32_t md_len = 0;
+    if (X509_digest(cert, EVP_sha256(), md, &md_len) != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
-        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't add certificate to X509_STORE\n");
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't compute fingerprint of the certificate\n");
+        return 0;
+    }
+    std::string fingerprint((char *) md, md_len);
+
+    boost::mutex::scoped_lock lock(certCacheMutex);
+    std::map<std::string, cert_cache_entry>::iterator it = certCache.find(fingerprint);
+    if (it != certCache.end() && X509_cmp_current_time(X509_get_notAfter(cert)) <= 0) {
+        // the certificate is expired since the verification
+        EVP_PKEY_free(it->second.pubKey);
+        certCacheLru.erase(it->second.lruPos);
+        certCache.erase(it);
+        it = certCache.end();
+    }
+    bool cacheHit = (it != certCache.end());
+    int result = 1;
+    EVP_PKEY *key = NULL;
+    if (cacheHit) {
+        certCacheLru.splice(certCacheLru.begin(), certCacheLru, it->second.lruPos);
+        key = it->second.pubKey;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+        EVP_PKEY_up_ref(key);
+#else
+        CRYPTO_add(&key->references, 1, CRYPTO_LOCK_EVP_PKEY);
+#endif
+    } else {
+        // Verify without the lock, so that other threads can use the cache.
+        // The reference keeps the store alive if the CRL is changed meanwhile.
+        X509_STORE *store = ca_store;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+        X509_STORE_up_ref(store);
+#else
+        CRYPTO_add(&store->references, 1, CRYPTO_LOCK_X509_STORE);
+#endif
+        lock.unlock();
+        result = verifyCert(store, cert);
+        if (result == 1) {
+            key = X509_get_pubkey(cert);
+            if (key == NULL) {
+                ERR_print_errors_fp(PASER_LOG_GET_FD);
+                PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't read public key of the certificate\n");
+                result = 0;
+            }
+        }
+        lock.lock();
+        // Invalid certificates are not cached, they could become valid later
+        // (e.g. "not yet valid" because of a wrong clock). Certificates which
+        // are verified with an old CRL or cached by another thread are not cached either.
+        if (result == 1 && store == ca_store && certCache.find(fingerprint) == certCache.end()) {
+            if (certCache.size() >= PASER_CERT_CACHE_SIZE) {
+                std::map<std::string, cert_cache_entry>::iterator oldest = certCache.find(certCacheLru.back());
+                EVP_PKEY_free(oldest->second.pubKey);
+                certCache.erase(oldest);
+                certCacheLru.pop_back();
+            }
+            cert_cache_entry entry;
+            entry.pubKey = key;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+            EVP_PKEY_up_ref(key);
+#else
+            CRYPTO_add(&key->references, 1, CRYPTO_LOCK_EVP_PKEY);
+#endif
+            certCacheLru.push_front(fingerprint);
+            entry.lruPos = certCacheLru.begin();
+            certCache.insert(std::make_pair(fingerprint, entry));
+        }
+        X509_STORE_free(store);
+    }
+    gettimeofday(&end, NULL);
+    pGlobal->getPaserStatistic()->addCertVerify(cacheHit,
+            (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec));
+    lock.unlock();
+
+    if (result != 1) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Certificate is invalid\n");
+        return 0;
+    }
+    if (pubKey) {
+        *pubKey = key;
+    } else {
+        EVP_PKEY_free(key);
+    }
+    CRYTO_TIME_END
+    return 1;
+}
+
+int PASER_crypto_sign::verifySign(PASER_MSG *packet, lv_block sign, X509 *cert, EVP_PKEY *pubKey, int suite) {
+    // the result only depends on the signed fields, the signature and the key of the certificate
+    u_int8_t certMd[EVP_MAX_MD_SIZE];
+    u_int32_t certMd_len = 0;
+    if (X509_digest(cert, EVP_sha256(), certMd, &certMd_len) != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't compute fingerprint of the certificate\n");
         return 0;
     }
-    if (X509_STORE_set_default_paths(ca_store) != 1) {
+    u_int8_t md[EVP_MAX_MD_SIZE];
+    u_int32_t md_len = 0;
+    EVP_MD_CTX *md_ctx;
+    md_ctx = EVP_MD_CTX_create();
+    EVP_DigestInit(md_ctx, EVP_sha256());
+    PASER_digest_sink keySink(md_ctx);
+    packet->writeFields(&keySink);
+    keySink.write(sign.buf, sign.len);
+    keySink.write(certMd, certMd_len);
+    EVP_DigestFinal(md_ctx, md, &md_len);
+    EVP_MD_CTX_destroy(md_ctx);
+    std::string key((char *) md, md_len);
+
+    time_t now = time(NULL);
+    {
+        boost::mutex::scoped_lock lock(signCacheMutex);
+        std::map<std::string, sign_cache_entry>::iterator it = signCache.find(key);
+        if (it != signCache.end() && it->second.expires > now) {
+            pGlobal->getPaserStatistic()->addSignVerify(true);
+            return it->second.result;
+        }
+    }
+
+    int err = PASER_sign_suite::verify(suite, pubKey, packet, sign);
+    if (err != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
+    }
+
+    sign_cache_entry entry;
+    entry.result = (err == 1) ? 1 : 0;
+    entry.expires = now + PASER_time_diff;
+
+    boost::mutex::scoped_lock lock(signCacheMutex);
+    pGlobal->getPaserStatistic()->addSignVerify(false);
+    std::map<std::string, sign_cache_entry>::iterator it = signCache.find(key);
+    if (it != signCache.end()) {
+        signCacheFifo.erase(it->second.fifoPos);
+        signCache.erase(it);
+    }
+    // all entries have the same lifetime, so the oldest entries expire first
+    while (!signCacheFifo.empty()) {
+        std::map<std::string, sign_cache_entry>::iterator oldest = signCache.find(signCacheFifo.front());
+        if (oldest->second.expires > now && signCache.size() < PASER_SIGN_CACHE_SIZE) {
+            break;
+        }
+        signCache.erase(oldest);
+        signCacheFifo.pop_front();
+    }
+    signCacheFifo.push_back(key);
+    entry.fifoPos = --signCacheFifo.end();
+    signCache.insert(std::make_pair(key, entry));
+    return entry.result;
+}
+
+X509_STORE *PASER_crypto_sign::createStore(X509_CRL *crl_x) {
+    X509_STORE *store;
+    store = X509_STORE_new();
+    if (store == NULL) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't create X509_STORE\n");
+        return NULL;
+    }
+    if (X509_STORE_add_cert(store, ca_cert) != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
+        X509_STORE_free(store);
+        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't add certificate to X509_STORE\n");
+        return NULL;
+    }
+    if (X509_STORE_set_default_paths(store) != 1) {
+        ERR_print_errors_fp(PASER_LOG_GET_FD);
+        X509_STORE_free(store);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't set default path in X509_STORE\n");
-        return 0;
+        return NULL;
     }
-    if (crl) {
-        if (X509_STORE_add_crl(ca_store, crl) != 1) {
+    if (crl_x) {
+        if (X509_STORE_add_crl(store, crl_x) != 1) {
             ERR_print_errors_fp(PASER_LOG_GET_FD);
+            X509_STORE_free(store);
             PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't add CRL to X509_STORE\n");
-            return 0;
+            return NULL;
         }
 #if (OPENSSL_VERSION_NUMBER > 0x00907000L)
         //set the flag of the store so that CRLs are consulted
-        X509_STORE_set_flags(ca_store, X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL);
+        X509_STORE_set_flags(store, X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL);
 #endif
     }
+    return store;
+}
 
+int PASER_crypto_sign::verifyCert(X509_STORE *store, X509 *cert) {
     X509_STORE_CTX *verify_ctx;
     //create a verification context and initialize it
     if (!(verify_ctx = X509_STORE_CTX_new())) {
@@ -776,29 +786,44 @@ int PASER_crypto_sign::checkOneCert(X509 *cert) {
     }
     //X509_STORE_CTX_init did not return an error condition in prior versions
 #if (OPENSSL_VERSION_NUMBER > 0x00907000L)
-    if (X509_STORE_CTX_init(verify_ctx, ca_store, cert, NULL) != 1) {
+    if (X509_STORE_CTX_init(verify_ctx, store, cert, NULL) != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
+        X509_STORE_CTX_free(verify_ctx);
         PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Cann't initialize verification context\n");
         return 0;
     }
 #else
-    X509_STORE_CTX_init(verify_ctx, ca_store, cert, NULL);
+    X509_STORE_CTX_init(verify_ctx, store, cert, NULL);
 #endif
 
     //verify the certificate
-    if (X509_verify_cert(verify_ctx) != 1) {
+    int result = X509_verify_cert(verify_ctx);
+    X509_STORE_CTX_free(verify_ctx);
+    if (result != 1) {
         ERR_print_errors_fp(PASER_LOG_GET_FD);
-        X509_STORE_free(ca_store);
-        X509_STORE_CTX_free(verify_ctx);
-        PASER_LOG_WRITE_LOG(PASER_LOG_CRYPTO_ERROR, "Certificate is invalid\n");
         return 0;
-    } else {
-        X509_STORE_free(ca_store);
-        X509_STORE_CTX_free(verify_ctx);
-        CRYTO_TIME_END
-        return 1;
     }
+    return 1;
+}
 
-    return 0;
+int PASER_crypto_sign::updateStore() {
+    X509_STORE *store = createStore(crl);
+    if (store == NULL) {
+        return 0;
+    }
+    if (ca_store) {
+        X509_STORE_free(ca_store);
+    }
+    ca_store = store;
+    // the verification results depend on the CRL
+    clearCertCache();
+    return 1;
 }
 
+void PASER_crypto_sign::clearCertCache() {
+    for (std::map<std::string, cert_cache_entry>::iterator it = certCache.begin(); it != certCache.end(); it++) {
+        EVP_PKEY_free(it->second.pubKey);
+    }
+    certCache.clear();
+    certCacheLru.clear();
+}
@@ -45,7 +45,34 @@ class PASER_crypto_sign;
 
 #include "../config/PASER_global.h"
 
+#include <boost/thread/mutex.hpp>
+
 #include <map>
+#include <list>
+#include <string>
+
+/// Maximum number of certificates in the cache of verified certificates
+#define PASER_CERT_CACHE_SIZE 128
+
+/**
+ * Entry of the cache of verified certificates. Only valid certificates are cached.
+ */
+struct cert_cache_entry {
+    EVP_PKEY *pubKey;   ///< Public key of the certificate
+    std::list<std::string>::iterator lruPos; ///< Position in the LRU list
+};
+
+/// Maximum number of entries in the cache of checked message signatures
+#define PASER_SIGN_CACHE_SIZE 256
+
+/**
+ * Entry of the cache of checked message signatures.
+ */
+struct sign_cache_entry {
+    int result;         ///< Result of the signature check (1 - valid, 0 - invalid)
+    time_t expires;     ///< Time after which the entry is not used any more
+    std::list<std::string>::iterator fifoPos; ///< Position in the FIFO list
+};
 
 /**
  * Implementation of PASER_crypto_sign classes.
@@ -58,6 +85,15 @@ private:
     X509 *x509; 		///< own certificate
     X509 *ca_cert; 		///< CA certificate
     X509_CRL *crl; 		///< Certificate Revocation List
+    X509_STORE *ca_store; ///< Store with CA certificate and CRL which is used to verify certificates
+
+    std::map<std::string, cert_cache_entry> certCache; ///< Verified certificates by SHA-256 fingerprint
+    std::list<std::string> certCacheLru; ///< Fingerprints of cached certificates. Most recently used first.
+    boost::mutex certCacheMutex; ///< Protects crl, ca_store and the certificate cache. Signatures are checked on several threads
+
+    std::map<std::string, sign_cache_entry> signCache; ///< Results of signature checks by SHA-256 of signed fields, signature and certificate
+    std::list<std::string> signCacheFifo; ///< Keys of cached signature checks. Oldest first.
+    boost::mutex signCacheMutex; ///< Protects the cache of checked signatures
 
 public:
     /**
@@ -106,10 +142,11 @@ public:
      * Check a signature from PASER_UB_RREQ packet
      *
      *@param packet pointer to the PASER_TU_RREQ packet
+     *@param certForw decoded certificate of the forwarding node (certForw of the packet)
      *
      *@return 1 on successful or 0 on error
      */
-    int checkSignUBRREQ(PASER_UB_RREQ * packet);
+    int checkSignUBRREQ(PASER_UB_RREQ * packet, X509 *certForw);
 
     /**
      * Check a signature from kdc_block packet
@@ -133,10 +170,11 @@ public:
      * Check a signature from PASER_UU_RREP packet
      *
      *@param packet pointer to the PASER_UU_RREP packet
+     *@param certForw decoded certificate of the forwarding node (certForw of the packet)
      *
      *@return 1 on successful or 0 on error
      */
-    int checkSignUURREP(PASER_UU_RREP * packet);
+    int checkSignUURREP(PASER_UU_RREP * packet, X509 *certForw);
 
     /**
      * Compute a signature from PASER_B_ROOT packet and
@@ -194,6 +232,7 @@ public:
 
     /**
      * Encrypt the char array with a public key of given certificate
+     * (RSA or ECIES for EC certificates, see PASER_sign_suite)
      *
      *@param in char array that is to be encrypted
      *@param out pointer to char array which will contain encrypted array
@@ -205,6 +244,7 @@ public:
 
     /**
      * Decrypt the char array with a own asymmetric private key
+     * (RSA or ECIES for EC keys, see PASER_sign_suite)
      *
      *@param in char array that is to be decrypted
      *@param out pointer to char array which will contain decrypted array
@@ -231,6 +271,64 @@ public:
      */
     int checkOneCert(X509 *cert);
 
+private:
+    /**
+     * The function checks whether the certificate is valid. A valid certificate
+     * is cached until it expires or the CRL changes. Invalid certificates are
+     * verified again on each call.
+     *
+     *@param cert pointer to the certificate
+     *@param pubKey if not NULL and the certificate is valid, then it will be set to
+     *              the public key of the certificate. The key must be freed with EVP_PKEY_free().
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int checkCert(X509 *cert, EVP_PKEY **pubKey);
+
+    /**
+     * Check the signature over the fields of the packet. The results are
+     * cached for PASER_time_diff seconds, so that copies of the same message
+     * which are received from several neighbors are checked only once.
+     *
+     *@param packet pointer to the signed packet
+     *@param sign signature of the packet
+     *@param cert certificate of the signer which is already checked with checkCert()
+     *@param pubKey public key of the certificate
+     *@param suite expected signature suite of the signer
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int verifySign(PASER_MSG *packet, lv_block sign, X509 *cert, EVP_PKEY *pubKey, int suite);
+
+    /**
+     * Create a X509_STORE with the CA certificate and the given CRL.
+     *
+     *@param crl_x CRL or NULL
+     *
+     *@return X509_STORE on successful or NULL on error
+     */
+    X509_STORE *createStore(X509_CRL *crl_x);
+
+    /**
+     * Verify the certificate with the given store.
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int verifyCert(X509_STORE *store, X509 *cert);
+
+    /**
+     * Rebuild the persistent X509_STORE after a change of the CRL
+     * and clear the cache of verified certificates.
+     * The caller must hold certCacheMutex.
+     *
+     *@return 1 on successful or 0 on error
+     */
+    int updateStore();
+
+    /**
+     * Remove all certificates from the cache of verified certificates.
+     */
+    void clearCertCache();
 };
 
 #endif /* PASER_CRYPTO_SIGN_H_ */
@@ -0,0 +1,78 @@
+/**
+ *\class  		PASER_digest_sink
+ *@brief       	Class feeds the fields of a PASER packet into a message digest or HMAC.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#ifndef PASER_DIGEST_SINK_H_
+#define PASER_DIGEST_SINK_H_
+
+#include "../packet_structure/PASER_field_sink.h"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <vector>
+
+/**
+ * Sink which streams the fields of a packet into a digest context
+ * (EVP_SignUpdate, EVP_VerifyUpdate) or a HMAC context without
+ * serializing the packet into a buffer. Signature algorithms which
+ * can't be streamed (Ed25519) collect the fields in a buffer.
+ */
+class PASER_digest_sink: public PASER_field_sink {
+private:
+    EVP_MD_CTX *md_ctx;
+    HMAC_CTX *hmac_ctx;
+    std::vector<uint8_t> *buffer;
+
+public:
+    PASER_digest_sink(EVP_MD_CTX *ctx) {
+        md_ctx = ctx;
+        hmac_ctx = NULL;
+        buffer = NULL;
+    }
+
+    PASER_digest_sink(HMAC_CTX *ctx) {
+        md_ctx = NULL;
+        hmac_ctx = ctx;
+        buffer = NULL;
+    }
+
+    PASER_digest_sink(std::vector<uint8_t> *buf) {
+        md_ctx = NULL;
+        hmac_ctx = NULL;
+        buffer = buf;
+    }
+
+    void write(const void *data, size_t len) {
+        if (len == 0) {
+            return;
+        }
+        if (md_ctx) {
+            EVP_DigestUpdate(md_ctx, data, len);
+        } else if (buffer) {
+            buffer->insert(buffer->end(), (const uint8_t *) data, (const uint8_t *) data + len);
+        } else {
+            HMAC_Update(hmac_ctx, (const unsigned char *) data, len);
+        }
+    }
+};
+
+#endif /* PASER_DIGEST_SINK_H_ */
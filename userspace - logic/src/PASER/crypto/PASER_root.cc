@@ -27,8 +27,17 @@
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 
+#include <boost/bind.hpp>
+
 //#define CRYPTOROOTTIMEMEASUREMENT
 
+/// Maximal number of random bytes requested from RAND_bytes at once
+#define PASER_ROOT_RAND_CHUNK (1 << 20)
+/// Minimal number of secrets for which the authentication tree is calculated by several threads
+#define PASER_ROOT_PARALLEL_MIN_SECRETS (1 << 12)
+/// Maximal number of threads which calculate the authentication tree
+#define PASER_ROOT_MAX_THREADS 8
+
 #ifdef CRYPTOROOTTIMEMEASUREMENT
 #include <sys/time.h>
 #define CRYTO_ROOT_TIME_BEGIN \
@@ -45,6 +54,16 @@
 
 PASER_root::PASER_root(PASER_global *paser_global) {
     pGlobal = paser_global;
+    param = 0;
+    secret_count = 0;
+    secrets = NULL;
+    tree = NULL;
+    iv_nr = 0;
+    root_elem = NULL;
+    next_secrets = NULL;
+    next_tree = NULL;
+    nextTreeThread = NULL;
+    nextTreeReady = false;
 }
 
 PASER_root::~PASER_root() {
@@ -52,19 +71,29 @@ PASER_root::~PASER_root() {
 }
 
 void PASER_root::clearLists() {
-    for (std::list<uint8_t *>::iterator it = secret_list.begin(); it != secret_list.end(); it++) {
-        uint8_t *data = (uint8_t *) *it;
-        free(data);
+    dropNextTree();
+    if (secrets) {
+        free(secrets);
+        secrets = NULL;
+    }
+    if (tree) {
+        free(tree);
+        tree = NULL;
     }
-    secret_list.clear();
-    for (std::list<uint8_t *>::iterator it = tree.begin(); it != tree.end(); it++) {
-        uint8_t *data = (uint8_t *) *it;
-        free(data);
+    if (next_secrets) {
+        free(next_secrets);
+        next_secrets = NULL;
     }
-    tree.clear();
+    if (next_tree) {
+        free(next_tree);
+        next_tree = NULL;
+    }
+    secret_count = 0;
+    root_elem = NULL;
 }
 
 bool PASER_root::init(int n) {
+    dropNextTree();
     iv_nr = 0;
     if (n > 31)
         return false;
@@ -73,19 +102,60 @@ bool PASER_root::init(int n) {
     return regenerate();
 }
 
+bool PASER_root::allocTree(uint8_t **secrets_buf, uint8_t **tree_buf) {
+    uint32_t b = 1;
+    b = b << param;
+    *secrets_buf = (uint8_t *) malloc(sizeof(uint8_t) * PASER_SECRET_LEN * (size_t) b);
+    *tree_buf = (uint8_t *) malloc(sizeof(uint8_t) * SHA256_DIGEST_LENGTH * 2 * (size_t) b);
+    if (*secrets_buf == NULL || *tree_buf == NULL) {
+        free(*secrets_buf);
+        free(*tree_buf);
+        *secrets_buf = NULL;
+        *tree_buf = NULL;
+        return false;
+    }
+    return true;
+}
+
 bool PASER_root::regenerate() {
     CRYTO_ROOT_TIME_BEGIN
-    clearLists();
+    uint32_t b = 1;
+    b = b << param;
+    // Allocate secrets and tree only once, the size depends on param
+    if (secret_count != b) {
+        clearLists();
+        if (!allocTree(&secrets, &tree)) {
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Cann't allocate authentication tree\n");
+            return false;
+        }
+        secret_count = b;
+    } else {
+        dropNextTree();
+    }
+    if (!generateSecrets(secrets)) {
+        return false;
+    }
+
+// Compute authentication tree
+    calculateTree(secrets, tree);
+    root_elem = getNode(tree, 1);
+    CRYTO_ROOT_TIME_END
+    return true;
+}
+
+bool PASER_root::generateSecrets(uint8_t *secrets_buf) {
     int n = param;
-    int b = 1;
-    b = b << n;
-    // Generate secrets
-    for (int i = 0; i < b; i++) {
-        uint8_t *buf = (uint8_t *) malloc((sizeof(uint8_t) * PASER_SECRET_LEN));
-        // Generate random bites
-        if (RAND_bytes(buf, PASER_SECRET_LEN) != 1) {
+    // Generate random bites
+    size_t secrets_len = (size_t) PASER_SECRET_LEN * secret_count;
+    for (size_t off = 0; off < secrets_len; off += PASER_ROOT_RAND_CHUNK) {
+        int len = secrets_len - off < PASER_ROOT_RAND_CHUNK ? secrets_len - off : PASER_ROOT_RAND_CHUNK;
+        if (RAND_bytes(secrets_buf + off, len) != 1) {
             return false;
         }
+    }
+    // Generate secrets
+    for (uint32_t i = 0; i < secret_count; i++) {
+        uint8_t *buf = secrets_buf + (size_t) i * PASER_SECRET_LEN;
         // Set IV
         int count = i << (32 - n);
         for (int j = 0; j < n; j++) {
@@ -99,44 +169,121 @@ bool PASER_root::regenerate() {
             buf[block_nr] = buf[block_nr] & del;
             buf[block_nr] = buf[block_nr] | set_bit;
         }
-        // Push generated secret to secret_list
-        secret_list.push_back(buf);
+    }
+    return true;
+}
+
+uint8_t* PASER_root::getNode(uint8_t *tree_buf, uint32_t index) {
+    return tree_buf + (size_t) index * SHA256_DIGEST_LENGTH;
+}
+
+void PASER_root::calculateTree(uint8_t *secrets_buf, uint8_t *tree_buf) {
+    // Split the tree in 2^k subtrees, one per thread
+    int k = 0;
+    if (secret_count >= PASER_ROOT_PARALLEL_MIN_SECRETS) {
+        unsigned int threads = boost::thread::hardware_concurrency();
+        if (threads > PASER_ROOT_MAX_THREADS) {
+            threads = PASER_ROOT_MAX_THREADS;
+        }
+        while ((2u << k) <= threads && k < param) {
+            k++;
+        }
+    }
+    uint32_t subtrees = 1 << k;
+    if (subtrees == 1) {
+        calculateSubtree(secrets_buf, tree_buf, 1, param);
+        return;
+    }
 
+    boost::thread_group workers;
+    for (uint32_t t = 1; t < subtrees; t++) {
+        workers.create_thread(boost::bind(&PASER_root::calculateSubtree, this, secrets_buf, tree_buf, subtrees + t, param - k));
     }
+    calculateSubtree(secrets_buf, tree_buf, subtrees, param - k);
+    workers.join_all();
 
-//    root_elem = root_getHashTreeValue(0, secret_list.size()-1);
-//    printf("root_elem:0x");
-//    for (int n = 0; n < SHA256_DIGEST_LENGTH; n++)
-//        printf("%02x", root_elem[n]);
-//    putchar('\n');
+    // Nodes above the subtrees
+    for (uint32_t i = subtrees - 1; i > 0; i--) {
+        getHash(getNode(tree_buf, 2 * i), getNode(tree_buf, 2 * i + 1), getNode(tree_buf, i));
+    }
+}
 
-// Compute authentication tree
-    calculateTree();
-    CRYTO_ROOT_TIME_END
-    return true;
+void PASER_root::calculateSubtree(uint8_t *secrets_buf, uint8_t *tree_buf, uint32_t subtreeRoot, int depth) {
+    // Leaves
+    uint32_t first = subtreeRoot << depth;
+    uint32_t count = 1 << depth;
+    for (uint32_t i = first; i < first + count; i++) {
+        getOneHash(secrets_buf + (size_t) (i - secret_count) * PASER_SECRET_LEN, PASER_SECRET_LEN, getNode(tree_buf, i));
+    }
+    // Inner nodes, level by level up to the root of the subtree
+    for (int d = depth - 1; d >= 0; d--) {
+        first = subtreeRoot << d;
+        count = 1 << d;
+        for (uint32_t i = first; i < first + count; i++) {
+            getHash(getNode(tree_buf, 2 * i), getNode(tree_buf, 2 * i + 1), getNode(tree_buf, i));
+        }
+    }
 }
 
-void PASER_root::calculateTree() {
-    for (std::list<uint8_t *>::iterator it = secret_list.begin(); it != secret_list.end(); it++) {
-        uint8_t *data = getOneHash((uint8_t *) *it, PASER_SECRET_LEN);
-        tree.push_back(data);
+void PASER_root::startNextTree() {
+    if (nextTreeThread != NULL || nextTreeReady) {
+        return;
+    }
+    if (next_secrets == NULL && !allocTree(&next_secrets, &next_tree)) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Cann't allocate next authentication tree\n");
+        return;
     }
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+    // RAND_bytes of OpenSSL < 1.1.0 is not thread safe without locking callbacks
+    if (!generateSecrets(next_secrets)) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Cann't generate secrets of next authentication tree\n");
+        return;
+    }
+#endif
+    PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Start generation of next authentication tree at IV %u\n", iv_nr);
+    nextTreeThread = new boost::thread(boost::bind(&PASER_root::generateNextTree, this));
+}
 
-    for (int i = param; i > 0; i--) {
-        int steps = 1 << (i - 1);
-        std::list<uint8_t *>::iterator it = tree.begin();
-        std::list<uint8_t *> temp;
-        for (int k = 0; k < steps; k++) {
-            uint8_t *data1 = (uint8_t *) *it;
-            it++;
-            uint8_t *data2 = (uint8_t *) *it;
-            it++;
-            temp.push_back(getHash(data1, data2));
-        }
-        tree.insert(tree.begin(), temp.begin(), temp.end());
+void PASER_root::generateNextTree() {
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    if (!generateSecrets(next_secrets)) {
+        nextTreeReady = false;
+        return;
     }
+#endif
+    calculateTree(next_secrets, next_tree);
+    nextTreeReady = true;
+}
+
+bool PASER_root::finishNextTree() {
+    if (nextTreeThread == NULL) {
+        return false;
+    }
+    nextTreeThread->join();
+    delete nextTreeThread;
+    nextTreeThread = NULL;
+    if (!nextTreeReady) {
+        return false;
+    }
+    nextTreeReady = false;
+
+    uint8_t *temp = secrets;
+    secrets = next_secrets;
+    next_secrets = temp;
+    temp = tree;
+    tree = next_tree;
+    next_tree = temp;
+    root_elem = getNode(tree, 1);
+    return true;
+}
 
-    root_elem = tree.front();
+void PASER_root::dropNextTree() {
+    if (nextTreeThread != NULL) {
+        nextTreeThread->join();
+        delete nextTreeThread;
+        nextTreeThread = NULL;
+    }
+    nextTreeReady = false;
 }
 
 uint8_t* PASER_root::getRoot() {
@@ -147,12 +294,13 @@ uint8_t* PASER_root::getRoot() {
 
 std::list<uint8_t *> PASER_root::getNextSecret(int *nr, uint8_t *secret) {
     std::list<uint8_t *> iv;
-    std::list<uint8_t *>::iterator it;
-    if (iv_nr >= secret_list.size()) {
-        //generate new authentication tree and send root message
-        regenerate();
+    if (iv_nr >= secret_count) {
+        //take the authentication tree generated in background or generate new authentication tree
+        if (!finishNextTree()) {
+            regenerate();
+        }
         iv_nr = 0;
-        //set timeout and send root
+        //set timeout and send root message
         struct timeval now;
         pGlobal->getPASERtimeofday(&now);
 
@@ -163,53 +311,24 @@ std::list<uint8_t *> PASER_root::getNextSecret(int *nr, uint8_t *secret) {
             timer->destAddr.s_addr = PASER_BROADCAST;
             timer->timeout = timeval_add(now, pGlobal->getPaser_configuration()->getRootRepetitionsTimeout()*(i+1));
             pGlobal->getTimer_queue()->timer_add(timer);
-            pGlobal->getTimer_queue()->timer_sort();
         }
         pGlobal->getPacketSender()->send_root();
         pGlobal->incSeqNr();
     }
-    it = tree.end();
-    it--;
-    int point = iv_nr;
-    for (int i = param; i > 0; i--) {
-        int steps = 1 << i;
-        for (int k = steps - 1; k >= 0; k--) {
-            if (k == point) {
-                if (point % 2 == 0) {
-                    it++;
-                    uint8_t *buf = (uint8_t *) malloc((sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-                    uint8_t *buf2 = (uint8_t *) *it;
-                    memcpy(buf, buf2, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-                    iv.push_back(buf);
-                    it--;
-                } else {
-                    it--;
-                    uint8_t *buf = (uint8_t *) malloc((sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-                    uint8_t *buf2 = (uint8_t *) *it;
-                    memcpy(buf, buf2, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-                    iv.push_back(buf);
-                    it++;
-                }
-            }
-            it--;
-        }
-        point = point / 2;
-    }
-    uint32_t count = 0;
-    for (std::list<uint8_t *>::iterator IT = secret_list.begin(); IT != secret_list.end(); IT++) {
-        if (count == iv_nr) {
-            uint8_t *temp = (uint8_t *) *IT;
-            memcpy(secret, temp, (sizeof(uint8_t) * PASER_SECRET_LEN));
-            break;
-        }
-        count++;
+    // Authentication path: siblings of all nodes from the leaf up to the root
+    for (uint32_t node = secret_count + iv_nr; node > 1; node = node / 2) {
+        uint8_t *buf = (uint8_t *) malloc((sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
+        memcpy(buf, getNode(tree, node ^ 1), (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
+        iv.push_back(buf);
     }
+    memcpy(secret, secrets + (size_t) iv_nr * PASER_SECRET_LEN, (sizeof(uint8_t) * PASER_SECRET_LEN));
     *nr = iv_nr;
     iv_nr++;
-//    if(iv_nr >= secret_list.size()){
-//        regenerate();
-//        iv_nr = 0;
-//    }
+
+    //generate the next authentication tree in background
+    if (PASER_root_pregen_threshold > 0 && iv_nr >= PASER_root_pregen_threshold * secret_count) {
+        startNextTree();
+    }
 
     return iv;
 }
@@ -218,25 +337,21 @@ int PASER_root::getIV() {
     return iv_nr;
 }
 
-uint8_t *PASER_root::getOneHash(uint8_t* h1, int len) {
+void PASER_root::getOneHash(uint8_t* h1, int len, uint8_t* result) {
     SHA256_CTX ctx;
-    uint8_t *results = (uint8_t *) malloc(sizeof(uint8_t) * SHA256_DIGEST_LENGTH);
 
     SHA256_Init(&ctx);
     SHA256_Update(&ctx, (uint8_t *) h1, sizeof(uint8_t) * SHA256_DIGEST_LENGTH);
-    SHA256_Final(results, &ctx);
-    return results;
+    SHA256_Final(result, &ctx);
 }
 
-uint8_t *PASER_root::getHash(uint8_t* h1, uint8_t* h2) {
+void PASER_root::getHash(uint8_t* h1, uint8_t* h2, uint8_t* result) {
     SHA256_CTX ctx;
-    uint8_t *results = (uint8_t *) malloc(sizeof(uint8_t) * SHA256_DIGEST_LENGTH);
 
     SHA256_Init(&ctx);
     SHA256_Update(&ctx, (uint8_t *) h1, sizeof(uint8_t) * SHA256_DIGEST_LENGTH);
     SHA256_Update(&ctx, (uint8_t *) h2, sizeof(uint8_t) * SHA256_DIGEST_LENGTH);
-    SHA256_Final(results, &ctx);
-    return results;
+    SHA256_Final(result, &ctx);
 }
 
 int PASER_root::checkRoot(uint8_t* root, uint8_t* secret, std::list<uint8_t *> iv_list, uint32_t iv, uint32_t *newIV) {
@@ -257,28 +372,22 @@ int PASER_root::checkRoot(uint8_t* root, uint8_t* secret, std::list<uint8_t *> i
 
     *newIV = new_iv + 1;
 
-    uint8_t *buf;
-    buf = getOneHash(secret, PASER_SECRET_LEN);
+    uint8_t buf[SHA256_DIGEST_LENGTH];
+    getOneHash(secret, PASER_SECRET_LEN, buf);
     for (std::list<uint8_t *>::iterator it = iv_list.begin(); it != iv_list.end(); it++) {
         if (new_iv % 2 == 1) {
-            uint8_t * temp = getHash((uint8_t *) *it, buf);
-            free(buf);
-            buf = temp;
+            getHash((uint8_t *) *it, buf, buf);
         } else {
-            uint8_t * temp = getHash(buf, (uint8_t *) *it);
-            free(buf);
-            buf = temp;
+            getHash(buf, (uint8_t *) *it, buf);
         }
         new_iv = new_iv / 2;
     }
 
     if (memcmp(root, buf, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH)) == 0) {
-        free(buf);
         CRYTO_ROOT_TIME_END
         return 1;
     }
 
-    free(buf);
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Wrong hash value\n");
     return 0;
 }
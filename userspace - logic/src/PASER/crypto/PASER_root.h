@@ -27,6 +27,7 @@ class PASER_root;
 
 #include <openssl/crypto.h>
 #include <list>
+#include <boost/thread.hpp>
 
 #include "../config/PASER_defs.h"
 #include "../config/PASER_global.h"
@@ -39,11 +40,23 @@ private:
     PASER_global *pGlobal;
 
     int param;                         ///< number of generated secrets 2^param
-    std::list<uint8_t *> secret_list;  ///< list of all generated secrets
-    std::list<uint8_t *> tree;         ///< list of computed authentication tree
+    uint32_t secret_count;             ///< number of generated secrets (2^param)
+    uint8_t *secrets;                  ///< all generated secrets, PASER_SECRET_LEN bytes each
+    /**
+     * Computed authentication tree, SHA256_DIGEST_LENGTH bytes per node.
+     * The nodes are stored level by level (heap order): the root is node 1,
+     * the children of node i are 2i and 2i+1 and the hash of secret k is node
+     * secret_count+k. Node 0 is not used.
+     */
+    uint8_t *tree;
     uint32_t iv_nr;                    ///< IV
     uint8_t* root_elem;                ///< Root element
 
+    uint8_t *next_secrets;             ///< secrets of the next authentication tree
+    uint8_t *next_tree;                ///< next authentication tree (same layout as tree)
+    boost::thread *nextTreeThread;     ///< thread which computes the next authentication tree or NULL
+    bool nextTreeReady;                ///< Is the next authentication tree generated and ready
+
     bool authTreeReady;                ///< Is authentication tree generated and ready
 
 public:
@@ -110,33 +123,96 @@ public:
     int checkRoot( uint8_t* root, uint8_t* secret, std::list<uint8_t *> iv_list, uint32_t iv, uint32_t *newIV );
 
 private:
+    /**
+     * Allocate secrets and authentication tree for 2^param secrets
+     *
+     *@param secrets_buf pointer to the secrets which will be set
+     *@param tree_buf pointer to the authentication tree which will be set
+     *
+     *@return true on successful or false on error
+     */
+    bool allocTree(uint8_t **secrets_buf, uint8_t **tree_buf);
+
+    /**
+     * Generate random secrets and set IV of each secret
+     *
+     *@param secrets_buf secrets which will be generated
+     *
+     *@return true on successful or false on error
+     */
+    bool generateSecrets(uint8_t *secrets_buf);
+
     /**
      * Calculate authentication tree. All secrets must be generated.
+     *
+     *@param secrets_buf generated secrets
+     *@param tree_buf authentication tree which will be computed
+     */
+    void calculateTree(uint8_t *secrets_buf, uint8_t *tree_buf);
+
+    /**
+     * Calculate a subtree of the authentication tree. The subtrees of different
+     * nodes on the same level can be calculated in parallel.
+     *
+     *@param secrets_buf generated secrets
+     *@param tree_buf authentication tree which will be computed
+     *@param subtreeRoot heap index of the root of the subtree
+     *@param depth depth of the subtree (number of levels below subtreeRoot)
      */
-    void calculateTree();
+    void calculateSubtree(uint8_t *secrets_buf, uint8_t *tree_buf, uint32_t subtreeRoot, int depth);
+
+    /**
+     * Start the computation of the next authentication tree in background
+     */
+    void startNextTree();
+
+    /**
+     * Compute the next authentication tree. Runs in the thread nextTreeThread.
+     */
+    void generateNextTree();
+
+    /**
+     * Wait for the next authentication tree and replace the current tree with it
+     *
+     *@return true on successful or false if no next tree is available
+     */
+    bool finishNextTree();
+
+    /**
+     * Wait for the thread nextTreeThread and discard the next authentication tree
+     */
+    void dropNextTree();
+
+    /**
+     * Get node of the authentication tree
+     *
+     *@param tree_buf authentication tree
+     *@param index heap index of the node
+     *
+     *@return pointer to the node
+     */
+    uint8_t* getNode(uint8_t *tree_buf, uint32_t index);
 
     /**
      * Compute hash
      *
      *@param h1 pointer to char array which will be hashed
      *@param len length of the char array
-     *
-     *@return hash
+     *@param result pointer to the buffer (SHA256_DIGEST_LENGTH bytes) which will be set to the hash
      */
-    uint8_t* getOneHash(uint8_t* h1, int len);
+    void getOneHash(uint8_t* h1, int len, uint8_t* result);
 
     /**
      * Compute hash
      *
      *@param h1 pointer to char array which will be hashed
      *@param h2 pointer to char array which will be hashed
-     *
-     *@return hash
+     *@param result pointer to the buffer (SHA256_DIGEST_LENGTH bytes) which will be set to the hash
      */
-    uint8_t* getHash(uint8_t* h1, uint8_t* h2);
+    void getHash(uint8_t* h1, uint8_t* h2, uint8_t* result);
 
     /**
-     * clear list of all generated secrets and list of computed authentication tree
+     * free all generated secrets and the computed authentication tree
      */
     void clearLists();
 };
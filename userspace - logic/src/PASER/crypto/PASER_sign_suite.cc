@@ -0,0 +1,424 @@
+/**
+ *\class  		PASER_sign_suite
+ *@brief       	Class implements the signature suites of PASER control messages and the matching key transport.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_sign_suite.h"
+#include "PASER_digest_sink.h"
+
+#include <openssl/rsa.h>
+#include <openssl/ec.h>
+#include <openssl/x509.h>
+#include <openssl/rand.h>
+#include <openssl/objects.h>
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+#include <openssl/kdf.h>
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+
+/// Length of the initialization vector of AES-GCM
+#define PASER_ECIES_IV_LEN 12
+/// Length of the authentication tag of AES-GCM
+#define PASER_ECIES_TAG_LEN 16
+/// Length of the AES-256 key
+#define PASER_ECIES_KEY_LEN 32
+/// Length of the additional authenticated data (SHA-256 fingerprint of the recipient certificate)
+#define PASER_ECIES_AAD_LEN 32
+/// HKDF info of the ECIES key derivation
+#define PASER_ECIES_INFO "PASER ECIES AES-256-GCM"
+
+static void writeSigned(PASER_MSG *packet, lv_block data, PASER_field_sink *sink) {
+    if (packet) {
+        packet->writeFields(sink);
+    } else {
+        sink->write(data.buf, data.len);
+    }
+}
+
+const char *PASER_sign_suite::getName(int suite) {
+    switch (suite) {
+    case PASER_SIGN_SUITE_RSA:
+        return "rsa";
+    case PASER_SIGN_SUITE_ECDSA_P256:
+        return "ecdsa-p256";
+    case PASER_SIGN_SUITE_ED25519:
+        return "ed25519";
+    default:
+        return "unknown";
+    }
+}
+
+int PASER_sign_suite::getSuite(const char *name) {
+    if (strcmp(name, "rsa") == 0) {
+        return PASER_SIGN_SUITE_RSA;
+    }
+    if (strcmp(name, "ecdsa-p256") == 0) {
+        return PASER_SIGN_SUITE_ECDSA_P256;
+    }
+    if (strcmp(name, "ed25519") == 0) {
+        return PASER_SIGN_SUITE_ED25519;
+    }
+    return -1;
+}
+
+int PASER_sign_suite::checkKey(EVP_PKEY *key, int suite) {
+    if (key == NULL) {
+        return 0;
+    }
+    switch (suite) {
+    case PASER_SIGN_SUITE_RSA:
+        return EVP_PKEY_id(key) == EVP_PKEY_RSA;
+    case PASER_SIGN_SUITE_ECDSA_P256: {
+        if (EVP_PKEY_id(key) != EVP_PKEY_EC) {
+            return 0;
+        }
+        EC_KEY *ec = EVP_PKEY_get1_EC_KEY(key);
+        int nid = EC_GROUP_get_curve_name(EC_KEY_get0_group(ec));
+        EC_KEY_free(ec);
+        return nid == NID_X9_62_prime256v1;
+    }
+    case PASER_SIGN_SUITE_ED25519:
+#ifdef EVP_PKEY_ED25519
+        return EVP_PKEY_id(key) == EVP_PKEY_ED25519;
+#else
+        return 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+const EVP_MD *PASER_sign_suite::getDigest(int suite) {
+    switch (suite) {
+    case PASER_SIGN_SUITE_RSA:
+        return EVP_sha1();
+    case PASER_SIGN_SUITE_ECDSA_P256:
+        return EVP_sha256();
+    default:
+        return NULL;
+    }
+}
+
+int PASER_sign_suite::sign(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block *sign) {
+    lv_block data;
+    data.buf = NULL;
+    data.len = 0;
+    return signFields(suite, key, packet, data, sign);
+}
+
+int PASER_sign_suite::sign(int suite, EVP_PKEY *key, lv_block data, lv_block *sign) {
+    return signFields(suite, key, NULL, data, sign);
+}
+
+int PASER_sign_suite::verify(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block sign) {
+    lv_block data;
+    data.buf = NULL;
+    data.len = 0;
+    return verifyFields(suite, key, packet, data, sign);
+}
+
+int PASER_sign_suite::verify(int suite, EVP_PKEY *key, lv_block data, lv_block sign) {
+    return verifyFields(suite, key, NULL, data, sign);
+}
+
+int PASER_sign_suite::signFields(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block data, lv_block *sign) {
+    if (checkKey(key, suite) != 1) {
+        return 0;
+    }
+    const EVP_MD *md = getDigest(suite);
+    EVP_MD_CTX *md_ctx;
+    md_ctx = EVP_MD_CTX_create();
+    if (EVP_DigestSignInit(md_ctx, NULL, md, NULL, key) != 1) {
+        EVP_MD_CTX_destroy(md_ctx);
+        return 0;
+    }
+
+    size_t sig_len = 0;
+    u_int8_t *sig = NULL;
+    int err = 0;
+    if (md) {
+        PASER_digest_sink sink(md_ctx);
+        writeSigned(packet, data, &sink);
+        // the first call returns the maximum length of the signature
+        err = EVP_DigestSignFinal(md_ctx, NULL, &sig_len);
+        if (err == 1) {
+            sig = (u_int8_t *) malloc(sig_len);
+            err = EVP_DigestSignFinal(md_ctx, sig, &sig_len);
+        }
+    } else {
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+        std::vector<uint8_t> fields;
+        PASER_digest_sink sink(&fields);
+        writeSigned(packet, data, &sink);
+        const u_int8_t *fields_buf = fields.empty() ? NULL : &fields[0];
+        err = EVP_DigestSign(md_ctx, NULL, &sig_len, fields_buf, fields.size());
+        if (err == 1) {
+            sig = (u_int8_t *) malloc(sig_len);
+            err = EVP_DigestSign(md_ctx, sig, &sig_len, fields_buf, fields.size());
+        }
+#endif
+    }
+    EVP_MD_CTX_destroy(md_ctx);
+    if (err != 1) {
+        free(sig);
+        return 0;
+    }
+    sign->buf = sig;
+    sign->len = sig_len;
+    return 1;
+}
+
+int PASER_sign_suite::verifyFields(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block data, lv_block sign) {
+    // reject keys of other suites, e.g. RSA signatures in an ECDSA network
+    if (checkKey(key, suite) != 1 || sign.buf == NULL) {
+        return 0;
+    }
+    const EVP_MD *md = getDigest(suite);
+    EVP_MD_CTX *md_ctx;
+    md_ctx = EVP_MD_CTX_create();
+    if (EVP_DigestVerifyInit(md_ctx, NULL, md, NULL, key) != 1) {
+        EVP_MD_CTX_destroy(md_ctx);
+        return 0;
+    }
+
+    int err = 0;
+    if (md) {
+        PASER_digest_sink sink(md_ctx);
+        writeSigned(packet, data, &sink);
+        err = EVP_DigestVerifyFinal(md_ctx, sign.buf, sign.len);
+    } else {
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+        std::vector<uint8_t> fields;
+        PASER_digest_sink sink(&fields);
+        writeSigned(packet, data, &sink);
+        err = EVP_DigestVerify(md_ctx, sign.buf, sign.len, fields.empty() ? NULL : &fields[0], fields.size());
+#endif
+    }
+    EVP_MD_CTX_destroy(md_ctx);
+    return err == 1 ? 1 : 0;
+}
+
+int PASER_sign_suite::deriveKey(EVP_PKEY *own, EVP_PKEY *peer, const u_int8_t *ephemeral, int ephemeral_len,
+        u_int8_t *key) {
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(own, NULL);
+    size_t secret_len = 0;
+    if (ctx == NULL || EVP_PKEY_derive_init(ctx) != 1 || EVP_PKEY_derive_set_peer(ctx, peer) != 1
+            || EVP_PKEY_derive(ctx, NULL, &secret_len) != 1) {
+        EVP_PKEY_CTX_free(ctx);
+        return 0;
+    }
+    u_int8_t *secret = (u_int8_t *) malloc(secret_len);
+    if (EVP_PKEY_derive(ctx, secret, &secret_len) != 1) {
+        free(secret);
+        EVP_PKEY_CTX_free(ctx);
+        return 0;
+    }
+    EVP_PKEY_CTX_free(ctx);
+
+    // key = HKDF-SHA256(ECDH secret, salt = ephemeral public key)
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    EVP_PKEY_CTX *kdf_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, NULL);
+    size_t key_len = PASER_ECIES_KEY_LEN;
+    int ok = kdf_ctx != NULL && EVP_PKEY_derive_init(kdf_ctx) == 1
+            && EVP_PKEY_CTX_set_hkdf_md(kdf_ctx, EVP_sha256()) == 1
+            && EVP_PKEY_CTX_set1_hkdf_salt(kdf_ctx, (u_int8_t *) ephemeral, ephemeral_len) == 1
+            && EVP_PKEY_CTX_set1_hkdf_key(kdf_ctx, secret, secret_len) == 1
+            && EVP_PKEY_CTX_add1_hkdf_info(kdf_ctx, (u_int8_t *) PASER_ECIES_INFO, strlen(PASER_ECIES_INFO)) == 1
+            && EVP_PKEY_derive(kdf_ctx, key, &key_len) == 1 && key_len == PASER_ECIES_KEY_LEN;
+    EVP_PKEY_CTX_free(kdf_ctx);
+#else
+    // HKDF needs OpenSSL 1.1.0 or later
+    int ok = 0;
+#endif
+    OPENSSL_cleanse(secret, secret_len);
+    free(secret);
+    return ok;
+}
+
+int PASER_sign_suite::getAad(X509 *cert, u_int8_t *aad) {
+    u_int32_t aad_len = 0;
+    return X509_digest(cert, EVP_sha256(), aad, &aad_len) == 1 && aad_len == PASER_ECIES_AAD_LEN;
+}
+
+int PASER_sign_suite::encrypt(lv_block in, lv_block *out, X509 *cert) {
+    out->buf = NULL;
+    out->len = 0;
+    if (cert == NULL) {
+        return 0;
+    }
+    EVP_PKEY *key = X509_get_pubkey(cert);
+    if (key == NULL) {
+        return 0;
+    }
+    int result = 0;
+    if (EVP_PKEY_id(key) == EVP_PKEY_RSA) {
+        RSA *rsa = EVP_PKEY_get1_RSA(key);
+        u_int8_t *buf = (u_int8_t *) malloc(RSA_size(rsa));
+        int i = RSA_public_encrypt(in.len, in.buf, buf, rsa, RSA_PKCS1_PADDING);
+        RSA_free(rsa);
+        if (i < 0) {
+            free(buf);
+        } else {
+            out->buf = buf;
+            out->len = i;
+            result = 1;
+        }
+    } else if (EVP_PKEY_id(key) == EVP_PKEY_EC) {
+        result = encryptECIES(in, out, key, cert);
+    }
+    EVP_PKEY_free(key);
+    return result;
+}
+
+int PASER_sign_suite::encryptECIES(lv_block in, lv_block *out, EVP_PKEY *key, X509 *cert) {
+    u_int8_t aad[PASER_ECIES_AAD_LEN];
+    if (getAad(cert, aad) != 1) {
+        return 0;
+    }
+
+    // ECIES: ephemeralLen | ephemeral public key (DER) | IV | tag | ciphertext
+    EVP_PKEY *ephemeral = NULL;
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(key, NULL);
+    if (ctx == NULL || EVP_PKEY_keygen_init(ctx) != 1 || EVP_PKEY_keygen(ctx, &ephemeral) != 1) {
+        EVP_PKEY_CTX_free(ctx);
+        return 0;
+    }
+    EVP_PKEY_CTX_free(ctx);
+    u_int8_t *ephemeral_DER = NULL;
+    int ephemeral_len = i2d_PUBKEY(ephemeral, &ephemeral_DER);
+    u_int8_t aes_key[PASER_ECIES_KEY_LEN];
+    if (ephemeral_len <= 0 || deriveKey(ephemeral, key, ephemeral_DER, ephemeral_len, aes_key) != 1) {
+        OPENSSL_free(ephemeral_DER);
+        EVP_PKEY_free(ephemeral);
+        return 0;
+    }
+    EVP_PKEY_free(ephemeral);
+
+    u_int32_t header_len = ephemeral_len;
+    u_int32_t len = sizeof(header_len) + ephemeral_len + PASER_ECIES_IV_LEN + PASER_ECIES_TAG_LEN + in.len;
+    u_int8_t *buf = (u_int8_t *) malloc(len);
+    u_int8_t *p = buf;
+    memcpy(p, &header_len, sizeof(header_len));
+    p += sizeof(header_len);
+    memcpy(p, ephemeral_DER, ephemeral_len);
+    p += ephemeral_len;
+    OPENSSL_free(ephemeral_DER);
+    u_int8_t *iv = p;
+    u_int8_t *tag = iv + PASER_ECIES_IV_LEN;
+    u_int8_t *ciphertext = tag + PASER_ECIES_TAG_LEN;
+
+    int ok = RAND_bytes(iv, PASER_ECIES_IV_LEN) == 1;
+    EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
+    int out_len = 0, final_len = 0;
+    ok = ok && EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_gcm(), NULL, aes_key, iv) == 1;
+    ok = ok && EVP_EncryptUpdate(cipher_ctx, NULL, &out_len, aad, PASER_ECIES_AAD_LEN) == 1;
+    ok = ok && EVP_EncryptUpdate(cipher_ctx, ciphertext, &out_len, in.buf, in.len) == 1;
+    ok = ok && EVP_EncryptFinal_ex(cipher_ctx, ciphertext + out_len, &final_len) == 1;
+    ok = ok && EVP_CIPHER_CTX_ctrl(cipher_ctx, EVP_CTRL_GCM_GET_TAG, PASER_ECIES_TAG_LEN, tag) == 1;
+    EVP_CIPHER_CTX_free(cipher_ctx);
+    OPENSSL_cleanse(aes_key, sizeof(aes_key));
+    if (!ok) {
+        free(buf);
+        return 0;
+    }
+    out->buf = buf;
+    out->len = len;
+    return 1;
+}
+
+int PASER_sign_suite::decrypt(lv_block in, lv_block *out, EVP_PKEY *key, X509 *cert) {
+    out->buf = NULL;
+    out->len = 0;
+    if (key == NULL || cert == NULL || in.buf == NULL) {
+        return 0;
+    }
+    if (EVP_PKEY_id(key) == EVP_PKEY_RSA) {
+        RSA *rsa = EVP_PKEY_get1_RSA(key);
+        u_int8_t *buf = (u_int8_t *) malloc(RSA_size(rsa));
+        int i = RSA_private_decrypt(in.len, in.buf, buf, rsa, RSA_PKCS1_PADDING);
+        RSA_free(rsa);
+        if (i < 0) {
+            free(buf);
+            return 0;
+        }
+        out->buf = (u_int8_t *) malloc(i);
+        memcpy(out->buf, buf, i);
+        out->len = i;
+        free(buf);
+        return 1;
+    }
+    if (EVP_PKEY_id(key) != EVP_PKEY_EC) {
+        return 0;
+    }
+
+    u_int8_t aad[PASER_ECIES_AAD_LEN];
+    if (getAad(cert, aad) != 1) {
+        return 0;
+    }
+    u_int32_t ephemeral_len;
+    u_int32_t min_len = sizeof(ephemeral_len) + PASER_ECIES_IV_LEN + PASER_ECIES_TAG_LEN;
+    if (in.len < 0 || (u_int32_t) in.len < min_len) {
+        return 0;
+    }
+    memcpy(&ephemeral_len, in.buf, sizeof(ephemeral_len));
+    if (ephemeral_len > (u_int32_t) in.len - min_len) {
+        return 0;
+    }
+    const u_int8_t *ephemeral_DER = in.buf + sizeof(ephemeral_len);
+    const u_int8_t *p = ephemeral_DER;
+    EVP_PKEY *ephemeral = d2i_PUBKEY(NULL, &p, ephemeral_len);
+    if (ephemeral == NULL) {
+        return 0;
+    }
+    u_int8_t aes_key[PASER_ECIES_KEY_LEN];
+    int ok = EVP_PKEY_id(ephemeral) == EVP_PKEY_EC
+            && deriveKey(key, ephemeral, ephemeral_DER, ephemeral_len, aes_key) == 1;
+    EVP_PKEY_free(ephemeral);
+    if (!ok) {
+        return 0;
+    }
+
+    u_int8_t *iv = in.buf + sizeof(ephemeral_len) + ephemeral_len;
+    u_int8_t *tag = iv + PASER_ECIES_IV_LEN;
+    u_int8_t *ciphertext = tag + PASER_ECIES_TAG_LEN;
+    int ciphertext_len = in.len - (ciphertext - in.buf);
+    u_int8_t *buf = (u_int8_t *) malloc(ciphertext_len > 0 ? ciphertext_len : 1);
+
+    EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
+    int out_len = 0, final_len = 0;
+    ok = EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_gcm(), NULL, aes_key, iv) == 1;
+    ok = ok && EVP_DecryptUpdate(cipher_ctx, NULL, &out_len, aad, PASER_ECIES_AAD_LEN) == 1;
+    ok = ok && EVP_DecryptUpdate(cipher_ctx, buf, &out_len, ciphertext, ciphertext_len) == 1;
+    ok = ok && EVP_CIPHER_CTX_ctrl(cipher_ctx, EVP_CTRL_GCM_SET_TAG, PASER_ECIES_TAG_LEN, tag) == 1;
+    // fails if the tag does not match
+    ok = ok && EVP_DecryptFinal_ex(cipher_ctx, buf + out_len, &final_len) > 0;
+    EVP_CIPHER_CTX_free(cipher_ctx);
+    OPENSSL_cleanse(aes_key, sizeof(aes_key));
+    if (!ok) {
+        free(buf);
+        return 0;
+    }
+    out->buf = buf;
+    out->len = out_len + final_len;
+    return 1;
+}
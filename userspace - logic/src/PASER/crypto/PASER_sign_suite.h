@@ -0,0 +1,168 @@
+/**
+ *\class  		PASER_sign_suite
+ *@brief       	Class implements the signature suites of PASER control messages and the matching key transport.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_sign_suite;
+
+#ifndef PASER_SIGN_SUITE_H_
+#define PASER_SIGN_SUITE_H_
+
+#include "../config/PASER_defs.h"
+#include "../packet_structure/PASER_MSG.h"
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+/**
+ * Signature suites of PASER control messages. The signature is
+ * transmitted as lv_block, so its length depends on the suite:
+ * <ul>
+ * <li>PASER_SIGN_SUITE_RSA - RSA PKCS #1 v1.5 with SHA-1 (size of the modulus)</li>
+ * <li>PASER_SIGN_SUITE_ECDSA_P256 - ECDSA over P-256 with SHA-256 (DER, at most 72 bytes)</li>
+ * <li>PASER_SIGN_SUITE_ED25519 - Ed25519 (64 bytes, OpenSSL 1.1.1 or later)</li>
+ * </ul>
+ * A signature is only accepted if the key of the signer belongs to the
+ * expected suite.
+ * The GTK is encrypted with RSA PKCS #1 v1.5 for RSA certificates and with
+ * ECIES for EC certificates: ephemeral ECDH, HKDF-SHA256 and AES-256-GCM
+ * with the SHA-256 fingerprint of the recipient certificate as additional
+ * authenticated data. ECIES needs OpenSSL 1.1.0 or later.
+ * Ed25519 keys can't encrypt, so a node with an Ed25519 certificate can't
+ * receive a GTK from the KDC.
+ */
+class PASER_sign_suite {
+public:
+    /**
+     * Get the name of the suite as used in the configuration file.
+     */
+    static const char *getName(int suite);
+
+    /**
+     * Get the suite by the name used in the configuration file.
+     *
+     *@return suite or -1 if the name is unknown
+     */
+    static int getSuite(const char *name);
+
+    /**
+     * Check whether the key belongs to the suite.
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int checkKey(EVP_PKEY *key, int suite);
+
+    /**
+     * Sign the fields of a packet.
+     *
+     *@param suite signature suite of the key
+     *@param key private key
+     *@param packet pointer to the packet
+     *@param sign lv_block which will contain the allocated signature
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int sign(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block *sign);
+
+    /**
+     * Sign a char array.
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int sign(int suite, EVP_PKEY *key, lv_block data, lv_block *sign);
+
+    /**
+     * Check the signature over the fields of a packet.
+     *
+     *@param suite expected signature suite of the signer
+     *@param key public key of the signer
+     *@param packet pointer to the packet
+     *@param sign signature
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int verify(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block sign);
+
+    /**
+     * Check the signature over a char array.
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int verify(int suite, EVP_PKEY *key, lv_block data, lv_block sign);
+
+    /**
+     * Encrypt the char array with the public key of a certificate.
+     *
+     *@param in char array that is to be encrypted
+     *@param out pointer to lv_block which will contain the allocated encrypted array
+     *@param cert certificate of the receiver (RSA or EC key)
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int encrypt(lv_block in, lv_block *out, X509 *cert);
+
+    /**
+     * Decrypt the char array with a private key.
+     *
+     *@param in encrypted char array
+     *@param out pointer to lv_block which will contain the allocated decrypted array
+     *@param key private key of the receiver (RSA or EC)
+     *@param cert certificate of the receiver
+     *
+     *@return 1 on successful or 0 on error
+     */
+    static int decrypt(lv_block in, lv_block *out, EVP_PKEY *key, X509 *cert);
+
+private:
+    /**
+     * Get the message digest of the suite or NULL if the suite signs the
+     * complete message (Ed25519).
+     */
+    static const EVP_MD *getDigest(int suite);
+
+    /**
+     * Sign the fields of the packet or, if packet is NULL, the data.
+     */
+    static int signFields(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block data, lv_block *sign);
+
+    /**
+     * Check the signature over the fields of the packet or, if packet is NULL, over the data.
+     */
+    static int verifyFields(int suite, EVP_PKEY *key, PASER_MSG *packet, lv_block data, lv_block sign);
+
+    /**
+     * Encrypt the char array with ECIES to the EC key of the certificate.
+     */
+    static int encryptECIES(lv_block in, lv_block *out, EVP_PKEY *key, X509 *cert);
+
+    /**
+     * Derive the AES-256-GCM key of ECIES from the ECDH secret with HKDF.
+     * The ephemeral public key is the salt.
+     */
+    static int deriveKey(EVP_PKEY *own, EVP_PKEY *peer, const u_int8_t *ephemeral, int ephemeral_len, u_int8_t *key);
+
+    /**
+     * Get the additional authenticated data of ECIES: the SHA-256
+     * fingerprint of the recipient certificate.
+     */
+    static int getAad(X509 *cert, u_int8_t *aad);
+};
+
+#endif /* PASER_SIGN_SUITE_H_ */
@@ -0,0 +1,259 @@
+/**
+ *\class  		PASER_verify_pool
+ *@brief       	Class verifies the signatures of incoming PASER messages on worker threads.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_verify_pool.h"
+
+#include "../packet_structure/PASER_UB_RREQ.h"
+#include "../packet_structure/PASER_UU_RREP.h"
+#include "../packet_structure/PASER_B_ROOT.h"
+#include "../packet_structure/PASER_RESET.h"
+
+#include <boost/bind.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+PASER_verify_job::PASER_verify_job(PASER_MSG *msg, u_int32_t ifIndex, struct in_addr source, PASER_crypto_sign *crypto_sign) {
+    this->msg = msg;
+    this->ifIndex = ifIndex;
+    this->source = source.s_addr;
+    certs = new PASER_cert_context(crypto_sign);
+    checkKDC = false;
+    kdcResult = -1;
+    result = 0;
+    submitted.tv_sec = 0;
+    submitted.tv_usec = 0;
+}
+
+PASER_verify_job::~PASER_verify_job() {
+    // the certificates refer to the buffers of the message
+    delete certs;
+    if (msg) {
+        delete msg;
+    }
+}
+
+PASER_verify_pool::PASER_verify_pool(PASER_global *paser_global) {
+    pGlobal = paser_global;
+    crypto_sign = pGlobal->getCrypto_sign();
+    stopping = false;
+    pending = 0;
+    maxPending = PASER_verify_queue_len;
+    eventFD = -1;
+
+    if (PASER_verify_threads <= 0) {
+        return;
+    }
+    eventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFD < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "eventfd() failed. Verify signatures on the scheduler thread.\nError: (%d)%s\n", errno, strerror(errno));
+        return;
+    }
+    for (int i = 0; i < PASER_verify_threads; i++) {
+        workers.create_thread(boost::bind(&PASER_verify_pool::worker, this));
+    }
+}
+
+PASER_verify_pool::~PASER_verify_pool() {
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    workers.join_all();
+
+    // the jobs of all sources contain all jobs which are not yet verified
+    for (std::map<in_addr_t, std::deque<PASER_verify_job *> >::iterator it = sources.begin(); it != sources.end(); it++) {
+        for (std::deque<PASER_verify_job *>::iterator job = it->second.begin(); job != it->second.end(); job++) {
+            delete *job;
+        }
+    }
+    for (std::list<PASER_verify_job *>::iterator job = done.begin(); job != done.end(); job++) {
+        delete *job;
+    }
+    if (eventFD >= 0) {
+        close(eventFD);
+    }
+}
+
+bool PASER_verify_pool::isAsync() {
+    return eventFD >= 0;
+}
+
+int PASER_verify_pool::getEventFD() {
+    return eventFD;
+}
+
+int PASER_verify_pool::submit(PASER_verify_job *job) {
+    pGlobal->getPaserStatistic()->addVerifyQueueDepth(pending);
+    if (pending >= maxPending) {
+        pGlobal->getPaserStatistic()->incVerifyDrops();
+        return 0;
+    }
+    gettimeofday(&job->submitted, NULL);
+
+    boost::mutex::scoped_lock lock(mutex);
+    pending++;
+    std::deque<PASER_verify_job *> &sourceJobs = sources[job->source];
+    sourceJobs.push_back(job);
+    // wait for the previous jobs of the node
+    if (sourceJobs.size() == 1) {
+        ready.push_back(job);
+        jobReady.notify_one();
+    }
+    return 1;
+}
+
+int PASER_verify_pool::submitBatch(std::list<PASER_verify_job *> *jobs) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    int queued = 0;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        while (!jobs->empty()) {
+            pGlobal->getPaserStatistic()->addVerifyQueueDepth(pending);
+            if (pending >= maxPending) {
+                break;
+            }
+            PASER_verify_job *job = jobs->front();
+            jobs->pop_front();
+            job->submitted = now;
+            pending++;
+            queued++;
+            std::deque<PASER_verify_job *> &sourceJobs = sources[job->source];
+            sourceJobs.push_back(job);
+            // wait for the previous jobs of the node
+            if (sourceJobs.size() == 1) {
+                ready.push_back(job);
+            }
+        }
+    }
+    for (u_int32_t i = 0; i < jobs->size(); i++) {
+        pGlobal->getPaserStatistic()->incVerifyDrops();
+    }
+    if (queued > 1) {
+        jobReady.notify_all();
+    } else if (queued == 1) {
+        jobReady.notify_one();
+    }
+    return queued;
+}
+
+void PASER_verify_pool::takeResults(std::list<PASER_verify_job *> *results) {
+    u_int64_t count;
+    if (read(eventFD, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Cann't read eventfd.\nError: (%d)%s\n", errno, strerror(errno));
+    }
+
+    std::list<PASER_verify_job *> verified;
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        verified.swap(done);
+        pending -= verified.size();
+    }
+
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    for (std::list<PASER_verify_job *>::iterator it = verified.begin(); it != verified.end(); it++) {
+        pGlobal->getPaserStatistic()->addVerifyLatency(
+                (now.tv_sec - (*it)->submitted.tv_sec) * 1000000 + (now.tv_usec - (*it)->submitted.tv_usec));
+    }
+    results->splice(results->end(), verified);
+}
+
+void PASER_verify_pool::verify(PASER_verify_job *job) {
+    switch (job->msg->type) {
+    case 0x00: {
+        PASER_UB_RREQ *ubrreq_msg = dynamic_cast<PASER_UB_RREQ *>(job->msg);
+        job->result = crypto_sign->checkSignUBRREQ(ubrreq_msg, job->certs->getCert(ubrreq_msg->certForw));
+        // the certificate of the querying node is checked after the signature
+        if (job->result == 1 && ubrreq_msg->GFlag && job->certs->getCert(ubrreq_msg->cert) != NULL) {
+            job->certs->checkCert(ubrreq_msg->cert);
+        }
+        break;
+    }
+    case 0x01: {
+        PASER_UU_RREP *uurrep_msg = dynamic_cast<PASER_UU_RREP *>(job->msg);
+        if (job->checkKDC) {
+            job->kdcResult = crypto_sign->checkSignKDC(uurrep_msg->kdc_data);
+            if (job->kdcResult != 1) {
+                job->result = 0;
+                break;
+            }
+        }
+        job->result = crypto_sign->checkSignUURREP(uurrep_msg, job->certs->getCert(uurrep_msg->certForw));
+        break;
+    }
+    case 0x07:
+        job->result = crypto_sign->checkSignB_ROOT(dynamic_cast<PASER_B_ROOT *>(job->msg));
+        break;
+    case 0x08:
+        job->result = crypto_sign->checkSignRESET(dynamic_cast<PASER_RESET *>(job->msg));
+        break;
+    default:
+        job->result = 0;
+        break;
+    }
+}
+
+void PASER_verify_pool::worker() {
+    while (1) {
+        PASER_verify_job *job;
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            while (ready.empty() && !stopping) {
+                jobReady.wait(lock);
+            }
+            if (stopping) {
+                return;
+            }
+            job = ready.front();
+            ready.pop_front();
+        }
+
+        verify(job);
+
+        bool signal;
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            // the scheduler takes all verified jobs with one wakeup
+            signal = done.empty();
+            done.push_back(job);
+            // release the next job of the node
+            std::map<in_addr_t, std::deque<PASER_verify_job *> >::iterator it = sources.find(job->source);
+            it->second.pop_front();
+            if (it->second.empty()) {
+                sources.erase(it);
+            } else {
+                ready.push_back(it->second.front());
+                jobReady.notify_one();
+            }
+        }
+        u_int64_t one = 1;
+        if (signal && write(eventFD, &one, sizeof(one)) < 0) {
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Cann't signal eventfd.\nError: (%d)%s\n", errno, strerror(errno));
+        }
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ *\class  		PASER_verify_pool
+ *@brief       	Class verifies the signatures of incoming PASER messages on worker threads.
+ *@ingroup		Cryptography
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_verify_pool;
+struct PASER_verify_job;
+
+#ifndef PASER_VERIFY_POOL_H_
+#define PASER_VERIFY_POOL_H_
+
+#include "../config/PASER_defs.h"
+#include "../config/PASER_global.h"
+#include "../packet_structure/PASER_MSG.h"
+#include "PASER_crypto_sign.h"
+#include "PASER_cert_context.h"
+
+#include <boost/thread.hpp>
+
+#include <deque>
+#include <list>
+#include <map>
+
+/**
+ * Signature verification of one incoming PASER message.
+ */
+struct PASER_verify_job {
+    PASER_MSG *msg;             ///< Message to verify. Deleted with the job if not NULL
+    u_int32_t ifIndex;          ///< Interface on which the message was received
+    in_addr_t source;           ///< Signing node. The jobs of one node are returned in the order of submission
+    PASER_cert_context *certs;  ///< Decoded certificates of the message. Deleted with the job
+    bool checkKDC;              ///< Check the KDC block of the message (UU-RREP only)
+    int kdcResult;              ///< Result of the KDC block check (1 - valid, 0 - invalid, -1 - not checked)
+    int result;                 ///< Result of the signature check (1 - valid, 0 - invalid)
+    struct timeval submitted;   ///< Time of the submission
+
+    PASER_verify_job(PASER_MSG *msg, u_int32_t ifIndex, struct in_addr source, PASER_crypto_sign *crypto_sign);
+    ~PASER_verify_job();
+};
+
+/**
+ * Pool of worker threads which verify the signatures of incoming
+ * UB-RREQ, UU-RREP, B_ROOT and RESET messages, so that a flood of
+ * signed messages does not block the scheduler.
+ * The scheduler submits a job and continues with the message when the
+ * job is returned by takeResults(). Jobs of the same signing node are
+ * verified one after another and returned in the order of submission.
+ */
+class PASER_verify_pool {
+private:
+    PASER_global *pGlobal;
+    PASER_crypto_sign *crypto_sign;
+
+    int eventFD;                        ///< eventfd which is signaled when a job is verified or -1
+    boost::thread_group workers;
+    bool stopping;                      ///< Set by the destructor to stop the workers
+
+    boost::mutex mutex;                 ///< Protects all job queues
+    boost::condition_variable jobReady;
+    std::deque<PASER_verify_job *> ready;   ///< Jobs which can be verified now
+    std::list<PASER_verify_job *> done;     ///< Verified jobs which are not yet taken by the scheduler
+    std::map<in_addr_t, std::deque<PASER_verify_job *> > sources; ///< Jobs by signing node. The first one is ready or in verification
+
+    u_int32_t pending;                  ///< Number of submitted jobs which are not yet taken by the scheduler
+    u_int32_t maxPending;               ///< Maximum number of pending jobs
+
+public:
+    /**
+     * Start PASER_verify_threads worker threads. No thread is started
+     * if PASER_verify_threads is 0 or the eventfd can't be created.
+     */
+    PASER_verify_pool(PASER_global *paser_global);
+    ~PASER_verify_pool();
+
+    /**
+     * Check whether the signatures are verified on worker threads.
+     * Otherwise the caller must verify the message with verify().
+     */
+    bool isAsync();
+
+    /**
+     * Get the eventfd which becomes readable when verified jobs can be taken.
+     *
+     *@return file descriptor or -1
+     */
+    int getEventFD();
+
+    /**
+     * Queue a job for verification.
+     *
+     *@return 1 on success or 0 if the queue is full. The job is not taken in this case.
+     */
+    int submit(PASER_verify_job *job);
+
+    /**
+     * Queue all jobs of a receive batch for verification with one lock
+     * of the queues and one wakeup of the workers.
+     *
+     *@param jobs jobs in the order of reception. Jobs which are queued are
+     *            removed from the list, the jobs which remain could not be
+     *            queued because the queue is full.
+     *
+     *@return number of queued jobs
+     */
+    int submitBatch(std::list<PASER_verify_job *> *jobs);
+
+    /**
+     * Take all verified jobs. The caller must delete the jobs.
+     * The eventfd is signaled once for all jobs which are verified
+     * until the next call.
+     *
+     *@param results list to which the jobs are appended in the order of verification
+     */
+    void takeResults(std::list<PASER_verify_job *> *results);
+
+    /**
+     * Verify the job on the calling thread and set its results.
+     */
+    void verify(PASER_verify_job *job);
+
+private:
+    /**
+     * Main function of the worker threads.
+     */
+    void worker();
+};
+
+#endif /* PASER_VERIFY_POOL_H_ */
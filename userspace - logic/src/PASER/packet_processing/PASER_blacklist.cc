@@ -23,7 +23,7 @@
 #include "PASER_blacklist.h"
 
 bool PASER_blacklist::setRerrTime(struct in_addr addr, struct timeval time){
-    std::map<Uint128, struct timeval>::iterator it = rerr_list.find(addr.s_addr);
+    PASER_addr_map<struct timeval>::iterator it = rerr_list.find(addr.s_addr);
     if (it != rerr_list.end())
     {
         struct timeval last = it->second;
@@ -55,7 +55,7 @@ void PASER_blacklist::clearRerrList(){
 std::string PASER_blacklist::detailedInfo(){
     std::stringstream out;
     out << "Black list:\n";
-    for (std::map<Uint128, struct timeval>::iterator it = rerr_list.begin(); it != rerr_list.end(); it++) {
+    for (PASER_addr_map<struct timeval>::iterator it = rerr_list.begin(); it != rerr_list.end(); it++) {
         timeval temp = it->second;
         in_addr ip;
         ip.s_addr = it->first;
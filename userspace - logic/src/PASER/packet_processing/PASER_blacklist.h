@@ -26,8 +26,8 @@ class PASER_blacklist;
 #define PASER_BLACKLIST_H_
 
 #include "../config/PASER_defs.h"
+#include "../tables/PASER_addr_map.h"
 
-#include <map>
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
@@ -42,7 +42,7 @@ private:
      * Key   - IP Address
      * Value - Time when a RERR message was send
      */
-    std::map<Uint128, struct timeval> rerr_list;
+    PASER_addr_map<struct timeval> rerr_list;
 public:
     /**
      * Add or edit an entry in container
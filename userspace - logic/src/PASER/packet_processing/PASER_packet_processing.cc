@@ -31,10 +31,12 @@
 #include "../packet_structure/PASER_TU_RREP_ACK.h"
 #include "../packet_structure/PASER_TU_RREQ.h"
 #include "../packet_structure/PASER_UB_RREQ.h"
+#include "../packet_structure/PASER_UB_RREQ_view.h"
 #include "../packet_structure/PASER_UU_RREP.h"
 #include "../packet_structure/PASER_GTKREQ.h"
 #include "../packet_structure/PASER_GTKREP.h"
 #include "../packet_structure/PASER_GTKRESET.h"
+#include "../crypto/PASER_cert_context.h"
 
 #include <math.h>
 #define DEG_TO_RAD  0.0174532925199432958
@@ -57,6 +59,8 @@ PASER_packet_processing::PASER_packet_processing(PASER_global *paser_global, PAS
     root = NULL;
     crypto_sign = NULL;
     crypto_hash = NULL;
+    verify_pool = NULL;
+    inReceiveBatch = false;
     netDevice = NULL;
     packet_sender = NULL;
 }
@@ -73,6 +77,7 @@ void PASER_packet_processing::init() {
     root = pGlobal->getRoot();
     crypto_sign = pGlobal->getCrypto_sign();
     crypto_hash = pGlobal->getCrypto_hash();
+    verify_pool = pGlobal->getVerify_pool();
     netDevice = paser_configuration->getNetDevice();
     packet_sender = pGlobal->getPacketSender();
 }
@@ -82,6 +87,22 @@ PASER_packet_processing::~PASER_packet_processing() {
 }
 
 void PASER_packet_processing::handleLowerMsg(uint8_t *s, int length, u_int32_t ifIndex) {
+    handleLowerMsgInPlace(s, length, ifIndex);
+    free(s);
+}
+
+void PASER_packet_processing::handleLowerMsgs(lv_block *packets, int n, u_int32_t ifIndex) {
+    inReceiveBatch = true;
+    for (int i = 0; i < n; i++) {
+        if (packets[i].len != -1) {
+            handleLowerMsgInPlace(packets[i].buf, packets[i].len, ifIndex);
+        }
+    }
+    inReceiveBatch = false;
+    checkSignatureBatch();
+}
+
+void PASER_packet_processing::handleLowerMsgInPlace(uint8_t *s, int length, u_int32_t ifIndex) {
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Incoming Packet. Try to cast it into PASER packet.\n");
 #ifdef TIMEMEASUREMENT
     struct timeval a;
@@ -91,7 +112,6 @@ void PASER_packet_processing::handleLowerMsg(uint8_t *s, int length, u_int32_t i
     PASER_MSG *msg = castToPaserPacket(s, length);
 
     if (!msg) {
-        free(s);
         return;
     }
     switch (msg->type) {
@@ -177,11 +197,9 @@ void PASER_packet_processing::handleLowerMsg(uint8_t *s, int length, u_int32_t i
         break;
     default:
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "false PASER Packet type\n");
-        free(s);
         delete msg;
         return;
     }
-    free(s);
 }
 
 PASER_MSG *PASER_packet_processing::castToPaserPacket(uint8_t *s, int length) {
@@ -192,7 +210,7 @@ PASER_MSG *PASER_packet_processing::castToPaserPacket(uint8_t *s, int length) {
     switch (type) {
     case 0x00:
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Try to generate UB-RREQ\n");
-        return PASER_UB_RREQ::create(s, length);
+        return createUBRREQ(s, length);
         break;
     case 0x01:
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Try to generate UU-RREP\n");
@@ -244,27 +262,33 @@ PASER_MSG *PASER_packet_processing::castToPaserPacket(uint8_t *s, int length) {
 }
 
 int PASER_packet_processing::check_seq_nr(PASER_MSG *paser_msg, struct in_addr forwarding) {
+    u_int32_t seqForw = 0;
+    if (paser_msg->type == UB_RREQ) {
+        PASER_UB_RREQ *ubrreq_msg = dynamic_cast<PASER_UB_RREQ *>(paser_msg);
+        seqForw = ubrreq_msg->seqForw;
+    } else if (paser_msg->type == TU_RREQ) {
+        PASER_TU_RREQ *turreq_msg = dynamic_cast<PASER_TU_RREQ *>(paser_msg);
+        seqForw = turreq_msg->seqForw;
+    }
+    return check_seq_nr(paser_msg->type, paser_msg->srcAddress_var, paser_msg->destAddress_var, paser_msg->seq, seqForw,
+            forwarding);
+}
+
+int PASER_packet_processing::check_seq_nr(u_int8_t type, struct in_addr src, struct in_addr dest, u_int32_t seq,
+        u_int32_t seqForw, struct in_addr forwarding) {
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "Check sequence number...");
     PASER_routing_entry *srcNode = NULL;
     struct in_addr destAddr;
     // beim UB_RREQ und TU_RREQ Paketen wird nicht nur die Sequenznummer des Absenders, sondern auch die
     // Sequenznummer des Knotens ueberprueft, das das Paket weitergeleitet hat.
-    if (paser_msg->type == UB_RREQ || paser_msg->type == TU_RREQ) {
-        u_int32_t seqForw = 0;
-        if (paser_msg->type == UB_RREQ) {
-            PASER_UB_RREQ *ubrreq_msg = dynamic_cast<PASER_UB_RREQ *>(paser_msg);
-            seqForw = ubrreq_msg->seqForw;
-        } else {
-            PASER_TU_RREQ *turreq_msg = dynamic_cast<PASER_TU_RREQ *>(paser_msg);
-            seqForw = turreq_msg->seqForw;
-        }
-        srcNode = routing_table->findDest(paser_msg->srcAddress_var);
-        destAddr.s_addr = paser_msg->destAddress_var.s_addr;
+    if (type == UB_RREQ || type == TU_RREQ) {
+        srcNode = routing_table->findDest(src);
+        destAddr.s_addr = dest.s_addr;
 
         PASER_routing_entry *forwardingNode = routing_table->findDest(forwarding);
         if (srcNode && paser_configuration->getIsGW()
                 && (destAddr.s_addr == 0xFFFFFFFF || paser_configuration->isAddInMyLocalAddress(destAddr)) && forwardingNode) {
-            if ((paser_msg->seq == srcNode->seqnum || pGlobal->isSeqNew(srcNode->seqnum, paser_msg->seq))
+            if ((seq == srcNode->seqnum || pGlobal->isSeqNew(srcNode->seqnum, seq))
                     && pGlobal->isSeqNew(forwardingNode->seqnum, seqForw)) {
                 PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
                 return 1;
@@ -274,7 +298,7 @@ int PASER_packet_processing::check_seq_nr(PASER_MSG *paser_msg, struct in_addr f
             }
         }
         if (srcNode && paser_configuration->isAddInMyLocalAddress(destAddr) && forwardingNode) {
-            if ((paser_msg->seq == srcNode->seqnum || pGlobal->isSeqNew(srcNode->seqnum, paser_msg->seq))
+            if ((seq == srcNode->seqnum || pGlobal->isSeqNew(srcNode->seqnum, seq))
                     && pGlobal->isSeqNew(forwardingNode->seqnum, seqForw)) {
                 PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
                 return 1;
@@ -284,7 +308,7 @@ int PASER_packet_processing::check_seq_nr(PASER_MSG *paser_msg, struct in_addr f
             }
         }
         if (srcNode && !paser_configuration->isAddInMyLocalAddress(destAddr) && forwardingNode) {
-            if (pGlobal->isSeqNew(srcNode->seqnum, paser_msg->seq) && pGlobal->isSeqNew(forwardingNode->seqnum, seqForw)) {
+            if (pGlobal->isSeqNew(srcNode->seqnum, seq) && pGlobal->isSeqNew(forwardingNode->seqnum, seqForw)) {
                 PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
                 return 1;
             } else {
@@ -302,7 +326,7 @@ int PASER_packet_processing::check_seq_nr(PASER_MSG *paser_msg, struct in_addr f
             }
         }
         if (srcNode && !forwardingNode) {
-            if (pGlobal->isSeqNew(srcNode->seqnum, paser_msg->seq) || paser_msg->seq == srcNode->seqnum) {
+            if (pGlobal->isSeqNew(srcNode->seqnum, seq) || seq == srcNode->seqnum) {
                 PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
                 return 1;
             } else {
@@ -312,23 +336,23 @@ int PASER_packet_processing::check_seq_nr(PASER_MSG *paser_msg, struct in_addr f
         }
         PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
         return 1;
-    } else if (paser_msg->type == UU_RREP || paser_msg->type == TU_RREP) {
-        srcNode = routing_table->findDest(paser_msg->destAddress_var);
+    } else if (type == UU_RREP || type == TU_RREP) {
+        srcNode = routing_table->findDest(dest);
         if (srcNode) {
-            if (pGlobal->isSeqNew(srcNode->seqnum, paser_msg->seq)) {
+            if (pGlobal->isSeqNew(srcNode->seqnum, seq)) {
                 PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
                 return 1;
             } else {
-                PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "FALSE. Old = %d, New = %d\n", srcNode->seqnum, paser_msg->seq);
+                PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "FALSE. Old = %d, New = %d\n", srcNode->seqnum, seq);
                 return 0;
             }
         }
         PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
         return 1;
-    } else if (paser_msg->type == TU_RREP_ACK || paser_msg->type == B_RERR || paser_msg->type == B_HELLO || paser_msg->type == B_ROOT) {
-        srcNode = routing_table->findDest(paser_msg->srcAddress_var);
+    } else if (type == TU_RREP_ACK || type == B_RERR || type == B_HELLO || type == B_ROOT) {
+        srcNode = routing_table->findDest(src);
         if (srcNode) {
-            if (pGlobal->isSeqNew(srcNode->seqnum, paser_msg->seq)) {
+            if (pGlobal->isSeqNew(srcNode->seqnum, seq)) {
                 PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
                 return 1;
             } else {
@@ -377,50 +401,87 @@ int PASER_packet_processing::checkRouteList(std::list<address_list> rList) {
     return 0;
 }
 
-void PASER_packet_processing::handleUBRREQ(PASER_MSG * msg, u_int32_t ifIndex) {
-    PASER_UB_RREQ *ubrreq_msg = dynamic_cast<PASER_UB_RREQ *>(msg);
+int PASER_packet_processing::checkRouteList(const PASER_UB_RREQ_view *view) {
+    PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "Check route list...");
+    PASER_wire_reader list = view->getAddressList();
+    struct in_addr addr;
+    lv_block ranges;
+    while (PASER_UB_RREQ_view::nextAddress(&list, &addr, &ranges)) {
+        if (paser_configuration->isAddInMyLocalAddress(addr)) {
+            PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "FALSE\n");
+            return 1;
+        }
+    }
+    PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
+    return 0;
+}
+
+PASER_MSG *PASER_packet_processing::createUBRREQ(uint8_t *s, int length) {
+    PASER_UB_RREQ_view view;
+    if (!view.parse(s, length)) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Wrong %s. Cann't create UB-RREQ.\n", view.error);
+        return NULL;
+    }
     if (!pGlobal->getWasRegistered()) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Not registered.\n");
-        delete ubrreq_msg;
-        return;
+        return NULL;
     }
-    PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_INFO, "Incoming Packet Info\n%s", ubrreq_msg->detailedInfo().c_str());
-
-    if (checkRouteList(ubrreq_msg->AddressRangeList)) {
-        delete ubrreq_msg;
-        return;
+    if (checkRouteList(&view)) {
+        return NULL;
     }
-    struct in_addr forwarding = ubrreq_msg->AddressRangeList.back().ipaddr;
     //Pruefe Sequenznummer des Pakets
-    if (!check_seq_nr((dynamic_cast<PASER_MSG *>(msg)), forwarding)) {
-        delete ubrreq_msg;
-        return;
+    if (!check_seq_nr(UB_RREQ, view.srcAddress_var, view.destAddress_var, view.seq, view.seqForw, view.forwarding)) {
+        return NULL;
     }
     //Pruefe GeoPosition des Absenders
-    if (!check_geo(ubrreq_msg->geoForwarding)) {
-        delete ubrreq_msg;
-        return;
+    if (!check_geo(view.geoForwarding)) {
+        return NULL;
     }
 
     //pruefe Timestamp
     struct timeval now;
     pGlobal->getPASERtimeofday(&now);
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Timestamp...");
-    if (now.tv_sec - ubrreq_msg->timestamp > PASER_time_diff || now.tv_sec - ubrreq_msg->timestamp < -PASER_time_diff) {
+    if (now.tv_sec - view.timestamp > PASER_time_diff || now.tv_sec - view.timestamp < -PASER_time_diff) {
         PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "FALSE\n");
-        delete ubrreq_msg;
-        return;
+        return NULL;
     }
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
 
+    return PASER_UB_RREQ::create(&view);
+}
+
+void PASER_packet_processing::handleUBRREQ(PASER_MSG * msg, u_int32_t ifIndex) {
+    PASER_UB_RREQ *ubrreq_msg = dynamic_cast<PASER_UB_RREQ *>(msg);
+    PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_INFO, "Incoming Packet Info\n%s", ubrreq_msg->detailedInfo().c_str());
+
+    // Route list, sequence number, geo position and timestamp are checked by createUBRREQ()
+    struct in_addr forwarding = ubrreq_msg->AddressRangeList.back().ipaddr;
+
     //Pruefe Signatur des Pakets
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature.\n");
-    if (!crypto_sign->checkSignUBRREQ(ubrreq_msg)) {
+    checkSignature(new PASER_verify_job(ubrreq_msg, ifIndex, forwarding, crypto_sign));
+}
+
+void PASER_packet_processing::handleVerifiedUBRREQ(PASER_MSG * msg, PASER_verify_job *job) {
+    PASER_UB_RREQ *ubrreq_msg = dynamic_cast<PASER_UB_RREQ *>(msg);
+    u_int32_t ifIndex = job->ifIndex;
+    PASER_cert_context &certs = *job->certs;
+    struct in_addr forwarding = ubrreq_msg->AddressRangeList.back().ipaddr;
+    struct timeval now;
+    pGlobal->getPASERtimeofday(&now);
+
+    if (job->result != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...FALSE\n");
         delete ubrreq_msg;
         return;
     }
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...OK\n");
+    // a message of the same node which was handled after the submission could have made this one outdated
+    if (!check_seq_nr(msg, forwarding)) {
+        delete ubrreq_msg;
+        return;
+    }
 
     //pruefe keyNr
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check GTK number...");
@@ -433,28 +494,26 @@ void PASER_packet_processing::handleUBRREQ(PASER_MSG * msg, u_int32_t ifIndex) {
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
 
     //aktualisiere NeighborTable
-    X509 *certNeigh = crypto_sign->extractCert(ubrreq_msg->certForw);
     neighbor_table->updateNeighborTableAndSetTableTimeout(forwarding, 0, ubrreq_msg->root, ubrreq_msg->initVector,
-            ubrreq_msg->geoForwarding, certNeigh, now, ifIndex);
+            ubrreq_msg->geoForwarding, certs.getCertRef(ubrreq_msg->certForw), now, ifIndex);
 
     //aktualisiere RoutingTable mit der Information ueber den Nachbar
     std::list<address_range> addList(ubrreq_msg->AddressRangeList.back().range);
-    X509 *certForw = crypto_sign->extractCert(ubrreq_msg->certForw);
-    routing_table->updateRoutingTableAndSetTableTimeout(addList, forwarding, ubrreq_msg->seqForw, certForw, forwarding, 0, ifIndex, now,
-            crypto_sign->isGwCert(certForw), false);
+    X509 *certForw = certs.getCert(ubrreq_msg->certForw);
+    routing_table->updateRoutingTableAndSetTableTimeout(addList, forwarding, ubrreq_msg->seqForw, certs.getCertRef(ubrreq_msg->certForw),
+            forwarding, 0, ifIndex, now, crypto_sign->isGwCert(certForw), false);
 
     //aktualisiere RoutingTable mit der Information des Absenders
     X509 *cert = NULL;
     if (ubrreq_msg->GFlag) {
-        cert = crypto_sign->extractCert(ubrreq_msg->cert);
-        if (cert != NULL && crypto_sign->checkOneCert(cert) == 0) {
-            X509_free(cert);
+        cert = certs.getCert(ubrreq_msg->cert);
+        if (cert != NULL && certs.checkCert(ubrreq_msg->cert) == 0) {
             delete ubrreq_msg;
             return;
         }
     }
     routing_table->updateRoutingTableAndSetTableTimeout(ubrreq_msg->AddressRangeList.front().range, ubrreq_msg->srcAddress_var,
-            ubrreq_msg->seq, cert, forwarding, ubrreq_msg->metricBetweenQueryingAndForw, ifIndex, now, crypto_sign->isGwCert(cert), false);
+            ubrreq_msg->seq, ubrreq_msg->GFlag ? certs.getCertRef(ubrreq_msg->cert) : NULL, forwarding, ubrreq_msg->metricBetweenQueryingAndForw, ifIndex, now, crypto_sign->isGwCert(cert), false);
 
     PASER_routing_entry *rEntry = routing_table->findDest(ubrreq_msg->srcAddress_var);
     PASER_neighbor_entry *nEntry = neighbor_table->findNeigh(rEntry->nxthop_addr);
@@ -560,7 +619,7 @@ else if (!paser_configuration->isAddInMyLocalAddress(ubrreq_msg->destAddress_var
         }
         else {
             PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "set old route invalid, generate and send UB-RREQ\n");
-            routeToDest->isValid = 0;
+            routing_table->setValid(routeToDest, 0);
             routeToDest->validTimer = NULL;
             PASER_neighbor_entry *nEntry = pGlobal->getNeighbor_table()->findNeigh(routeToDest->dest_addr);
             if (nEntry != NULL) {
@@ -640,6 +699,7 @@ void PASER_packet_processing::handleUURREP(PASER_MSG * msg, u_int32_t ifIndex) {
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
 
     // read KDC
+    bool checkKDC = false;
     if (uurrep_msg->GFlag && paser_configuration->isAddInMyLocalAddress(uurrep_msg->srcAddress_var)) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Nonce...");
         if (pGlobal->getLastGwSearchNonce() != uurrep_msg->kdc_data.nonce) {
@@ -650,7 +710,26 @@ void PASER_packet_processing::handleUURREP(PASER_MSG * msg, u_int32_t ifIndex) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "OK\n");
 
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check KDC Signature.\n");
-        if (crypto_sign->checkSignKDC(uurrep_msg->kdc_data) != 1) {
+        checkKDC = true;
+    }
+
+    PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature.\n");
+    PASER_verify_job *job = new PASER_verify_job(uurrep_msg, ifIndex, forwarding, crypto_sign);
+    job->checkKDC = checkKDC;
+    checkSignature(job);
+}
+
+void PASER_packet_processing::handleVerifiedUURREP(PASER_MSG * msg, PASER_verify_job *job) {
+    PASER_UU_RREP *uurrep_msg = dynamic_cast<PASER_UU_RREP *>(msg);
+    u_int32_t ifIndex = job->ifIndex;
+    PASER_cert_context &certs = *job->certs;
+    struct in_addr forwarding = uurrep_msg->AddressRangeList.back().ipaddr;
+    struct timeval now;
+    pGlobal->getPASERtimeofday(&now);
+
+    // read KDC
+    if (job->checkKDC) {
+        if (job->kdcResult != 1) {
             delete uurrep_msg;
             PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check KDC Signature...FALSE\n");
             return;
@@ -671,13 +750,17 @@ void PASER_packet_processing::handleUURREP(PASER_MSG * msg, u_int32_t ifIndex) {
         pGlobal->setKeyNr(uurrep_msg->kdc_data.key_nr);
     }
 
-    PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature.\n");
-    if (!crypto_sign->checkSignUURREP(uurrep_msg)) {
+    if (job->result != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...FALSE\n");
         delete uurrep_msg;
         return;
     }
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...OK\n");
+    // a message of the same node which was handled after the submission could have made this one outdated
+    if (!check_seq_nr(msg, forwarding)) {
+        delete uurrep_msg;
+        return;
+    }
 
     //pruefe keyNr
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check GTK number...");
@@ -689,15 +772,14 @@ void PASER_packet_processing::handleUURREP(PASER_MSG * msg, u_int32_t ifIndex) {
     }
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_PACKET_PROCESSING, "OK\n");
     //update Neighbor Table
-    X509 *certNeigh = crypto_sign->extractCert(uurrep_msg->certForw);
     neighbor_table->updateNeighborTableAndSetTableTimeout(forwarding, 1, uurrep_msg->root, uurrep_msg->initVector,
-            uurrep_msg->geoForwarding, certNeigh, now, ifIndex);
+            uurrep_msg->geoForwarding, certs.getCertRef(uurrep_msg->certForw), now, ifIndex);
 
     //update Routing Table with forwarding Node
     std::list<address_range> addList(uurrep_msg->AddressRangeList.back().range);
-    X509 *certForw = crypto_sign->extractCert(uurrep_msg->certForw);
+    X509 *certForw = certs.getCert(uurrep_msg->certForw);
     routing_table->updateRoutingTableAndSetTableTimeout(addList, forwarding,
-    /*uurrep_msg->seqForw,*/0, certForw, forwarding, 0, ifIndex, now, crypto_sign->isGwCert(certForw), true);
+    /*uurrep_msg->seqForw,*/0, certs.getCertRef(uurrep_msg->certForw), forwarding, 0, ifIndex, now, crypto_sign->isGwCert(certForw), true);
 
     //update Routing Table
 //    std::list<address_range> EmptyAddList( uurrep_msg->AddressRangeList.front().range );
@@ -899,17 +981,17 @@ void PASER_packet_processing::handleTURREQ(PASER_MSG * msg, u_int32_t ifIndex) {
 
     //update Routing Table
 //    std::list<address_range> EmptyAddList;
+    PASER_cert_context certs(crypto_sign);
     X509 *cert = NULL;
     if (turreq_msg->GFlag) {
-        cert = crypto_sign->extractCert(turreq_msg->cert);
-        if (cert != NULL && crypto_sign->checkOneCert(cert) == 0) {
-            X509_free(cert);
+        cert = certs.getCert(turreq_msg->cert);
+        if (cert != NULL && certs.checkCert(turreq_msg->cert) == 0) {
             delete turreq_msg;
             return;
         }
     }
     routing_table->updateRoutingTableAndSetTableTimeout(turreq_msg->AddressRangeList.front().range, turreq_msg->srcAddress_var,
-            turreq_msg->seq, cert, forwarding, turreq_msg->metricBetweenQueryingAndForw, ifIndex, now, crypto_sign->isGwCert(cert), true);
+            turreq_msg->seq, turreq_msg->GFlag ? certs.getCertRef(turreq_msg->cert) : NULL, forwarding, turreq_msg->metricBetweenQueryingAndForw, ifIndex, now, crypto_sign->isGwCert(cert), true);
 
     PASER_routing_entry *rEntry = routing_table->findDest(turreq_msg->srcAddress_var);
     PASER_neighbor_entry *nEntry = neighbor_table->findNeigh(rEntry->nxthop_addr);
@@ -932,12 +1014,10 @@ void PASER_packet_processing::handleTURREQ(PASER_MSG * msg, u_int32_t ifIndex) {
     if (paser_configuration->isAddInMyLocalAddress(turreq_msg->destAddress_var) || pGlobal->getPaser_configuration()->getIsGW()) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "I am a destination\n");
         if (turreq_msg->GFlag) {
-            cert = crypto_sign->extractCert(turreq_msg->cert);
             if (paser_configuration->getIsGW()) {
                 //sende anfrage an KDC
                 PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Forward request to KDC. Generate GTK Request.\n");
                 packet_sender->sendKDCRequest(turreq_msg->srcAddress_var, forwarding, turreq_msg->cert, turreq_msg->nonce);
-                X509_free(cert);
                 delete turreq_msg;
                 return;
             }
@@ -950,9 +1030,6 @@ void PASER_packet_processing::handleTURREQ(PASER_MSG * msg, u_int32_t ifIndex) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Generate and send TU-RREP.\n");
         PASER_TU_RREP *packet = packet_sender->send_tu_rrep(turreq_msg->srcAddress_var, forwarding, WlanAddrStruct/*myAddrStruct*/,
                 turreq_msg->GFlag, cert, tempKdcBlock);
-        if (turreq_msg->GFlag) {
-            X509_free(cert);
-        }
         delete packet;
     }
     // forwarding TURREQ
@@ -1283,8 +1360,8 @@ void PASER_packet_processing::handleTURREPACK(PASER_MSG * msg, u_int32_t ifIndex
         delete turrepack_msg;
         return;
     }
-    rEntry->nxthop_addr.s_addr = neighbor.s_addr;
-    rEntry->hopcnt = 1;
+    routing_table->setNextHop(rEntry, neighbor);
+    routing_table->setMetric(rEntry, 1);
 
     routing_table->updateRoutingTableTimeout(neighbor, turrepack_msg->seq, now);
     //update neighbor table
@@ -1415,7 +1492,7 @@ void PASER_packet_processing::handleRERR(PASER_MSG * msg, u_int32_t ifIndex) {
             delete validTimer;
             tempEntry->validTimer = NULL;
         }
-        tempEntry->isValid = 0;
+        routing_table->setValid(tempEntry, 0);
         if (temp.seq != 0) {
             tempEntry->seqnum = temp.seq;
         }
@@ -1554,12 +1631,23 @@ void PASER_packet_processing::handleB_ROOT(PASER_MSG * msg, u_int32_t ifIndex) {
 
     //Pruefe Signatur des Pakets
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature.\n");
-    if (!crypto_sign->checkSignB_ROOT(b_root_msg)) {
+    checkSignature(new PASER_verify_job(b_root_msg, ifIndex, querying, crypto_sign));
+}
+
+void PASER_packet_processing::handleVerifiedB_ROOT(PASER_MSG * msg, PASER_verify_job *job) {
+    PASER_B_ROOT *b_root_msg = dynamic_cast<PASER_B_ROOT *>(msg);
+    struct in_addr querying = b_root_msg->srcAddress_var;
+    if (job->result != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...FALSE\n");
         delete b_root_msg;
         return;
     }
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...OK\n");
+    // a message of the same node which was handled after the submission could have made this one outdated
+    if (!check_seq_nr(msg, querying)) {
+        delete b_root_msg;
+        return;
+    }
 
     //speichere neues ROOT und IV
     PASER_routing_entry *rEntry = routing_table->findDest(querying);
@@ -1632,13 +1720,25 @@ void PASER_packet_processing::handleB_RESET(PASER_MSG * msg, u_int32_t ifIndex)
 
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature.\n");
     //Pruefe Signatur des Schluesselsnummer
-    if (!crypto_sign->checkSignRESET(b_reset_msg)) {
+    checkSignature(new PASER_verify_job(b_reset_msg, ifIndex, b_reset_msg->srcAddress_var, crypto_sign));
+}
+
+void PASER_packet_processing::handleVerifiedB_RESET(PASER_MSG * msg, PASER_verify_job *job) {
+    PASER_RESET *b_reset_msg = dynamic_cast<PASER_RESET *>(msg);
+    if (job->result != 1) {
         PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...FALSE\n");
         delete b_reset_msg;
         return;
     }
     PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Check Signature...OK\n");
 
+    //another RESET could be processed during the verification
+    if (pGlobal->getKeyNr() >= b_reset_msg->keyNr) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "GTK number is actual. Do nothing.\n");
+        delete b_reset_msg;
+        return;
+    }
+
     pGlobal->setKeyNr(b_reset_msg->keyNr);
     pGlobal->resetPASER();
 
@@ -1686,6 +1786,70 @@ void PASER_packet_processing::handleB_RESET(PASER_MSG * msg, u_int32_t ifIndex)
     delete b_reset_msg;
 }
 
+void PASER_packet_processing::handleVerifiedMsgs() {
+    std::list<PASER_verify_job *> results;
+    verify_pool->takeResults(&results);
+    for (std::list<PASER_verify_job *>::iterator it = results.begin(); it != results.end(); it++) {
+        handleVerifiedMsg(*it);
+    }
+}
+
+void PASER_packet_processing::checkSignature(PASER_verify_job *job) {
+    // without worker threads the messages are handled in the order of reception
+    if (!verify_pool->isAsync()) {
+        verify_pool->verify(job);
+        handleVerifiedMsg(job);
+        return;
+    }
+    if (inReceiveBatch) {
+        batchJobs.push_back(job);
+        return;
+    }
+    if (!verify_pool->submit(job)) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Signature verification queue is full. Drop packet.\n");
+        delete job;
+    }
+}
+
+void PASER_packet_processing::checkSignatureBatch() {
+    if (batchJobs.empty()) {
+        return;
+    }
+    std::list<PASER_verify_job *> jobs;
+    jobs.swap(batchJobs);
+    verify_pool->submitBatch(&jobs);
+    if (!jobs.empty()) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_PACKET_PROCESSING, "Signature verification queue is full. Drop %u packets.\n", (unsigned int) jobs.size());
+        for (std::list<PASER_verify_job *>::iterator it = jobs.begin(); it != jobs.end(); it++) {
+            delete *it;
+        }
+    }
+}
+
+void PASER_packet_processing::handleVerifiedMsg(PASER_verify_job *job) {
+    // the handlers delete the message
+    PASER_MSG *msg = job->msg;
+    job->msg = NULL;
+    switch (msg->type) {
+    case 0:
+        handleVerifiedUBRREQ(msg, job);
+        break;
+    case 1:
+        handleVerifiedUURREP(msg, job);
+        break;
+    case 7:
+        handleVerifiedB_ROOT(msg, job);
+        break;
+    case 8:
+        handleVerifiedB_RESET(msg, job);
+        break;
+    default:
+        delete msg;
+        break;
+    }
+    delete job;
+}
+
 void PASER_packet_processing::deleteRouteRequestTimeout(struct in_addr dest_addr) {
     packet_rreq_entry *rreq = rreq_list->pending_find(dest_addr);
     if (rreq) {
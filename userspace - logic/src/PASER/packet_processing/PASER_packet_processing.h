@@ -34,10 +34,12 @@ class PASER_packet_processing;
 #include "../crypto/PASER_root.h"
 #include "../crypto/PASER_crypto_hash.h"
 #include "../crypto/PASER_crypto_sign.h"
+#include "../crypto/PASER_verify_pool.h"
 #include "../route_maintenance/PASER_route_maintenance.h"
 #include "../timer_management/PASER_timer_queue.h"
 #include "../tables/PASER_neighbor_table.h"
 #include "../tables/PASER_routing_table.h"
+#include "../packet_structure/PASER_UB_RREQ_view.h"
 
 
 /**
@@ -63,11 +65,15 @@ private:
     PASER_root *root;
     PASER_crypto_sign *crypto_sign;
     PASER_crypto_hash *crypto_hash;
+    PASER_verify_pool *verify_pool;
     PASER_route_discovery *route_findung;
 
     PASER_rreq_list *rreq_list; ///< List of IP addresses to which a route discovery is started.
     PASER_rreq_list *rrep_list; ///< List of IP addresses from which a TU-RREP-ACK is expected.
 
+    bool inReceiveBatch;        ///< Set while handleLowerMsgs() processes a receive batch
+    std::list<PASER_verify_job *> batchJobs; ///< Signature checks of the current receive batch
+
 public:
     PASER_packet_processing(PASER_global *pGlobal, PASER_config *pConfig);
     ~PASER_packet_processing();
@@ -80,9 +86,34 @@ public:
      * Process a newly received PASER packet. Checks the type
      * to the necessary conversions and call the
      * corresponding functions to handle the information.
+     * The buffer <b>s</b> will be freed.
      */
     void handleLowerMsg(uint8_t *s, int length, u_int32_t ifIndex);
 
+    /**
+     * Process a newly received PASER packet like handleLowerMsg(),
+     * but the buffer <b>s</b> stays owned by the caller
+     * (e.g. a slab of the receive buffer pool).
+     */
+    void handleLowerMsgInPlace(uint8_t *s, int length, u_int32_t ifIndex);
+
+    /**
+     * Process all packets of a receive batch like handleLowerMsgInPlace().
+     * The signatures of all signed messages of the batch are checked
+     * together after all packets are parsed.
+     *
+     *@param packets received packets. Entries with len -1 are skipped
+     *@param n number of packets
+     *@param ifIndex interface on which the packets were received
+     */
+    void handleLowerMsgs(lv_block *packets, int n, u_int32_t ifIndex);
+
+    /**
+     * Continue processing of all messages whose signatures were verified
+     * by the worker threads of PASER_verify_pool.
+     */
+    void handleVerifiedMsgs();
+
 private:
     /**
      * Cast incoming char array to PASER packet.
@@ -91,6 +122,17 @@ private:
      */
     PASER_MSG *castToPaserPacket(uint8_t *s, int length);
 
+    /**
+     * Create a UB-RREQ from the incoming char array. The checks of
+     * handleUBRREQ() which precede the signature check (registration,
+     * route list, sequence numbers, geo position and timestamp) are done
+     * on a PASER_UB_RREQ_view of the array, so that a flood of stale or
+     * looped UB-RREQs is dropped without allocating the messages.
+     *
+     *@return PASER packet if the message passed the checks or NULL
+     */
+    PASER_MSG *createUBRREQ(uint8_t *s, int length);
+
     /**
      * Checks the sequence number of the PASER message
      *
@@ -101,6 +143,22 @@ private:
      */
     int check_seq_nr(PASER_MSG *paser_msg, struct in_addr forwarding);
 
+    /**
+     * Checks the sequence number like the function above, but on the
+     * fields of a message which is not yet materialized.
+     *
+     * @param type type of the message
+     * @param src IP address of the querying node
+     * @param dest IP address of the destination node
+     * @param seq sequence number of the message
+     * @param seqForw sequence number of the forwarding node (UB-RREQ and TU-RREQ only)
+     * @param forwarding IP address of the node which forwarded the message
+     * @return 1 if the message is new
+     *        else 0
+     */
+    int check_seq_nr(u_int8_t type, struct in_addr src, struct in_addr dest, u_int32_t seq, u_int32_t seqForw,
+            struct in_addr forwarding);
+
     /**
      * Check if the specified position is in the range of own wireless card.
      *
@@ -121,6 +179,11 @@ private:
      */
     int checkRouteList(std::list<address_list> rList);
 
+    /**
+     * Check the route list of a received UB-RREQ like the function above.
+     */
+    int checkRouteList(const PASER_UB_RREQ_view *view);
+
     /**
      * Functions to process a newly received PASER packets. Check the packets,
      * edit routing and neighbor tables, set timer and send a reply or forward
@@ -135,8 +198,38 @@ private:
     void handleHELLO(PASER_MSG * msg, u_int32_t ifIndex);
     void handleB_ROOT(PASER_MSG * msg, u_int32_t ifIndex);
     void handleB_RESET(PASER_MSG * msg, u_int32_t ifIndex);
+
+    /**
+     * Second part of the functions above. Called after the signature
+     * of the message was verified. Check the result of <b>job</b> and
+     * edit the tables. The functions delete the message, but not the job.
+     */
+    void handleVerifiedUBRREQ(PASER_MSG * msg, PASER_verify_job *job);
+    void handleVerifiedUURREP(PASER_MSG * msg, PASER_verify_job *job);
+    void handleVerifiedB_ROOT(PASER_MSG * msg, PASER_verify_job *job);
+    void handleVerifiedB_RESET(PASER_MSG * msg, PASER_verify_job *job);
     /*--------------------------------------------------------*/
 
+    /**
+     * Verify the signature of the job's message on a worker thread or,
+     * if no worker threads are running, immediately. The message is
+     * dropped if the verification queue is full.
+     * With worker threads, the job is collected inside of a receive batch
+     * and submitted by checkSignatureBatch().
+     */
+    void checkSignature(PASER_verify_job *job);
+
+    /**
+     * Submit the jobs which were collected during a receive batch to the
+     * worker threads at once.
+     */
+    void checkSignatureBatch();
+
+    /**
+     * Call the second part of the message handler and delete the job.
+     */
+    void handleVerifiedMsg(PASER_verify_job *job);
+
     /**
      * Check the KDC registration Reply. Send a Reply to the registered node if necessary.
      */
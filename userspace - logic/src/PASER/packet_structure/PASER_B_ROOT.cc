@@ -21,6 +21,7 @@
  ********************************************************************************/
 
 #include "PASER_B_ROOT.h"
+#include "PASER_B_ROOT_view.h"
 
 /**
  * Constructor of PASER_B_ROOT packet that creates an exact copy of another packets.
@@ -67,173 +68,36 @@ PASER_B_ROOT::PASER_B_ROOT() {
 }
 
 PASER_B_ROOT* PASER_B_ROOT::create(uint8_t *packet, u_int32_t l) {
-    int length = 0;
-    uint8_t *pointer;
-    pointer = packet;
-    if (l < 1) {
-        std::cout << "ERROR: Wrong packet length(Length < 1)." << std::endl;
+    PASER_B_ROOT_view view;
+    if (!view.parse(packet, l)) {
+        std::cout << "ERROR: Wrong " << view.error << "." << std::endl;
         std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
         return NULL;
     }
-    // read packet type
-    if (packet[0] != 0x07) {
-        std::cout << "ERROR: Wrong packet type." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        return NULL;
-    }
-    length++;
-    pointer++;
-
-    // read IP address of source node
-    in_addr tempSrcAddr;
-    if ((length + sizeof(tempSrcAddr.s_addr)) > l) {
-        std::cout << "ERROR: Wrong SrcAddr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSrcAddr.s_addr, pointer, sizeof(tempSrcAddr.s_addr));
-    pointer += sizeof(tempSrcAddr.s_addr);
-    length += sizeof(tempSrcAddr.s_addr);
-
-    // read Sending node's current sequence number
-    u_int32_t tempSeq;
-    if ((length + sizeof(tempSeq)) > l) {
-        std::cout << "ERROR: Wrong SeqNr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSeq, pointer, sizeof(tempSeq));
-    pointer += sizeof(tempSeq);
-    length += sizeof(tempSeq);
-
-    // read Length of Certificate
-    u_int32_t tempCertL;
-    if ((length + sizeof(tempCertL)) > l) {
-        std::cout << "ERROR: Wrong length of certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempCertL, pointer, sizeof(tempCertL));
-    pointer += sizeof(tempCertL);
-    length += sizeof(tempCertL);
-
-    // read Certificate
-    u_int8_t * tempCert;
-    if ((length + tempCertL) > l) {
-        std::cout << "ERROR: Wrong certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        return NULL;
-    }
-    tempCert = (uint8_t *) malloc(tempCertL);
-    memcpy((uint8_t *) tempCert, pointer, tempCertL);
-    pointer += tempCertL;
-    length += tempCertL;
-
-    // read Root
-    u_int8_t * tempRoot;
-    if ((length + PASER_SECRET_HASH_LEN) > l) {
-        std::cout << "ERROR: Wrong Root." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        return NULL;
-    }
-    tempRoot = (uint8_t *) malloc(PASER_SECRET_HASH_LEN);
-    memcpy((uint8_t *) tempRoot, pointer, PASER_SECRET_HASH_LEN);
-    pointer += PASER_SECRET_HASH_LEN;
-    length += PASER_SECRET_HASH_LEN;
-
-    // read IV
-    u_int32_t tempIV;
-    if ((length + sizeof(tempIV)) > l) {
-        std::cout << "ERROR: Wrong IV." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        free(tempRoot);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempIV, pointer, sizeof(tempIV));
-    pointer += sizeof(tempIV);
-    length += sizeof(tempIV);
-
-    // Geographical position of sending node (lat)
-    double tempGeoLat;
-    if ((length + sizeof(tempGeoLat)) > l) {
-        std::cout << "ERROR: Wrong GeoLat." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        free(tempRoot);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoLat, pointer, sizeof(tempGeoLat));
-    pointer += sizeof(tempGeoLat);
-    length += sizeof(tempGeoLat);
-
-    // read Geographical position of sending node (lon)
-    double tempGeoLon;
-    if ((length + sizeof(tempGeoLon)) > l) {
-        std::cout << "ERROR: Wrong GeoLon." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        free(tempRoot);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoLon, pointer, sizeof(tempGeoLon));
-    pointer += sizeof(tempGeoLon);
-    length += sizeof(tempGeoLon);
-
-    // read Sending time
-    unsigned long tempTime;
-    if ((length + sizeof(tempTime)) > l) {
-        std::cout << "ERROR: Wrong Timestamp." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        free(tempRoot);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempTime, pointer, sizeof(tempTime));
-    pointer += sizeof(tempTime);
-    length += sizeof(tempTime);
-
-    // read Length of Signature
-    u_int32_t tempSignL;
-    if ((length + sizeof(tempSignL)) > l) {
-        std::cout << "ERROR: Wrong length of signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        free(tempRoot);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSignL, pointer, sizeof(tempSignL));
-    pointer += sizeof(tempSignL);
-    length += sizeof(tempSignL);
-
-    // read Signature
-    u_int8_t * tempSign;
-    if ((length + tempSignL) > l) {
-        std::cout << "ERROR: Wrong signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_B_ROOT packet from given char array." << std::endl;
-        free(tempCert);
-        free(tempRoot);
-        return NULL;
-    }
-    tempSign = (uint8_t *) malloc(tempSignL);
-    memcpy((uint8_t *) tempSign, pointer, tempSignL);
-    pointer += tempSignL;
-    length += tempSignL;
+    return create(&view);
+}
 
+PASER_B_ROOT* PASER_B_ROOT::create(const PASER_B_ROOT_view *view) {
     PASER_B_ROOT *tempPacket = new PASER_B_ROOT();
     tempPacket->type = B_ROOT;
-    tempPacket->srcAddress_var.s_addr = tempSrcAddr.s_addr;
-    tempPacket->seq = tempSeq;
-    tempPacket->cert.len = tempCertL;
-    tempPacket->cert.buf = tempCert;
-    tempPacket->root = tempRoot;
-    tempPacket->initVector = tempIV;
-    tempPacket->geoQuerying.lat = tempGeoLat;
-    tempPacket->geoQuerying.lon = tempGeoLon;
-    tempPacket->timestamp = tempTime;
-    tempPacket->sign.len = tempSignL;
-    tempPacket->sign.buf = tempSign;
+    tempPacket->srcAddress_var.s_addr = view->srcAddress_var.s_addr;
+    tempPacket->seq = view->seq;
+    // the destructor frees the certificate and the signature only if they are not empty
+    if (view->cert.len > 0) {
+        tempPacket->cert.len = view->cert.len;
+        tempPacket->cert.buf = (uint8_t *) malloc(view->cert.len);
+        memcpy(tempPacket->cert.buf, view->cert.buf, view->cert.len);
+    }
+    tempPacket->root = (uint8_t *) malloc(PASER_SECRET_HASH_LEN);
+    memcpy(tempPacket->root, view->root.buf, PASER_SECRET_HASH_LEN);
+    tempPacket->initVector = view->initVector;
+    tempPacket->geoQuerying = view->geoQuerying;
+    tempPacket->timestamp = view->timestamp;
+    if (view->sign.len > 0) {
+        tempPacket->sign.len = view->sign.len;
+        tempPacket->sign.buf = (uint8_t *) malloc(view->sign.len);
+        memcpy(tempPacket->sign.buf, view->sign.buf, view->sign.len);
+    }
     return tempPacket;
 }
 
@@ -330,96 +194,44 @@ std::string PASER_B_ROOT::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_B_ROOT::toByteArray(int *l) {
-    //Compute length of the packet
-    int len = 0;
-    len += 1; // Type of PASER packets
-    len += sizeof(srcAddress_var.s_addr); // IP address of source node
-    len += sizeof(seq); // Sending node's current sequence number
-
-    len += sizeof(cert.len); // Length of Certificate
-    len += cert.len; // Certificate
-
-    len += PASER_SECRET_HASH_LEN; // Root element
-    len += sizeof(initVector); // IV
-    len += sizeof(geoQuerying.lat); // Geographical position of sending node
-    len += sizeof(geoQuerying.lon); // Geographical position of sending node
-    len += sizeof(timestamp); // Sending time
-
-    // Allocate block of size "len" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(len);
-    uint8_t *buf;
-    buf = data;
+void PASER_B_ROOT::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x07;
-    buf++;
+    sink->writeByte(0x07);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
 
     // Cert of querying node
-    memcpy(buf, (uint8_t *) &cert.len, sizeof(cert.len));
-    buf += sizeof(cert.len);
-    memcpy(buf, cert.buf, cert.len);
-    buf += cert.len;
+    sink->write((uint8_t *) &cert.len, sizeof(cert.len));
+    sink->write(cert.buf, cert.len);
 
     // root
-    memcpy(buf, root, PASER_SECRET_HASH_LEN);
-    buf += PASER_SECRET_HASH_LEN;
+    sink->write(root, PASER_SECRET_HASH_LEN);
     // IV
-    memcpy(buf, (uint8_t *) &initVector, sizeof(initVector));
-    buf += sizeof(initVector);
+    sink->write((uint8_t *) &initVector, sizeof(initVector));
     // GEO of querying node
-    memcpy(buf, (uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
-    buf += sizeof(geoQuerying.lat);
-    memcpy(buf, (uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
-    buf += sizeof(geoQuerying.lon);
+    sink->write((uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
+    sink->write((uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
     //timestamp
-    memcpy(buf, (uint8_t *) &timestamp, sizeof(timestamp));
-    buf += sizeof(timestamp);
-
-    *l = len;
-    return data;
+    sink->write((uint8_t *) &timestamp, sizeof(timestamp));
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_B_ROOT::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += sizeof(sign.len); // Length of signature
-    lengthNew += sign.len; // Signature
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_B_ROOT::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
     //sign
-    memcpy(buf, (uint8_t *) &sign.len, sizeof(sign.len));
-    buf += sizeof(sign.len);
-    memcpy(buf, sign.buf, sign.len);
-    buf += sign.len;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) &sign.len, sizeof(sign.len));
+    sink->write(sign.buf, sign.len);
 
 //    //Compute full length of the packet
 //    int len = 0;
@@ -32,6 +32,8 @@ class PASER_B_ROOT;
 #include "../config/PASER_defs.h"
 #include "PASER_MSG.h"
 
+class PASER_B_ROOT_view;
+
 /**
  * Implementation of the PASER_B_ROOT classes
  */
@@ -49,6 +51,11 @@ public:
     PASER_B_ROOT(struct in_addr src, u_int32_t seqNr);
 
     static PASER_B_ROOT* create(uint8_t *packet, u_int32_t l);
+    /**
+     * Materialize a message from the view of a received B-ROOT.
+     * The fields are copied, so the message outlives the receive buffer.
+     */
+    static PASER_B_ROOT* create(const PASER_B_ROOT_view *view);
 
     virtual ~PASER_B_ROOT();
 
@@ -56,8 +63,8 @@ public:
     virtual PASER_B_ROOT *dup() const {return new PASER_B_ROOT(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
-    uint8_t * getCompleteByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
+    void writeCompleteFields(PASER_field_sink *sink);
 
 private:
     PASER_B_ROOT();
@@ -122,7 +122,7 @@ PASER_GTKREP* PASER_GTKREP::create(uint8_t *packet, u_int32_t l) {
 
     // read GTK
     u_int8_t * tempGTK;
-    if ((length + tempGTKL) > l) {
+    if (tempGTKL > l - length) {
         std::cout << "ERROR: Wrong GTK." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREP packet from given char array." << std::endl;
         return NULL;
@@ -156,7 +156,7 @@ PASER_GTKREP* PASER_GTKREP::create(uint8_t *packet, u_int32_t l) {
 
     // read GTK
     u_int8_t * tempCRL;
-    if ((length + tempCRLL) > l) {
+    if (tempCRLL > l - length) {
         std::cout << "ERROR: Wrong CRL." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREP packet from given char array." << std::endl;
         return NULL;
@@ -179,7 +179,7 @@ PASER_GTKREP* PASER_GTKREP::create(uint8_t *packet, u_int32_t l) {
 
     // read KDC Certificate
     u_int8_t * tempKDC_cert;
-    if ((length + tempKDC_certL) > l) {
+    if (tempKDC_certL > l - length) {
         std::cout << "ERROR: Wrong KDC Certificate." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREP packet from given char array." << std::endl;
         return NULL;
@@ -213,7 +213,7 @@ PASER_GTKREP* PASER_GTKREP::create(uint8_t *packet, u_int32_t l) {
 
     // read GTK's signature
     u_int8_t * tempSignGTK;
-    if ((length + tempSignGTKL) > l) {
+    if (tempSignGTKL > l - length) {
         std::cout << "ERROR: Wrong GTK's signature." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREP packet from given char array." << std::endl;
         return NULL;
@@ -236,7 +236,7 @@ PASER_GTKREP* PASER_GTKREP::create(uint8_t *packet, u_int32_t l) {
 
     // read signature of KDC block
     u_int8_t * tempSignKDCBlock;
-    if ((length + tempSignKDCBlockL) > l) {
+    if (tempSignKDCBlockL > l - length) {
         std::cout << "ERROR: Wrong signature of KDC block." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREP packet from given char array." << std::endl;
         return NULL;
@@ -259,7 +259,7 @@ PASER_GTKREP* PASER_GTKREP::create(uint8_t *packet, u_int32_t l) {
 
     // read signature
     u_int8_t * tempSign;
-    if ((length + tempSignL) > l) {
+    if (tempSignL > l - length) {
         std::cout << "ERROR: Wrong signature." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREP packet from given char array." << std::endl;
         return NULL;
@@ -392,114 +392,47 @@ std::string PASER_GTKREP::detailedInfo() const {
     return out.str();
 }
 
-uint8_t * PASER_GTKREP::toByteArray(int *l) {
-    //Compute length of the packet
-    int len = 0;
-    len += 1; // Type of PASER packets
-    len += sizeof(srcAddress_var.s_addr); // Source's IP address
-    len += sizeof(gwAddr.s_addr); // Gateway's IP address
-    len += sizeof(nextHopAddr.s_addr); // nextHop's IP address
-
-    len += sizeof(gtk.len); // Length of GTK
-    len += gtk.len; // GTK
-
-    len += sizeof(nonce); // Sending node's nonce
-
-    len += sizeof(crl.len); // Length of CRL
-    len += crl.len; // CRL
-
-    len += sizeof(kdc_cert.len); // Length of kdc_cert
-    len += kdc_cert.len; // kdc_cert
-
-    len += sizeof(kdc_key_nr); // Sending GTK number
-
-    len += sizeof(sign_key.len); // Length of GTK's signature
-    len += sign_key.len; // GTK's signature
-
-    len += sizeof(sign_kdc_block.len); // Length of GTK's signature
-    len += sign_kdc_block.len; // GTK's signature
-
-    // Allocate block of size "len" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(len);
-    uint8_t *buf;
-    buf = data;
+void PASER_GTKREP::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x0a;
-    buf++;
+    sink->writeByte(0x0a);
 
     //Source's IP address
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     //Gateway's IP address
-    memcpy(buf, (uint8_t *) &gwAddr.s_addr, sizeof(gwAddr.s_addr));
-    buf += sizeof(gwAddr.s_addr);
+    sink->write((uint8_t *) &gwAddr.s_addr, sizeof(gwAddr.s_addr));
     //nextHop's IP address
-    memcpy(buf, (uint8_t *) &nextHopAddr.s_addr, sizeof(nextHopAddr.s_addr));
-    buf += sizeof(nextHopAddr.s_addr);
+    sink->write((uint8_t *) &nextHopAddr.s_addr, sizeof(nextHopAddr.s_addr));
 
     // GTK
-    memcpy(buf, (uint8_t *) &gtk.len, sizeof(gtk.len));
-    buf += sizeof(gtk.len);
-    memcpy(buf, gtk.buf, gtk.len);
-    buf += gtk.len;
+    sink->write((uint8_t *) &gtk.len, sizeof(gtk.len));
+    sink->write(gtk.buf, gtk.len);
 
     // nonce
-    memcpy(buf, (uint8_t *) &nonce, sizeof(nonce));
-    buf += sizeof(nonce);
+    sink->write((uint8_t *) &nonce, sizeof(nonce));
 
     // CRL
-    memcpy(buf, (uint8_t *) &crl.len, sizeof(crl.len));
-    buf += sizeof(crl.len);
-    memcpy(buf, crl.buf, crl.len);
-    buf += crl.len;
+    sink->write((uint8_t *) &crl.len, sizeof(crl.len));
+    sink->write(crl.buf, crl.len);
 
     // kdc_cert
-    memcpy(buf, (uint8_t *) &kdc_cert.len, sizeof(kdc_cert.len));
-    buf += sizeof(kdc_cert.len);
-    memcpy(buf, kdc_cert.buf, kdc_cert.len);
-    buf += kdc_cert.len;
+    sink->write((uint8_t *) &kdc_cert.len, sizeof(kdc_cert.len));
+    sink->write(kdc_cert.buf, kdc_cert.len);
 
     // GTK number
-    memcpy(buf, (uint8_t *) &kdc_key_nr, sizeof(kdc_key_nr));
-    buf += sizeof(kdc_key_nr);
+    sink->write((uint8_t *) &kdc_key_nr, sizeof(kdc_key_nr));
 
     // GTK's signature
-    memcpy(buf, (uint8_t *) &sign_key.len, sizeof(sign_key.len));
-    buf += sizeof(sign_key.len);
-    memcpy(buf, sign_key.buf, sign_key.len);
-    buf += sign_key.len;
+    sink->write((uint8_t *) &sign_key.len, sizeof(sign_key.len));
+    sink->write(sign_key.buf, sign_key.len);
 
     // KDC Block's signature
-    memcpy(buf, (uint8_t *) &sign_kdc_block.len, sizeof(sign_kdc_block.len));
-    buf += sizeof(sign_kdc_block.len);
-    memcpy(buf, sign_kdc_block.buf, sign_kdc_block.len);
-    buf += sign_kdc_block.len;
-
-    *l = len;
-    return data;
+    sink->write((uint8_t *) &sign_kdc_block.len, sizeof(sign_kdc_block.len));
+    sink->write(sign_kdc_block.buf, sign_kdc_block.len);
 }
 
-uint8_t * PASER_GTKREP::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += sizeof(sign.len); // Length of signature
-    lengthNew += sign.len; // Signature
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_GTKREP::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
     //sign
-    memcpy(buf, (uint8_t *) &sign.len, sizeof(sign.len));
-    buf += sizeof(sign.len);
-    memcpy(buf, sign.buf, sign.len);
-    buf += sign.len;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) &sign.len, sizeof(sign.len));
+    sink->write(sign.buf, sign.len);
 }
@@ -56,20 +56,18 @@ public:
     std::string detailedInfo() const;
 
     /**
-     * Creates and return an array of all fields that must be secured with signature
+     * Writes all fields that must be secured with signature to the sink
      *
-     *@param l length of created array
-     *@return packet array
+     *@param sink sink which receives the fields
      */
-    uint8_t * toByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
 
     /**
-     * Creates and return an array of all fields of the package
+     * Writes all fields of the package to the sink
      *
-     *@param l length of created array
-     *@return packet array
+     *@param sink sink which receives the fields
      */
-    uint8_t * getCompleteByteArray(int *l);
+    void writeCompleteFields(PASER_field_sink *sink);
 };
 
 #endif /* GTKRESPONSE_H_ */
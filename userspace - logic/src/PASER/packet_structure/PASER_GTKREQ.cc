@@ -111,7 +111,7 @@ PASER_GTKREQ* PASER_GTKREQ::create(uint8_t *packet, u_int32_t l) {
 
     // read Certificate
     u_int8_t * tempCert;
-    if ((length + tempCertL) > l) {
+    if (tempCertL > l - length) {
         std::cout << "ERROR: Wrong certificate." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKREQ packet from given char array." << std::endl;
         return NULL;
@@ -173,48 +173,20 @@ std::string PASER_GTKREQ::detailedInfo() const {
     return out.str();
 }
 
-uint8_t * PASER_GTKREQ::toByteArray(int *l) {
-    // Compute length of the packet
-    int len = 0;
-    len += 1; // Type of PASER packets
-    len += sizeof(srcAddress_var.s_addr); // source's IP address
-    len += sizeof(gwAddr.s_addr); // Gateway's IP address
-    len += sizeof(nextHopAddr.s_addr); // nextHop's IP address
-    len += sizeof(nonce); // Sending node's nonce
-
-    len += sizeof(cert.len); // Length of Certificate
-    len += cert.len; // Certificate
-
-    // Allocate block of size "len" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(len);
-    uint8_t *buf;
-    buf = data;
+void PASER_GTKREQ::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x09;
-    buf++;
-
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr); // Source's IP address
-    memcpy(buf, (uint8_t *) &gwAddr.s_addr, sizeof(gwAddr.s_addr));
-    buf += sizeof(gwAddr.s_addr); // Gateway's IP address
-    memcpy(buf, (uint8_t *) &nextHopAddr.s_addr, sizeof(nextHopAddr.s_addr));
-    buf += sizeof(nextHopAddr.s_addr); // nextHop's IP address
-    memcpy(buf, (uint8_t *) &nonce, sizeof(nonce));
-    buf += sizeof(nonce);     // nonce
+    sink->writeByte(0x09);
 
-    // Cert of querying node
-    memcpy(buf, (uint8_t *) &cert.len, sizeof(cert.len));
-    buf += sizeof(cert.len);
-    memcpy(buf, cert.buf, cert.len);
-    buf += cert.len;
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr)); // Source's IP address
+    sink->write((uint8_t *) &gwAddr.s_addr, sizeof(gwAddr.s_addr)); // Gateway's IP address
+    sink->write((uint8_t *) &nextHopAddr.s_addr, sizeof(nextHopAddr.s_addr)); // nextHop's IP address
+    sink->write((uint8_t *) &nonce, sizeof(nonce));     // nonce
 
-    *l = len;
-    return data;
+    // Cert of querying node
+    sink->write((uint8_t *) &cert.len, sizeof(cert.len));
+    sink->write(cert.buf, cert.len);
 }
 
-uint8_t * PASER_GTKREQ::getCompleteByteArray(int *l) {
-    int len = 0;
-    uint8_t *packet = toByteArray(&len);
-    *l = len;
-    return packet;
+void PASER_GTKREQ::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
 }
@@ -59,8 +59,8 @@ public:
     virtual PASER_GTKREQ *dup() const {return new PASER_GTKREQ(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
-    uint8_t * getCompleteByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
+    void writeCompleteFields(PASER_field_sink *sink);
 };
 
 #endif /* GTKREQUEST_H_ */
@@ -82,7 +82,7 @@ PASER_GTKRESET* PASER_GTKRESET::create(uint8_t *packet, u_int32_t l) {
 
     // read Certificate
     u_int8_t * tempCert;
-    if ((length + tempCertL) > l) {
+    if (tempCertL > l - length) {
         std::cout << "ERROR: Wrong Certificate." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKRESET packet from given char array." << std::endl;
         return NULL;
@@ -105,7 +105,7 @@ PASER_GTKRESET* PASER_GTKRESET::create(uint8_t *packet, u_int32_t l) {
 
     // read signature
     u_int8_t * tempSign;
-    if ((length + tempSignL) > l) {
+    if (tempSignL > l - length) {
         std::cout << "ERROR: Wrong signature." << std::endl;
         std::cout << "ERROR: cann't create PASER_GTKRESET packet from given char array." << std::endl;
         return NULL;
@@ -174,59 +174,21 @@ std::string PASER_GTKRESET::detailedInfo() const {
     return out.str();
 }
 
-uint8_t * PASER_GTKRESET::toByteArray(int *l) {
-    //Compute length of the packet
-    int len = 0;
-    len += 1;                // Type of PASER packets
-
-    len += sizeof(keyNr);    // number of GTK
-
-    len += sizeof(cert.len); // Length of Certificate of KDC
-    len += cert.len;         // Certificate of KDC
-
-    // Allocate block of size "len" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(len);
-    uint8_t *buf;
-    buf = data;
+void PASER_GTKRESET::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x0b;
-    buf++;
+    sink->writeByte(0x0b);
 
     // GTK number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 
     // kdc_cert
-    memcpy(buf, (uint8_t *) &cert.len, sizeof(cert.len));
-    buf += sizeof(cert.len);
-    memcpy(buf, cert.buf, cert.len);
-    buf += cert.len;
-
-    *l = len;
-    return data;
+    sink->write((uint8_t *) &cert.len, sizeof(cert.len));
+    sink->write(cert.buf, cert.len);
 }
 
-uint8_t * PASER_GTKRESET::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += sizeof(sign.len); // Length of signature
-    lengthNew += sign.len; // Signature
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_GTKRESET::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
     //sign
-    memcpy(buf, (uint8_t *) &sign.len, sizeof(sign.len));
-    buf += sizeof(sign.len);
-    memcpy(buf, sign.buf, sign.len);
-    buf += sign.len;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) &sign.len, sizeof(sign.len));
+    sink->write(sign.buf, sign.len);
 }
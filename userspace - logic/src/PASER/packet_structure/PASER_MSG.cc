@@ -22,9 +22,63 @@
 
 #include "PASER_MSG.h"
 
+/**
+ * Sink which only counts the length of the fields
+ */
+class PASER_field_counter: public PASER_field_sink {
+public:
+    size_t len;
+
+    PASER_field_counter() {
+        len = 0;
+    }
+    void write(const void *data, size_t l) {
+        len += l;
+    }
+};
+
+/**
+ * Sink which copies the fields to a buffer
+ */
+class PASER_field_buffer: public PASER_field_sink {
+public:
+    uint8_t *buf;
+
+    PASER_field_buffer(uint8_t *data) {
+        buf = data;
+    }
+    void write(const void *data, size_t l) {
+        if (l == 0) {
+            return;
+        }
+        memcpy(buf, data, l);
+        buf += l;
+    }
+};
+
 PASER_MSG::PASER_MSG(){
 }
 
 PASER_MSG::~PASER_MSG(){
 
 }
+
+uint8_t *PASER_MSG::toByteArray(int *l) {
+    PASER_field_counter counter;
+    writeFields(&counter);
+    uint8_t *data = (uint8_t *) malloc(counter.len);
+    PASER_field_buffer buffer(data);
+    writeFields(&buffer);
+    *l = counter.len;
+    return data;
+}
+
+uint8_t *PASER_MSG::getCompleteByteArray(int *l) {
+    PASER_field_counter counter;
+    writeCompleteFields(&counter);
+    uint8_t *data = (uint8_t *) malloc(counter.len);
+    PASER_field_buffer buffer(data);
+    writeCompleteFields(&buffer);
+    *l = counter.len;
+    return data;
+}
@@ -24,6 +24,7 @@
 #define PASER_MSG_H_
 
 #include "../config/PASER_defs.h"
+#include "PASER_field_sink.h"
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
@@ -68,21 +69,36 @@ public:
      */
     virtual PASER_MSG *dup() const=0;
 
+    /**
+     * Writes all fields that must be secured with hash or signature to the sink
+     *
+     *@param sink sink which receives the fields
+     */
+    virtual void writeFields(PASER_field_sink *sink)=0;
+
+    /**
+     * Writes all fields of the package to the sink
+     *
+     *@param sink sink which receives the fields
+     */
+    virtual void writeCompleteFields(PASER_field_sink *sink)=0;
+
     /**
      * Creates and return an array of all fields that must be secured with hash or signature
      *
      *@param l length of created array
      *@return packet array
      */
-    virtual uint8_t *toByteArray(int *l)=0;
+    uint8_t *toByteArray(int *l);
 
     /**
-     * Creates and return an array of all fields of the package
+     * Creates and return an array of all fields of the package.
+     * The array is allocated once and the fields are encoded once.
      *
      *@param l length of created array
      *@return packet array
      */
-    virtual uint8_t *getCompleteByteArray(int *l)=0;
+    uint8_t *getCompleteByteArray(int *l);
 };
 
 #endif /* PASER_MSG_H_ */
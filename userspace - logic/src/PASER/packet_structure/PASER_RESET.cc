@@ -21,6 +21,7 @@
  ********************************************************************************/
 
 #include "PASER_RESET.h"
+#include "PASER_RESET_view.h"
 
 #include <openssl/sha.h>
 #include <openssl/x509.h>
@@ -59,101 +60,26 @@ PASER_RESET::PASER_RESET() {
 }
 
 PASER_RESET* PASER_RESET::create(uint8_t *packet, u_int32_t l) {
-    int length = 0;
-    uint8_t *pointer;
-    pointer = packet;
-    if (l < 1) {
-        std::cout << "ERROR: Wrong packet length(Length < 1)." << std::endl;
+    PASER_RESET_view view;
+    if (!view.parse(packet, l)) {
+        std::cout << "ERROR: Wrong " << view.error << "." << std::endl;
         std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
         return NULL;
     }
-    // read packet type
-    if (packet[0] != 0x08) {
-        std::cout << "ERROR: Wrong packet type." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        return NULL;
-    }
-    length++;
-    pointer++;
-
-    // read IP address of source node
-    in_addr tempSrcAddr;
-    if ((length + sizeof(tempSrcAddr.s_addr)) > l) {
-        std::cout << "ERROR: Wrong SrcAddr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSrcAddr.s_addr, pointer, sizeof(tempSrcAddr.s_addr));
-    pointer += sizeof(tempSrcAddr.s_addr);
-    length += sizeof(tempSrcAddr.s_addr);
-
-    // read GTK number
-    u_int32_t tempKeyNr;
-    if ((length + sizeof(tempKeyNr)) > l) {
-        std::cout << "ERROR: Wrong KeyNr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempKeyNr, pointer, sizeof(tempKeyNr));
-    pointer += sizeof(tempKeyNr);
-    length += sizeof(tempKeyNr);
-
-    // read Length of Certificate
-    u_int32_t tempCertL;
-    if ((length + sizeof(tempCertL)) > l) {
-        std::cout << "ERROR: Wrong length of certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempCertL, pointer, sizeof(tempCertL));
-    pointer += sizeof(tempCertL);
-    length += sizeof(tempCertL);
-
-    // read Certificate
-    u_int8_t * tempCert;
-    if ((length + tempCertL) > l) {
-        std::cout << "ERROR: Wrong certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        return NULL;
-    }
-    tempCert = (uint8_t *) malloc(tempCertL);
-    memcpy((uint8_t *) tempCert, pointer, tempCertL);
-    pointer += tempCertL;
-    length += tempCertL;
-
-    // read Length of Signature
-    u_int32_t tempSignL;
-    if ((length + sizeof(tempSignL)) > l) {
-        std::cout << "ERROR: Wrong length of signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        free(tempCert);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSignL, pointer, sizeof(tempSignL));
-    pointer += sizeof(tempSignL);
-    length += sizeof(tempSignL);
-
-    // read Signature
-    u_int8_t * tempSign;
-    if ((length + tempSignL) > l) {
-        std::cout << "ERROR: Wrong signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_RESET packet from given char array." << std::endl;
-        free(tempCert);
-        return NULL;
-    }
-    tempSign = (uint8_t *) malloc(tempSignL);
-    memcpy((uint8_t *) tempSign, pointer, tempSignL);
-    pointer += tempSignL;
-    length += tempSignL;
+    return create(&view);
+}
 
+PASER_RESET* PASER_RESET::create(const PASER_RESET_view *view) {
     PASER_RESET *tempPacket = new PASER_RESET();
     tempPacket->type = B_RESET;
-    tempPacket->srcAddress_var.s_addr = tempSrcAddr.s_addr;
-    tempPacket->keyNr = tempKeyNr;
-    tempPacket->cert.len = tempCertL;
-    tempPacket->cert.buf = tempCert;
-    tempPacket->sign.len = tempSignL;
-    tempPacket->sign.buf = tempSign;
+    tempPacket->srcAddress_var.s_addr = view->srcAddress_var.s_addr;
+    tempPacket->keyNr = view->keyNr;
+    tempPacket->cert.len = view->cert.len;
+    tempPacket->cert.buf = (uint8_t *) malloc(view->cert.len);
+    memcpy(tempPacket->cert.buf, view->cert.buf, view->cert.len);
+    tempPacket->sign.len = view->sign.len;
+    tempPacket->sign.buf = (uint8_t *) malloc(view->sign.len);
+    memcpy(tempPacket->sign.buf, view->sign.buf, view->sign.len);
     return tempPacket;
 }
 /**
@@ -225,24 +151,11 @@ std::string PASER_RESET::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_RESET::toByteArray(int *l) {
-    int len = 0;
-//    len += 1;
-//    len += sizeof(srcAddress_var.s_addr);
-
-    len += sizeof(keyNr);
-    len += sizeof(cert.len);
-    len += cert.len;
-
-    //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
+void PASER_RESET::writeFields(PASER_field_sink *sink) {
     //messageType
 //    data[0] = 0x08;
 //    buf ++;
@@ -252,58 +165,29 @@ uint8_t * PASER_RESET::toByteArray(int *l) {
 //    buf += sizeof(srcAddress_var.s_addr);
 
 // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
-    memcpy(buf, (uint8_t *) &cert.len, sizeof(cert.len));
-    buf += sizeof(cert.len);
-    memcpy(buf, cert.buf, cert.len);
-    buf += cert.len;
-
-    *l = len;
-    return data;
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
+    sink->write((uint8_t *) &cert.len, sizeof(cert.len));
+    sink->write(cert.buf, cert.len);
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_RESET::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += 1; //messageType
-    lengthNew += sizeof(srcAddress_var.s_addr); //IP of forwarding node
-    lengthNew += sizeof(sign.len); // Length of signature
-    lengthNew += sign.len; // Signature
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
+void PASER_RESET::writeCompleteFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x08;
-    buf++;
+    sink->writeByte(0x08);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
 
     // Packet
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+    writeFields(sink);
 
     //sign
-    memcpy(buf, (uint8_t *) &sign.len, sizeof(sign.len));
-    buf += sizeof(sign.len);
-    memcpy(buf, sign.buf, sign.len);
-    buf += sign.len;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) &sign.len, sizeof(sign.len));
+    sink->write(sign.buf, sign.len);
 
 //
 //    int len = 0;
@@ -30,6 +30,7 @@
 #include <list>
 #include <string.h>
 
+class PASER_RESET_view;
 
 /**
  * Implementation of PASER_RESET classes
@@ -45,6 +46,11 @@ public:
     PASER_RESET(struct in_addr src);
 
     static PASER_RESET* create(uint8_t *packet, u_int32_t l);
+    /**
+     * Materialize a message from the view of a received RESET.
+     * The fields are copied, so the message outlives the receive buffer.
+     */
+    static PASER_RESET* create(const PASER_RESET_view *view);
 
     ~PASER_RESET();
 
@@ -52,8 +58,8 @@ public:
     virtual PASER_RESET *dup() const {return new PASER_RESET(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
-    uint8_t * getCompleteByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
+    void writeCompleteFields(PASER_field_sink *sink);
 private:
     PASER_RESET();
 };
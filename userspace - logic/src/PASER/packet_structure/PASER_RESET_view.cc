@@ -0,0 +1,62 @@
+/**
+ *\class  		PASER_RESET_view
+ *@brief       	Class implements a read-only view of a received PASER_RESET message
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_RESET_view.h"
+
+PASER_RESET_view::PASER_RESET_view() {
+    srcAddress_var.s_addr = 0;
+    keyNr = 0;
+    cert.buf = NULL;
+    cert.len = 0;
+    sign.buf = NULL;
+    sign.len = 0;
+    error = NULL;
+}
+
+int PASER_RESET_view::parse(const uint8_t *packet, u_int32_t l) {
+    PASER_wire_reader reader(packet, l);
+
+    // read packet type
+    uint8_t type;
+    if (!reader.read(&type) || type != 0x08) {
+        error = "packet type";
+        return 0;
+    }
+    if (!reader.read(&srcAddress_var.s_addr)) {
+        error = "SrcAddr";
+        return 0;
+    }
+    if (!reader.read(&keyNr)) {
+        error = "KeyNr";
+        return 0;
+    }
+    if (!reader.readLVSpan(&cert)) {
+        error = "certificate";
+        return 0;
+    }
+    if (!reader.readLVSpan(&sign)) {
+        error = "signature";
+        return 0;
+    }
+    error = NULL;
+    return 1;
+}
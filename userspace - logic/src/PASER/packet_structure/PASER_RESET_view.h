@@ -0,0 +1,59 @@
+/**
+ *\class  		PASER_RESET_view
+ *@brief       	Class implements a read-only view of a received PASER_RESET message
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_RESET_view;
+
+#ifndef PASER_RESET_VIEW_H_
+#define PASER_RESET_VIEW_H_
+
+#include "../config/PASER_defs.h"
+#include "PASER_wire_reader.h"
+
+/**
+ * View of a received RESET. parse() checks the complete structure of the
+ * message, the certificate and the signature are spans into the receive
+ * buffer. PASER_RESET::create() materializes the message.
+ */
+class PASER_RESET_view {
+public:
+    struct in_addr srcAddress_var;              ///< IP address of sending node
+    u_int32_t keyNr;                            ///< Current number of GTK
+    lv_block cert;                              ///< Certificate of KDC
+    lv_block sign;                              ///< Signature of the packet
+
+    const char *error;                          ///< Name of the field which could not be read or NULL
+
+    PASER_RESET_view();
+
+    /**
+     * Check the structure of the char array and read the fixed fields.
+     *
+     *@param packet received char array
+     *@param l length of the char array
+     *
+     *@return 1 on successful or 0 if the array is no valid RESET.
+     *        <b>error</b> names the wrong field in this case.
+     */
+    int parse(const uint8_t *packet, u_int32_t l);
+};
+
+#endif /* PASER_RESET_VIEW_H_ */
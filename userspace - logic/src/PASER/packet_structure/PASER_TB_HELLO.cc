@@ -384,129 +384,60 @@ std::string PASER_TB_HELLO::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TB_HELLO::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(seq);
-
-    len += sizeof(len); // groesse der Adl
-    for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
-        address_list temp = (address_list) *it;
-        len += sizeof(temp.ipaddr.s_addr);
-        len += sizeof(len); // groesse der add_r
-        for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
-            struct in_addr temp_addr;
-            temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            len += sizeof(temp_addr.s_addr);
-            temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            len += sizeof(temp_addr.s_addr);
-        }
-    }
-    len += sizeof(geoQuerying.lat);
-    len += sizeof(geoQuerying.lon);
-
-    //secret
-    len += PASER_SECRET_LEN;
-
-    // auth
-    len += sizeof(auth.size());
-    for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        len += SHA256_DIGEST_LENGTH;
-    }
-
-    //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
+void PASER_TB_HELLO::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x06;
-    buf++;
+    sink->writeByte(0x06);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
     // AddL
     // Groesse der ADL
     int tempListSize = AddressRangeList.size();
-    memcpy(buf, (uint8_t *) &tempListSize, sizeof(tempListSize));
-    buf += sizeof(tempListSize);
+    sink->write((uint8_t *) &tempListSize, sizeof(tempListSize));
     for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
         address_list temp = (address_list) *it;
-        memcpy(buf, (uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
-        buf += sizeof(temp.ipaddr.s_addr);
+        sink->write((uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
         // Groesse der address_range
         int tempAdd = temp.range.size();
-        memcpy(buf, (uint8_t *) &tempAdd, sizeof(tempAdd));
-        buf += sizeof(tempAdd);
+        sink->write((uint8_t *) &tempAdd, sizeof(tempAdd));
         for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
             struct in_addr temp_addr;
             temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
             temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
         }
     }
     // GEO of Querying node
-    memcpy(buf, (uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
-    buf += sizeof(geoQuerying.lat);
-    memcpy(buf, (uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
-    buf += sizeof(geoQuerying.lon);
+    sink->write((uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
+    sink->write((uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
 
     // secret
-    memcpy(buf, (uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
-    buf += sizeof(uint8_t) * PASER_SECRET_LEN;
+    sink->write((uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
     // auth
     int authLen = auth.size();
-    memcpy(buf, &authLen, sizeof(authLen));
-    buf += sizeof(authLen);
+    sink->write(&authLen, sizeof(authLen));
     for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        memcpy(buf, (uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-        buf += sizeof(uint8_t) * SHA256_DIGEST_LENGTH;
+        sink->write((uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
     }
-
-    *l = len;
-    return data;
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TB_HELLO::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += PASER_SECRET_HASH_LEN; //MAC
-
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_TB_HELLO::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
 
     //hash
-    memcpy(buf, (uint8_t *) hash, PASER_SECRET_HASH_LEN);
-    buf += PASER_SECRET_HASH_LEN;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) hash, PASER_SECRET_HASH_LEN);
 
 //
 //    int len = 0;
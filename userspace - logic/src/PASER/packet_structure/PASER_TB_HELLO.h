@@ -54,8 +54,8 @@ public:
     virtual PASER_TB_HELLO *dup() const {return new PASER_TB_HELLO(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
-    uint8_t * getCompleteByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
+    void writeCompleteFields(PASER_field_sink *sink);
 
 private:
     PASER_TB_HELLO();
@@ -359,55 +359,21 @@ std::string PASER_TB_RERR::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TB_RERR::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(seq);
-    len += sizeof(keyNr);
-
-    len += sizeof(len); // groesse der UnreachableAdressesList
-    for (std::list<unreachableBlock>::iterator it = UnreachableAdressesList.begin(); it != UnreachableAdressesList.end(); it++) {
-        unreachableBlock temp = (unreachableBlock) *it;
-        len += sizeof(temp.addr.s_addr);
-        len += sizeof(temp.seq);
-    }
-
-    len += sizeof(geoForwarding.lat);
-    len += sizeof(geoForwarding.lon);
-
-    //secret
-    len += PASER_SECRET_LEN;
-
-    // auth
-    len += sizeof(auth.size());
-    for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        len += SHA256_DIGEST_LENGTH;
-    }
-
+void PASER_TB_RERR::writeFields(PASER_field_sink *sink) {
     //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
-    //messageType
-    data[0] = 0x05;
-    buf++;
+    sink->writeByte(0x05);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
 
     // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 //    // last unreachable Sequence number
 //    memcpy(buf, (uint8_t *)&lastUnreachableSeq, sizeof(lastUnreachableSeq));
 //    buf += sizeof(lastUnreachableSeq);
@@ -415,66 +381,37 @@ uint8_t * PASER_TB_RERR::toByteArray(int *l) {
     // UnreachableAdressesList
     // Groesse der UnreachableAdressesList
     int tempListSize = UnreachableAdressesList.size();
-    memcpy(buf, (uint8_t *) &tempListSize, sizeof(tempListSize));
-    buf += sizeof(tempListSize);
+    sink->write((uint8_t *) &tempListSize, sizeof(tempListSize));
     for (std::list<unreachableBlock>::iterator it = UnreachableAdressesList.begin(); it != UnreachableAdressesList.end(); it++) {
         unreachableBlock temp = (unreachableBlock) *it;
-        memcpy(buf, (uint8_t *) &temp.addr.s_addr, sizeof(temp.addr.s_addr));
-        buf += sizeof(temp.addr.s_addr);
-        memcpy(buf, &temp.seq, sizeof(temp.seq));
-        buf += sizeof(temp.seq);
+        sink->write((uint8_t *) &temp.addr.s_addr, sizeof(temp.addr.s_addr));
+        sink->write(&temp.seq, sizeof(temp.seq));
     }
 
     // GEO of forwarding node
-    memcpy(buf, (uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
-    buf += sizeof(geoForwarding.lat);
-    memcpy(buf, (uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
-    buf += sizeof(geoForwarding.lon);
+    sink->write((uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
+    sink->write((uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
 
     // secret
-    memcpy(buf, (uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
-    buf += sizeof(uint8_t) * PASER_SECRET_LEN;
+    sink->write((uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
     // auth
     int authLen = auth.size();
-    memcpy(buf, &authLen, sizeof(authLen));
-    buf += sizeof(authLen);
+    sink->write(&authLen, sizeof(authLen));
     for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        memcpy(buf, (uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-        buf += sizeof(uint8_t) * SHA256_DIGEST_LENGTH;
+        sink->write((uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
     }
-
-    *l = len;
-    return data;
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TB_RERR::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += PASER_SECRET_HASH_LEN; //MAC
-
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_TB_RERR::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
 
     //hash
-    memcpy(buf, (uint8_t *) hash, PASER_SECRET_HASH_LEN);
-    buf += PASER_SECRET_HASH_LEN;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) hash, PASER_SECRET_HASH_LEN);
 //
 //    int len = 0;
 //    len += 1;// Type of PASER packets
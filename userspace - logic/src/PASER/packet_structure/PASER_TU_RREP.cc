@@ -249,7 +249,7 @@ PASER_TU_RREP* PASER_TU_RREP::create(uint8_t *packet, u_int32_t l) {
 
         // read GTK
         u_int8_t * tempGTK;
-        if ((length + tempGTKL) > l) {
+        if (tempGTKL > l - length) {
             std::cout << "ERROR: Wrong GTK." << std::endl;
             std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
             return NULL;
@@ -285,7 +285,7 @@ PASER_TU_RREP* PASER_TU_RREP::create(uint8_t *packet, u_int32_t l) {
 
         // read CRL
         u_int8_t * tempCRL;
-        if ((length + tempCRLL) > l) {
+        if (tempCRLL > l - length) {
             std::cout << "ERROR: Wrong CRL." << std::endl;
             std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
             free(tempGTK);
@@ -311,7 +311,7 @@ PASER_TU_RREP* PASER_TU_RREP::create(uint8_t *packet, u_int32_t l) {
 
         // read KDC's certificate
         u_int8_t * tempCertKDC;
-        if ((length + tempCertKDCL) > l) {
+        if (tempCertKDCL > l - length) {
             std::cout << "ERROR: Wrong KDC's certificate." << std::endl;
             std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
             free(tempGTK);
@@ -339,7 +339,7 @@ PASER_TU_RREP* PASER_TU_RREP::create(uint8_t *packet, u_int32_t l) {
 
         // read KDC's signature
         u_int8_t * tempSignKDC;
-        if ((length + tempSignKDCL) > l) {
+        if (tempSignKDCL > l - length) {
             std::cout << "ERROR: Wrong KDC's signature." << std::endl;
             std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
             free(tempGTK);
@@ -384,7 +384,7 @@ PASER_TU_RREP* PASER_TU_RREP::create(uint8_t *packet, u_int32_t l) {
 
         // read key's signature
         u_int8_t * tempSignKey;
-        if ((length + tempSignKeyL) > l) {
+        if (tempSignKeyL > l - length) {
             std::cout << "ERROR: Wrong key's signature." << std::endl;
             std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
             free(tempGTK);
@@ -814,220 +814,102 @@ std::string PASER_TU_RREP::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TU_RREP::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(destAddress_var.s_addr);
-    len += sizeof(seq);
-    len += sizeof(keyNr);
-
-    len += sizeof(searchGW);
-    len += sizeof(GFlag);
-    len += sizeof(u_int32_t); // groesse der Adl
-    for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
-        address_list temp = (address_list) *it;
-        len += sizeof(temp.ipaddr.s_addr);
-        len += sizeof(u_int32_t); // groesse der add_r
-        for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
-            struct in_addr temp_addr;
-            temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            len += sizeof(temp_addr.s_addr);
-            temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            len += sizeof(temp_addr.s_addr);
-        }
-    }
-    len += sizeof(metricBetweenQueryingAndForw);
-    len += sizeof(metricBetweenDestAndForw);
-    if (GFlag) {
-        len += sizeof(kdc_data.GTK.len);
-        len += kdc_data.GTK.len;
-        len += sizeof(kdc_data.nonce);
-        len += sizeof(kdc_data.CRL.len);
-        len += kdc_data.CRL.len;
-        len += sizeof(kdc_data.cert_kdc.len);
-        len += kdc_data.cert_kdc.len;
-        len += sizeof(kdc_data.sign.len);
-        len += kdc_data.sign.len;
-        len += sizeof(kdc_data.key_nr);
-        len += sizeof(kdc_data.sign_key.len);
-        len += kdc_data.sign_key.len;
-    }
-
-    len += sizeof(geoDestination.lat);
-    len += sizeof(geoDestination.lon);
-    len += sizeof(geoForwarding.lat);
-    len += sizeof(geoForwarding.lon);
-
-    //secret
-    len += PASER_SECRET_LEN;
-
-    // auth
-    len += sizeof(auth.size());
-    for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        len += SHA256_DIGEST_LENGTH;
-    }
-
+void PASER_TU_RREP::writeFields(PASER_field_sink *sink) {
     //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
-    //messageType
-    data[0] = 0x03;
-    buf++;
+    sink->writeByte(0x03);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     //Dest node
-    memcpy(buf, (uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
-    buf += sizeof(destAddress_var.s_addr);
+    sink->write((uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
     // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 
     // SearchGW
-    if (searchGW)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(searchGW);
+    sink->writeByte(searchGW ? 0x01 : 0x00);
     // GFlag
-    if (GFlag)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(GFlag);
+    sink->writeByte(GFlag ? 0x01 : 0x00);
     // AddL
     // Groesse der ADL
     int tempListSize = AddressRangeList.size();
-    memcpy(buf, (uint8_t *) &tempListSize, sizeof(tempListSize));
-    buf += sizeof(tempListSize);
+    sink->write((uint8_t *) &tempListSize, sizeof(tempListSize));
     for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
         address_list temp = (address_list) *it;
-        memcpy(buf, (uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
-        buf += sizeof(temp.ipaddr.s_addr);
+        sink->write((uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
         // Groesse der address_range
         int tempAdd = temp.range.size();
-        memcpy(buf, (uint8_t *) &tempAdd, sizeof(tempAdd));
-        buf += sizeof(tempAdd);
+        sink->write((uint8_t *) &tempAdd, sizeof(tempAdd));
         for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
             struct in_addr temp_addr;
             temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
             temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
         }
     }
     // Metric
-    memcpy(buf, (uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
-    buf += sizeof(metricBetweenQueryingAndForw);
+    sink->write((uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
     // Metric
-    memcpy(buf, (uint8_t *) &metricBetweenDestAndForw, sizeof(metricBetweenDestAndForw));
-    buf += sizeof(metricBetweenDestAndForw);
+    sink->write((uint8_t *) &metricBetweenDestAndForw, sizeof(metricBetweenDestAndForw));
     // GTK
     if (GFlag) {
 //        memcpy(buf, (uint8_t *)&groupTransientKey.len, sizeof(groupTransientKey.len));
 //        buf += sizeof(groupTransientKey.len);
 //        memcpy(buf, groupTransientKey.buf, groupTransientKey.len);
 //        buf += groupTransientKey.len;
-        memcpy(buf, (uint8_t *) &kdc_data.GTK.len, sizeof(kdc_data.GTK.len));
-        buf += sizeof(kdc_data.GTK.len);
-        memcpy(buf, kdc_data.GTK.buf, kdc_data.GTK.len);
-        buf += kdc_data.GTK.len;
-
-        memcpy(buf, (uint8_t *) &kdc_data.nonce, sizeof(kdc_data.nonce));
-        buf += sizeof(kdc_data.nonce);
-
-        memcpy(buf, (uint8_t *) &kdc_data.CRL.len, sizeof(kdc_data.CRL.len));
-        buf += sizeof(kdc_data.CRL.len);
-        memcpy(buf, kdc_data.CRL.buf, kdc_data.CRL.len);
-        buf += kdc_data.CRL.len;
-
-        memcpy(buf, (uint8_t *) &kdc_data.cert_kdc.len, sizeof(kdc_data.cert_kdc.len));
-        buf += sizeof(kdc_data.cert_kdc.len);
-        memcpy(buf, kdc_data.cert_kdc.buf, kdc_data.cert_kdc.len);
-        buf += kdc_data.cert_kdc.len;
-
-        memcpy(buf, (uint8_t *) &kdc_data.sign.len, sizeof(kdc_data.sign.len));
-        buf += sizeof(kdc_data.sign.len);
-        memcpy(buf, kdc_data.sign.buf, kdc_data.sign.len);
-        buf += kdc_data.sign.len;
-
-        memcpy(buf, (uint8_t *) &kdc_data.key_nr, sizeof(kdc_data.key_nr));
-        buf += sizeof(kdc_data.key_nr);
-
-        memcpy(buf, (uint8_t *) &kdc_data.sign_key.len, sizeof(kdc_data.sign_key.len));
-        buf += sizeof(kdc_data.sign_key.len);
-        memcpy(buf, kdc_data.sign_key.buf, kdc_data.sign_key.len);
-        buf += kdc_data.sign_key.len;
+        sink->write((uint8_t *) &kdc_data.GTK.len, sizeof(kdc_data.GTK.len));
+        sink->write(kdc_data.GTK.buf, kdc_data.GTK.len);
+
+        sink->write((uint8_t *) &kdc_data.nonce, sizeof(kdc_data.nonce));
+
+        sink->write((uint8_t *) &kdc_data.CRL.len, sizeof(kdc_data.CRL.len));
+        sink->write(kdc_data.CRL.buf, kdc_data.CRL.len);
+
+        sink->write((uint8_t *) &kdc_data.cert_kdc.len, sizeof(kdc_data.cert_kdc.len));
+        sink->write(kdc_data.cert_kdc.buf, kdc_data.cert_kdc.len);
+
+        sink->write((uint8_t *) &kdc_data.sign.len, sizeof(kdc_data.sign.len));
+        sink->write(kdc_data.sign.buf, kdc_data.sign.len);
+
+        sink->write((uint8_t *) &kdc_data.key_nr, sizeof(kdc_data.key_nr));
+
+        sink->write((uint8_t *) &kdc_data.sign_key.len, sizeof(kdc_data.sign_key.len));
+        sink->write(kdc_data.sign_key.buf, kdc_data.sign_key.len);
     }
 
     // GEO of geoDestination node
-    memcpy(buf, (uint8_t *) &geoDestination.lat, sizeof(geoDestination.lat));
-    buf += sizeof(geoDestination.lat);
-    memcpy(buf, (uint8_t *) &geoDestination.lon, sizeof(geoDestination.lon));
-    buf += sizeof(geoDestination.lon);
+    sink->write((uint8_t *) &geoDestination.lat, sizeof(geoDestination.lat));
+    sink->write((uint8_t *) &geoDestination.lon, sizeof(geoDestination.lon));
     // GEO of forwarding node
-    memcpy(buf, (uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
-    buf += sizeof(geoForwarding.lat);
-    memcpy(buf, (uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
-    buf += sizeof(geoForwarding.lon);
+    sink->write((uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
+    sink->write((uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
 
     // secret
-    memcpy(buf, (uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
-    buf += sizeof(uint8_t) * PASER_SECRET_LEN;
+    sink->write((uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
     // auth
     int authLen = auth.size();
-    memcpy(buf, &authLen, sizeof(authLen));
-    buf += sizeof(authLen);
+    sink->write(&authLen, sizeof(authLen));
     for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        memcpy(buf, (uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-        buf += sizeof(uint8_t) * SHA256_DIGEST_LENGTH;
+        sink->write((uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
     }
-
-    *l = len;
-    return data;
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TU_RREP::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += PASER_SECRET_HASH_LEN; //MAC
-
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_TU_RREP::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
 
     //hash
-    memcpy(buf, (uint8_t *) hash, PASER_SECRET_HASH_LEN);
-    buf += PASER_SECRET_HASH_LEN;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) hash, PASER_SECRET_HASH_LEN);
 //
 //    int len = 0;
 //    len += 1;
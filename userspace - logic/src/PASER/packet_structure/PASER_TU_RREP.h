@@ -66,9 +66,9 @@ public:
     virtual PASER_TU_RREP *dup() const {return new PASER_TU_RREP(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
 
-    uint8_t * getCompleteByteArray(int *l);
+    void writeCompleteFields(PASER_field_sink *sink);
 private:
     PASER_TU_RREP();
 };
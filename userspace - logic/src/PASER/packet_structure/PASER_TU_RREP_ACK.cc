@@ -284,89 +284,44 @@ std::string PASER_TU_RREP_ACK::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TU_RREP_ACK::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(destAddress_var.s_addr);
-    len += sizeof(seq);
-    len += sizeof(keyNr);
-
-    len += PASER_SECRET_LEN;
-    len += sizeof(auth.size());
-    len += auth.size() * SHA256_DIGEST_LENGTH;
-
+void PASER_TU_RREP_ACK::writeFields(PASER_field_sink *sink) {
     //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
-    //messageType
-    data[0] = 0x04;
-    buf++;
+    sink->writeByte(0x04);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     //Dest node
-    memcpy(buf, (uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
-    buf += sizeof(destAddress_var.s_addr);
+    sink->write((uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
     // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 
     // secret
-    memcpy(buf, secret, PASER_SECRET_LEN);
-    buf += PASER_SECRET_LEN;
+    sink->write(secret, PASER_SECRET_LEN);
     // authentication path
     int authLen = auth.size();
-    memcpy(buf, &authLen, sizeof(authLen));
-    buf += sizeof(authLen);
+    sink->write(&authLen, sizeof(authLen));
     for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
         uint8_t * temp = (uint8_t *) *it;
-        memcpy(buf, temp, SHA256_DIGEST_LENGTH);
-        buf += SHA256_DIGEST_LENGTH;
+        sink->write(temp, SHA256_DIGEST_LENGTH);
     }
-
-    *l = len;
-    return data;
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TU_RREP_ACK::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += PASER_SECRET_HASH_LEN; //MAC
-
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_TU_RREP_ACK::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
 
     //hash
-    memcpy(buf, (uint8_t *) hash, PASER_SECRET_HASH_LEN);
-    buf += PASER_SECRET_HASH_LEN;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) hash, PASER_SECRET_HASH_LEN);
 //
 //    int len = 0;
 //    len += 1;
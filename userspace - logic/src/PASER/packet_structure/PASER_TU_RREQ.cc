@@ -263,7 +263,7 @@ PASER_TU_RREQ* PASER_TU_RREQ::create(uint8_t *packet, u_int32_t l) {
         length += sizeof(tempCertL);
 
         // read Certificate
-        if ((length + tempCertL) > l) {
+        if (tempCertL > l - length) {
             std::cout << "ERROR: Wrong Certificate." << std::endl;
             std::cout << "ERROR: cann't create PASER_TU_RREQ packet from given char array." << std::endl;
             return NULL;
@@ -588,182 +588,83 @@ std::string PASER_TU_RREQ::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TU_RREQ::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(destAddress_var.s_addr);
-    len += sizeof(seq);
-    len += sizeof(keyNr);
-    len += sizeof(seqForw);
-
-    len += sizeof(searchGW);
-    len += sizeof(GFlag);
-    len += sizeof(len); // groesse der Adl
-    for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
-        address_list temp = (address_list) *it;
-        len += sizeof(temp.ipaddr.s_addr);
-        len += sizeof(len); // groesse der add_r
-        for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
-            struct in_addr temp_addr;
-            temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            len += sizeof(temp_addr.s_addr);
-            temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            len += sizeof(temp_addr.s_addr);
-        }
-    }
-    len += sizeof(metricBetweenQueryingAndForw);
-    if (GFlag) {
-        len += sizeof(nonce);
-        len += sizeof(cert.len);
-        len += cert.len;
-    }
-    len += sizeof(geoQuerying.lat);
-    len += sizeof(geoQuerying.lon);
-    len += sizeof(geoForwarding.lat);
-    len += sizeof(geoForwarding.lon);
-
-    //secret
-    len += PASER_SECRET_LEN;
-
-    // auth
-    len += sizeof(auth.size());
-    for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        len += SHA256_DIGEST_LENGTH;
-    }
-
-    //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
+void PASER_TU_RREQ::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x02;
-    buf++;
+    sink->writeByte(0x02);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     //Dest node
-    memcpy(buf, (uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
-    buf += sizeof(destAddress_var.s_addr);
+    sink->write((uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
     // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 
     // Forwarding Sequence number
-    memcpy(buf, (uint8_t *) &seqForw, sizeof(seqForw));
-    buf += sizeof(seqForw);
+    sink->write((uint8_t *) &seqForw, sizeof(seqForw));
     // SearchGW
-    if (searchGW)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(searchGW);
+    sink->writeByte(searchGW ? 0x01 : 0x00);
     // GFlag
-    if (GFlag)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(GFlag);
+    sink->writeByte(GFlag ? 0x01 : 0x00);
     // AddL
     // Groesse der ADL
     int tempListSize = AddressRangeList.size();
-    memcpy(buf, (uint8_t *) &tempListSize, sizeof(tempListSize));
-    buf += sizeof(tempListSize);
+    sink->write((uint8_t *) &tempListSize, sizeof(tempListSize));
     for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
         address_list temp = (address_list) *it;
-        memcpy(buf, (uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
-        buf += sizeof(temp.ipaddr.s_addr);
+        sink->write((uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
         // Groesse der address_range
         int tempAdd = temp.range.size();
-        memcpy(buf, (uint8_t *) &tempAdd, sizeof(tempAdd));
-        buf += sizeof(tempAdd);
+        sink->write((uint8_t *) &tempAdd, sizeof(tempAdd));
         for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
             struct in_addr temp_addr;
             temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
             temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
         }
     }
     // Metric
-    memcpy(buf, (uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
-    buf += sizeof(metricBetweenQueryingAndForw);
+    sink->write((uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
     // Cert of querying node
     if (GFlag) {
-        memcpy(buf, (uint8_t *) &nonce, sizeof(nonce));
-        buf += sizeof(nonce);
-        memcpy(buf, (uint8_t *) &cert.len, sizeof(cert.len));
-        buf += sizeof(cert.len);
-        memcpy(buf, cert.buf, cert.len);
-        buf += cert.len;
+        sink->write((uint8_t *) &nonce, sizeof(nonce));
+        sink->write((uint8_t *) &cert.len, sizeof(cert.len));
+        sink->write(cert.buf, cert.len);
     }
 
     // GEO of querying node
-    memcpy(buf, (uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
-    buf += sizeof(geoQuerying.lat);
-    memcpy(buf, (uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
-    buf += sizeof(geoQuerying.lon);
+    sink->write((uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
+    sink->write((uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
     // GEO of forwarding node
-    memcpy(buf, (uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
-    buf += sizeof(geoForwarding.lat);
-    memcpy(buf, (uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
-    buf += sizeof(geoForwarding.lon);
+    sink->write((uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
+    sink->write((uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
 
     // secret
-    memcpy(buf, (uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
-    buf += sizeof(uint8_t) * PASER_SECRET_LEN;
+    sink->write((uint8_t *) secret, (sizeof(uint8_t) * PASER_SECRET_LEN));
     // auth
     int authLen = auth.size();
-    memcpy(buf, &authLen, sizeof(authLen));
-    buf += sizeof(authLen);
+    sink->write(&authLen, sizeof(authLen));
     for (std::list<uint8_t *>::iterator it = auth.begin(); it != auth.end(); it++) {
-        memcpy(buf, (uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
-        buf += sizeof(uint8_t) * SHA256_DIGEST_LENGTH;
+        sink->write((uint8_t *) *it, (sizeof(uint8_t) * SHA256_DIGEST_LENGTH));
     }
-
-    *l = len;
-    return data;
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_TU_RREQ::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += PASER_SECRET_HASH_LEN; //MAC
-
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_TU_RREQ::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
 
     //hash
-    memcpy(buf, (uint8_t *) hash, PASER_SECRET_HASH_LEN);
-    buf += PASER_SECRET_HASH_LEN;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) hash, PASER_SECRET_HASH_LEN);
 //
 //    int len = 0;
 //    len += 1;
@@ -64,8 +64,8 @@ public:
     virtual PASER_TU_RREQ *dup() const {return new PASER_TU_RREQ(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
-    uint8_t * getCompleteByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
+    void writeCompleteFields(PASER_field_sink *sink);
 private:
     PASER_TU_RREQ();
 };
@@ -21,6 +21,7 @@
  ********************************************************************************/
 
 #include "PASER_UB_RREQ.h"
+#include "PASER_UB_RREQ_view.h"
 #include <openssl/sha.h>
 #include <openssl/x509.h>
 
@@ -80,420 +81,58 @@ PASER_UB_RREQ::~PASER_UB_RREQ() {
 }
 
 PASER_UB_RREQ* PASER_UB_RREQ::create(uint8_t *packet, u_int32_t l) {
-    int length = 0;
-    uint8_t *pointer;
-    pointer = packet;
-    if (l < 1) {
-        std::cout << "ERROR: Wrong packet length(Length < 1)." << std::endl;
+    PASER_UB_RREQ_view view;
+    if (!view.parse(packet, l)) {
+        std::cout << "ERROR: Wrong " << view.error << "." << std::endl;
         std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
         return NULL;
     }
-    // read packet type
-    if (packet[0] != 0x00) {
-        std::cout << "ERROR: Wrong packet type." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    length++;
-    pointer++;
-
-    // read IP address of source node
-    in_addr tempSrcAddr;
-    if ((length + sizeof(tempSrcAddr.s_addr)) > l) {
-        std::cout << "ERROR: Wrong SrcAddr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSrcAddr.s_addr, pointer, sizeof(tempSrcAddr.s_addr));
-    pointer += sizeof(tempSrcAddr.s_addr);
-    length += sizeof(tempSrcAddr.s_addr);
-
-    // read IP address of destination node
-    in_addr tempDestAddr;
-    if ((length + sizeof(tempDestAddr.s_addr)) > l) {
-        std::cout << "ERROR: Wrong DestAddr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempDestAddr.s_addr, pointer, sizeof(tempDestAddr.s_addr));
-    pointer += sizeof(tempDestAddr.s_addr);
-    length += sizeof(tempDestAddr.s_addr);
-
-    // read Sending node's current sequence number
-    u_int32_t tempSeq;
-    if ((length + sizeof(tempSeq)) > l) {
-        std::cout << "ERROR: Wrong SeqNr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSeq, pointer, sizeof(tempSeq));
-    pointer += sizeof(tempSeq);
-    length += sizeof(tempSeq);
-
-    // read GTK number
-    u_int32_t tempKeyNr;
-    if ((length + sizeof(tempKeyNr)) > l) {
-        std::cout << "ERROR: Wrong KeyNr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempKeyNr, pointer, sizeof(tempKeyNr));
-    pointer += sizeof(tempKeyNr);
-    length += sizeof(tempKeyNr);
-
-    // read forwarding node's sequence number
-    u_int32_t tempSeqForw;
-    if ((length + sizeof(tempSeqForw)) > l) {
-        std::cout << "ERROR: Wrong SeqForw." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSeqForw, pointer, sizeof(tempSeqForw));
-    pointer += sizeof(tempSeqForw);
-    length += sizeof(tempSeqForw);
-
-    // read searchGW
-    uint8_t tempSearchGW;
-    if ((length + sizeof(tempSearchGW)) > l) {
-        std::cout << "ERROR: Wrong tempSearchGW." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSearchGW, pointer, sizeof(tempSearchGW));
-    length++;
-    pointer++;
-
-    // read GFlag
-    uint8_t tempGFlag;
-    if ((length + sizeof(tempGFlag)) > l) {
-        std::cout << "ERROR: Wrong GFlag." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGFlag, pointer, sizeof(tempGFlag));
-    length++;
-    pointer++;
-
-    // read length of AddressRangeList
-    u_int32_t tempAddrRangeListLength;
-    if ((length + sizeof(tempAddrRangeListLength)) > l) {
-        std::cout << "ERROR: Wrong length of AddressRangeList." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempAddrRangeListLength, pointer, sizeof(tempAddrRangeListLength));
-    pointer += sizeof(tempAddrRangeListLength);
-    length += sizeof(tempAddrRangeListLength);
-
-    // read AddressRangeList
-    std::list<address_list> tempAddressRangeList;
-    for (u_int32_t i = 0; i < tempAddrRangeListLength; i++) {
-        // read address
-        in_addr tempAddr;
-        if ((length + sizeof(tempAddr.s_addr)) > l) {
-            std::cout << "ERROR: Wrong Addr. i=" << i << std::endl;
-            std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempAddr.s_addr, pointer, sizeof(tempAddr.s_addr));
-        pointer += sizeof(tempAddr.s_addr);
-        length += sizeof(tempAddr.s_addr);
-        // read subnetwork list length
-        u_int32_t tempSubnetworkLength;
-        if ((length + sizeof(tempSubnetworkLength)) > l) {
-            std::cout << "ERROR: Wrong length of AddressRangeList." << std::endl;
-            std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempSubnetworkLength, pointer, sizeof(tempSubnetworkLength));
-        pointer += sizeof(tempSubnetworkLength);
-        length += sizeof(tempSubnetworkLength);
-
-        // read subnetwork
-        std::list<address_range> subnetwork;
-        for (u_int32_t j = 0; j < tempSubnetworkLength; j++) {
-            //read subnetwork IP
-            in_addr tempSubnetworkIP;
-            if ((length + sizeof(tempSubnetworkIP.s_addr)) > l) {
-                std::cout << "ERROR: Wrong Addr. i=" << i << " j= " << j << std::endl;
-                std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-                return NULL;
-            }
-            memcpy((uint8_t *) &tempSubnetworkIP.s_addr, pointer, sizeof(tempSubnetworkIP.s_addr));
-            pointer += sizeof(tempSubnetworkIP.s_addr);
-            length += sizeof(tempSubnetworkIP.s_addr);
-            //read subnetwork MASK
-            in_addr tempSubnetworkMask;
-            if ((length + sizeof(tempSubnetworkMask.s_addr)) > l) {
-                std::cout << "ERROR: Wrong Mask. i=" << i << " j= " << j << std::endl;
-                std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-                return NULL;
-            }
-            memcpy((uint8_t *) &tempSubnetworkMask.s_addr, pointer, sizeof(tempSubnetworkMask.s_addr));
-            pointer += sizeof(tempSubnetworkMask.s_addr);
-            length += sizeof(tempSubnetworkMask.s_addr);
-
-            address_range tempAddRange;
-            tempAddRange.ipaddr.s_addr = tempSubnetworkIP.s_addr;
-            tempAddRange.mask.s_addr = tempSubnetworkMask.s_addr;
-
-            subnetwork.push_back(tempAddRange);
-        }
+    return create(&view);
+}
 
-        address_list tempAddrList;
+PASER_UB_RREQ* PASER_UB_RREQ::create(const PASER_UB_RREQ_view *view) {
+    PASER_UB_RREQ *tempPacket = new PASER_UB_RREQ();
+    tempPacket->type = UB_RREQ;
+    tempPacket->timestamp = view->timestamp;
+    tempPacket->srcAddress_var.s_addr = view->srcAddress_var.s_addr;
+    tempPacket->destAddress_var.s_addr = view->destAddress_var.s_addr;
+    tempPacket->seq = view->seq;
+    tempPacket->seqForw = view->seqForw;
+    tempPacket->searchGW = view->searchGW;
+    tempPacket->GFlag = view->GFlag;
+
+    PASER_wire_reader list = view->getAddressList();
+    struct in_addr tempAddr;
+    lv_block tempRanges;
+    while (PASER_UB_RREQ_view::nextAddress(&list, &tempAddr, &tempRanges)) {
+        tempPacket->AddressRangeList.push_back(address_list());
+        address_list &tempAddrList = tempPacket->AddressRangeList.back();
         tempAddrList.ipaddr.s_addr = tempAddr.s_addr;
-        tempAddrList.range.assign(subnetwork.begin(), subnetwork.end());
-        tempAddressRangeList.push_back(tempAddrList);
-    }
-
-    // read Metric for the route between querying node and forwarding node
-    uint8_t tempMetricBetweenQueryingAndForw;
-    if ((length + sizeof(tempMetricBetweenQueryingAndForw)) > l) {
-        std::cout << "ERROR: Wrong MetricBetweenQueryingAndForw." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempMetricBetweenQueryingAndForw, pointer, sizeof(tempMetricBetweenQueryingAndForw));
-    pointer += sizeof(tempMetricBetweenQueryingAndForw);
-    length += sizeof(tempMetricBetweenQueryingAndForw);
-
-    u_int32_t tempNonce;
-    u_int32_t tempCertL;
-    u_int8_t * tempCert;
-    if (tempGFlag) {
-        // read nonce
-        if ((length + sizeof(tempNonce)) > l) {
-            std::cout << "ERROR: Wrong nonce." << std::endl;
-            std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempNonce, pointer, sizeof(tempNonce));
-        pointer += sizeof(tempNonce);
-        length += sizeof(tempNonce);
-
-        // read Certificate length
-        if ((length + sizeof(tempCertL)) > l) {
-            std::cout << "ERROR: Wrong length of Certificate." << std::endl;
-            std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempCertL, pointer, sizeof(tempCertL));
-        pointer += sizeof(tempCertL);
-        length += sizeof(tempCertL);
-
-        // read Certificate
-        if ((length + tempCertL) > l) {
-            std::cout << "ERROR: Wrong Certificate." << std::endl;
-            std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-            return NULL;
-        }
-        tempCert = (uint8_t *) malloc(tempCertL);
-        memcpy((uint8_t *) tempCert, pointer, tempCertL);
-        pointer += tempCertL;
-        length += tempCertL;
-    }
-
-    // read Certificate length
-    u_int32_t tempCertForwL;
-    if ((length + sizeof(tempCertForwL)) > l) {
-        std::cout << "ERROR: Wrong length of Certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempCertForwL, pointer, sizeof(tempCertForwL));
-    pointer += sizeof(tempCertForwL);
-    length += sizeof(tempCertForwL);
-
-    // read Certificate
-    u_int8_t * tempCertForw;
-    if ((length + tempCertForwL) > l) {
-        std::cout << "ERROR: Wrong Certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        if (tempGFlag) {
-            free(tempCert);
+        PASER_wire_reader ranges(tempRanges.buf, tempRanges.len);
+        address_range tempAddRange;
+        while (ranges.read(&tempAddRange.ipaddr.s_addr) && ranges.read(&tempAddRange.mask.s_addr)) {
+            tempAddrList.range.push_back(tempAddRange);
         }
-        return NULL;
     }
-    tempCertForw = (uint8_t *) malloc(tempCertForwL);
-    memcpy((uint8_t *) tempCertForw, pointer, tempCertForwL);
-    pointer += tempCertForwL;
-    length += tempCertForwL;
-
-    // read Root
-    u_int8_t * tempRoot;
-    if ((length + PASER_SECRET_HASH_LEN) > l) {
-        std::cout << "ERROR: Wrong Root." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    tempRoot = (uint8_t *) malloc(PASER_SECRET_HASH_LEN);
-    memcpy((uint8_t *) tempRoot, pointer, PASER_SECRET_HASH_LEN);
-    pointer += PASER_SECRET_HASH_LEN;
-    length += PASER_SECRET_HASH_LEN;
-
-    // read IV
-    u_int32_t tempIV;
-    if ((length + sizeof(tempIV)) > l) {
-        std::cout << "ERROR: Wrong IV." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempIV, pointer, sizeof(tempIV));
-    pointer += sizeof(tempIV);
-    length += sizeof(tempIV);
-
-    // Geographical position of sending node (lat)
-    double tempGeoQuerLat;
-    if ((length + sizeof(tempGeoQuerLat)) > l) {
-        std::cout << "ERROR: Wrong GeoDestLat." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoQuerLat, pointer, sizeof(tempGeoQuerLat));
-    pointer += sizeof(tempGeoQuerLat);
-    length += sizeof(tempGeoQuerLat);
-
-    // read Geographical position of sending node (lon)
-    double tempGeoQuerLon;
-    if ((length + sizeof(tempGeoQuerLon)) > l) {
-        std::cout << "ERROR: Wrong GeoDestLon." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoQuerLon, pointer, sizeof(tempGeoQuerLon));
-    pointer += sizeof(tempGeoQuerLon);
-    length += sizeof(tempGeoQuerLon);
-
-    // Geographical position of sending node (lat)
-    double tempGeoForwLat;
-    if ((length + sizeof(tempGeoForwLat)) > l) {
-        std::cout << "ERROR: Wrong GeoForwLat." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoForwLat, pointer, sizeof(tempGeoForwLat));
-    pointer += sizeof(tempGeoForwLat);
-    length += sizeof(tempGeoForwLat);
-
-    // read Geographical position of sending node (lon)
-    double tempGeoForwLon;
-    if ((length + sizeof(tempGeoForwLon)) > l) {
-        std::cout << "ERROR: Wrong GeoForwLon." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoForwLon, pointer, sizeof(tempGeoForwLon));
-    pointer += sizeof(tempGeoForwLon);
-    length += sizeof(tempGeoForwLon);
-
-    // read Sending time
-    unsigned long tempTime;
-    if ((length + sizeof(tempTime)) > l) {
-        std::cout << "ERROR: Wrong Timestamp." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempTime, pointer, sizeof(tempTime));
-    pointer += sizeof(tempTime);
-    length += sizeof(tempTime);
-
-    // read Length of Signature
-    u_int32_t tempSignL;
-    if ((length + sizeof(tempSignL)) > l) {
-        std::cout << "ERROR: Wrong length of signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSignL, pointer, sizeof(tempSignL));
-    pointer += sizeof(tempSignL);
-    length += sizeof(tempSignL);
-
-    // read Signature
-    u_int8_t * tempSign;
-    if ((length + tempSignL) > l) {
-        std::cout << "ERROR: Wrong signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        free(tempRoot);
-        if (tempGFlag) {
-            free(tempCert);
-        }
-        return NULL;
-    }
-    tempSign = (uint8_t *) malloc(tempSignL);
-    memcpy((uint8_t *) tempSign, pointer, tempSignL);
-    pointer += tempSignL;
-    length += tempSignL;
-
-    PASER_UB_RREQ *tempPacket = new PASER_UB_RREQ();
-    tempPacket->type = UB_RREQ;
-    tempPacket->timestamp = tempTime;
-    tempPacket->srcAddress_var.s_addr = tempSrcAddr.s_addr;
-    tempPacket->destAddress_var.s_addr = tempDestAddr.s_addr;
-    tempPacket->seq = tempSeq;
-    tempPacket->seqForw = tempSeqForw;
-    tempPacket->searchGW = tempSearchGW;
-    tempPacket->GFlag = tempGFlag;
-    tempPacket->AddressRangeList.assign(tempAddressRangeList.begin(), tempAddressRangeList.end());
-    tempPacket->metricBetweenQueryingAndForw = tempMetricBetweenQueryingAndForw;
+    tempPacket->metricBetweenQueryingAndForw = view->metricBetweenQueryingAndForw;
     if (tempPacket->GFlag) {
-        tempPacket->nonce = tempNonce;
-        tempPacket->cert.len = tempCertL;
-        tempPacket->cert.buf = tempCert;
-    }
-    tempPacket->certForw.len = tempCertForwL;
-    tempPacket->certForw.buf = tempCertForw;
-    tempPacket->root = tempRoot;
-    tempPacket->initVector = tempIV;
-    tempPacket->geoQuerying.lat = tempGeoQuerLat;
-    tempPacket->geoQuerying.lon = tempGeoQuerLon;
-    tempPacket->geoForwarding.lat = tempGeoForwLat;
-    tempPacket->geoForwarding.lon = tempGeoForwLon;
-    tempPacket->keyNr = tempKeyNr;
-    tempPacket->sign.len = tempSignL;
-    tempPacket->sign.buf = tempSign;
+        tempPacket->nonce = view->nonce;
+        tempPacket->cert.len = view->cert.len;
+        tempPacket->cert.buf = (uint8_t *) malloc(view->cert.len);
+        memcpy(tempPacket->cert.buf, view->cert.buf, view->cert.len);
+    }
+    tempPacket->certForw.len = view->certForw.len;
+    tempPacket->certForw.buf = (uint8_t *) malloc(view->certForw.len);
+    memcpy(tempPacket->certForw.buf, view->certForw.buf, view->certForw.len);
+    tempPacket->root = (uint8_t *) malloc(PASER_SECRET_HASH_LEN);
+    memcpy(tempPacket->root, view->root.buf, PASER_SECRET_HASH_LEN);
+    tempPacket->initVector = view->initVector;
+    tempPacket->geoQuerying = view->geoQuerying;
+    tempPacket->geoForwarding = view->geoForwarding;
+    tempPacket->keyNr = view->keyNr;
+    tempPacket->sign.len = view->sign.len;
+    tempPacket->sign.buf = (uint8_t *) malloc(view->sign.len);
+    memcpy(tempPacket->sign.buf, view->sign.buf, view->sign.len);
     return tempPacket;
 }
 
@@ -630,180 +269,82 @@ std::string PASER_UB_RREQ::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_UB_RREQ::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(destAddress_var.s_addr);
-    len += sizeof(seq);
-    len += sizeof(keyNr);
-    len += sizeof(seqForw);
-
-    len += sizeof(searchGW);
-    len += sizeof(GFlag);
-    len += sizeof(len); // groesse der Adl
-    for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
-        address_list temp = (address_list) *it;
-        len += sizeof(temp.ipaddr.s_addr);
-        len += sizeof(len); // groesse der add_r
-        for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
-            struct in_addr temp_addr;
-            temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            len += sizeof(temp_addr.s_addr);
-            temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            len += sizeof(temp_addr.s_addr);
-        }
-    }
-    len += sizeof(metricBetweenQueryingAndForw);
-    if (GFlag) {
-        len += sizeof(nonce); //nonce
-        len += sizeof(cert.len);
-        len += cert.len;
-    }
-    len += sizeof(certForw.len);
-    len += certForw.len;
-    len += 32;
-    len += sizeof(initVector);
-    len += sizeof(geoQuerying.lat);
-    len += sizeof(geoQuerying.lon);
-    len += sizeof(geoForwarding.lat);
-    len += sizeof(geoForwarding.lon);
-    len += sizeof(timestamp);
-
-    //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    buf = data;
+void PASER_UB_RREQ::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x00;
-    buf++;
+    sink->writeByte(0x00);
 
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     //Dest node
-    memcpy(buf, (uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
-    buf += sizeof(destAddress_var.s_addr);
+    sink->write((uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
     // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 
     // Forwarding Sequence number
-    memcpy(buf, (uint8_t *) &seqForw, sizeof(seqForw));
-    buf += sizeof(seqForw);
+    sink->write((uint8_t *) &seqForw, sizeof(seqForw));
     // SearchGW
-    if (searchGW)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(searchGW);
+    sink->writeByte(searchGW ? 0x01 : 0x00);
     // GFlag
-    if (GFlag)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(GFlag);
+    sink->writeByte(GFlag ? 0x01 : 0x00);
     // AddL
     // Groesse der ADL
     int tempListSize = AddressRangeList.size();
-    memcpy(buf, (uint8_t *) &tempListSize, sizeof(tempListSize));
-    buf += sizeof(tempListSize);
+    sink->write((uint8_t *) &tempListSize, sizeof(tempListSize));
     for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
         address_list temp = (address_list) *it;
-        memcpy(buf, (uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
-        buf += sizeof(temp.ipaddr.s_addr);
+        sink->write((uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
         // Groesse der address_range
         int tempAdd = temp.range.size();
-        memcpy(buf, (uint8_t *) &tempAdd, sizeof(tempAdd));
-        buf += sizeof(tempAdd);
+        sink->write((uint8_t *) &tempAdd, sizeof(tempAdd));
         for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
             struct in_addr temp_addr;
             temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
             temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
         }
     }
     // Metric
-    memcpy(buf, (uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
-    buf += sizeof(metricBetweenQueryingAndForw);
+    sink->write((uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
     // Cert of querying node
     if (GFlag) {
-        memcpy(buf, (uint8_t *) &nonce, sizeof(nonce));
-        buf += sizeof(nonce);
-        memcpy(buf, (uint8_t *) &cert.len, sizeof(cert.len));
-        buf += sizeof(cert.len);
-        memcpy(buf, cert.buf, cert.len);
-        buf += cert.len;
+        sink->write((uint8_t *) &nonce, sizeof(nonce));
+        sink->write((uint8_t *) &cert.len, sizeof(cert.len));
+        sink->write(cert.buf, cert.len);
     }
     // Cert of forwarding node
-    memcpy(buf, (uint8_t *) &certForw.len, sizeof(certForw.len));
-    buf += sizeof(certForw.len);
-    memcpy(buf, certForw.buf, certForw.len);
-    buf += certForw.len;
+    sink->write((uint8_t *) &certForw.len, sizeof(certForw.len));
+    sink->write(certForw.buf, certForw.len);
     // root
-    memcpy(buf, root, 32);
-    buf += 32;
+    sink->write(root, 32);
     // IV
-    memcpy(buf, (uint8_t *) &initVector, sizeof(initVector));
-    buf += sizeof(initVector);
+    sink->write((uint8_t *) &initVector, sizeof(initVector));
     // GEO of querying node
-    memcpy(buf, (uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
-    buf += sizeof(geoQuerying.lat);
-    memcpy(buf, (uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
-    buf += sizeof(geoQuerying.lon);
+    sink->write((uint8_t *) &geoQuerying.lat, sizeof(geoQuerying.lat));
+    sink->write((uint8_t *) &geoQuerying.lon, sizeof(geoQuerying.lon));
     // GEO of forwarding node
-    memcpy(buf, (uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
-    buf += sizeof(geoForwarding.lat);
-    memcpy(buf, (uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
-    buf += sizeof(geoForwarding.lon);
+    sink->write((uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
+    sink->write((uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
     //timestamp
-    memcpy(buf, (uint8_t *) &timestamp, sizeof(timestamp));
-    buf += sizeof(timestamp);
-
-    *l = len;
-    return data;
+    sink->write((uint8_t *) &timestamp, sizeof(timestamp));
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_UB_RREQ::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += sizeof(sign.len); // Length of signature
-    lengthNew += sign.len; // Signature
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_UB_RREQ::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
     //sign
-    memcpy(buf, (uint8_t *) &sign.len, sizeof(sign.len));
-    buf += sizeof(sign.len);
-    memcpy(buf, sign.buf, sign.len);
-    buf += sign.len;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) &sign.len, sizeof(sign.len));
+    sink->write(sign.buf, sign.len);
 
 //    int len = 0;
 //    len += 1;
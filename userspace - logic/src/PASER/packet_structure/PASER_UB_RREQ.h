@@ -30,6 +30,8 @@
 
 #include "PASER_MSG.h"
 
+class PASER_UB_RREQ_view;
+
 /**
  * Implementation of PASER_UB_RREQ classes
  */
@@ -60,6 +62,11 @@ public:
 	PASER_UB_RREQ(struct in_addr src, struct in_addr dest, u_int32_t seqNr);
 
     static PASER_UB_RREQ* create(uint8_t *packet, u_int32_t l);
+    /**
+     * Materialize a message from the view of a received UB-RREQ.
+     * The fields are copied, so the message outlives the receive buffer.
+     */
+    static PASER_UB_RREQ* create(const PASER_UB_RREQ_view *view);
 
 	~PASER_UB_RREQ();
 
@@ -67,8 +74,8 @@ public:
 	virtual PASER_UB_RREQ *dup() const {return new PASER_UB_RREQ(*this);}
 	std::string detailedInfo() const;
 
-	uint8_t * toByteArray(int *l);
-	uint8_t * getCompleteByteArray(int *l);
+	void writeFields(PASER_field_sink *sink);
+	void writeCompleteFields(PASER_field_sink *sink);
 private:
 	PASER_UB_RREQ();
 };
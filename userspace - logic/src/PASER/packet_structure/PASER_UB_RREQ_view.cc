@@ -0,0 +1,157 @@
+/**
+ *\class  		PASER_UB_RREQ_view
+ *@brief       	Class implements a read-only view of a received PASER_UB_RREQ message
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_UB_RREQ_view.h"
+
+PASER_UB_RREQ_view::PASER_UB_RREQ_view() {
+    srcAddress_var.s_addr = 0;
+    destAddress_var.s_addr = 0;
+    seq = 0;
+    keyNr = 0;
+    seqForw = 0;
+    searchGW = 0;
+    GFlag = 0;
+    addressCount = 0;
+    forwarding.s_addr = 0;
+    metricBetweenQueryingAndForw = 0;
+    nonce = 0;
+    cert.buf = NULL;
+    cert.len = 0;
+    certForw.buf = NULL;
+    certForw.len = 0;
+    root.buf = NULL;
+    root.len = 0;
+    initVector = 0;
+    geoQuerying.lat = 0;
+    geoQuerying.lon = 0;
+    geoForwarding.lat = 0;
+    geoForwarding.lon = 0;
+    timestamp = 0;
+    sign.buf = NULL;
+    sign.len = 0;
+    error = NULL;
+    addressList.buf = NULL;
+    addressList.len = 0;
+}
+
+int PASER_UB_RREQ_view::parse(const uint8_t *packet, u_int32_t l) {
+    PASER_wire_reader reader(packet, l);
+
+    // read packet type
+    uint8_t type;
+    if (!reader.read(&type) || type != 0x00) {
+        error = "packet type";
+        return 0;
+    }
+    if (!reader.read(&srcAddress_var.s_addr)) {
+        error = "SrcAddr";
+        return 0;
+    }
+    if (!reader.read(&destAddress_var.s_addr)) {
+        error = "DestAddr";
+        return 0;
+    }
+    if (!reader.read(&seq)) {
+        error = "SeqNr";
+        return 0;
+    }
+    if (!reader.read(&keyNr)) {
+        error = "KeyNr";
+        return 0;
+    }
+    if (!reader.read(&seqForw)) {
+        error = "SeqForw";
+        return 0;
+    }
+    if (!reader.read(&searchGW)) {
+        error = "searchGW";
+        return 0;
+    }
+    if (!reader.read(&GFlag)) {
+        error = "GFlag";
+        return 0;
+    }
+
+    // check the structure of the route list, the entries are read by nextAddress()
+    if (!reader.readAddressList(&addressCount, &addressList, &forwarding)) {
+        error = "AddressRangeList";
+        return 0;
+    }
+    // the route list contains at least the querying node
+    if (addressCount == 0) {
+        error = "AddressRangeList";
+        return 0;
+    }
+
+    if (!reader.read(&metricBetweenQueryingAndForw)) {
+        error = "MetricBetweenQueryingAndForw";
+        return 0;
+    }
+    if (GFlag) {
+        if (!reader.read(&nonce)) {
+            error = "nonce";
+            return 0;
+        }
+        if (!reader.readLVSpan(&cert)) {
+            error = "Certificate";
+            return 0;
+        }
+    }
+    if (!reader.readLVSpan(&certForw)) {
+        error = "Certificate";
+        return 0;
+    }
+    if (!reader.readSpan(PASER_SECRET_HASH_LEN, &root)) {
+        error = "Root";
+        return 0;
+    }
+    if (!reader.read(&initVector)) {
+        error = "IV";
+        return 0;
+    }
+    if (!reader.read(&geoQuerying.lat) || !reader.read(&geoQuerying.lon)) {
+        error = "GeoQuerying";
+        return 0;
+    }
+    if (!reader.read(&geoForwarding.lat) || !reader.read(&geoForwarding.lon)) {
+        error = "GeoForwarding";
+        return 0;
+    }
+    if (!reader.read(&timestamp)) {
+        error = "Timestamp";
+        return 0;
+    }
+    if (!reader.readLVSpan(&sign)) {
+        error = "signature";
+        return 0;
+    }
+    error = NULL;
+    return 1;
+}
+
+PASER_wire_reader PASER_UB_RREQ_view::getAddressList() const {
+    return PASER_wire_reader(addressList.buf, addressList.len);
+}
+
+int PASER_UB_RREQ_view::nextAddress(PASER_wire_reader *list, struct in_addr *addr, lv_block *ranges) {
+    return PASER_wire_reader::nextAddress(list, addr, ranges);
+}
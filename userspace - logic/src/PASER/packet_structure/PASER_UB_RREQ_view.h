@@ -0,0 +1,97 @@
+/**
+ *\class  		PASER_UB_RREQ_view
+ *@brief       	Class implements a read-only view of a received PASER_UB_RREQ message
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_UB_RREQ_view;
+
+#ifndef PASER_UB_RREQ_VIEW_H_
+#define PASER_UB_RREQ_VIEW_H_
+
+#include "../config/PASER_defs.h"
+#include "PASER_wire_reader.h"
+
+/**
+ * View of a received UB-RREQ. parse() checks the complete structure of
+ * the message and reads the fixed fields, but does not allocate anything:
+ * the route list is iterated lazily and the certificates, the root and the
+ * signature are spans into the receive buffer. The view is only valid as
+ * long as the receive buffer. PASER_UB_RREQ::create() materializes the
+ * message if it has to be kept (e.g. for the signature check).
+ */
+class PASER_UB_RREQ_view {
+public:
+    struct in_addr srcAddress_var;              ///< IP address of querying node
+    struct in_addr destAddress_var;             ///< IP address of destination node
+    u_int32_t seq;                              ///< Sequence number of querying node
+    u_int32_t keyNr;                            ///< Current number of GTK
+    u_int32_t seqForw;                          ///< Sequence number of forwarding node
+    uint8_t searchGW;                           ///< search for the gateway
+    uint8_t GFlag;                              ///< Gateway flag
+    u_int32_t addressCount;                     ///< Number of entries of the route list
+    struct in_addr forwarding;                  ///< IP address of the last entry of the route list (forwarding node)
+    uint8_t metricBetweenQueryingAndForw;       ///< Metric for the route between querying node and forwarding node
+    u_int32_t nonce;                            ///< Register nonce of querying node (only if GFlag is set)
+    lv_block cert;                              ///< Certificate of querying node (only if GFlag is set)
+    lv_block certForw;                          ///< Certificate of forwarding node
+    lv_block root;                              ///< Root element of forwarding node
+    u_int32_t initVector;                       ///< IV of forwarding node
+    geo_pos geoQuerying;                        ///< Geographical position of querying node
+    geo_pos geoForwarding;                      ///< Geographical position of forwarding node
+    long timestamp;                             ///< Sending or forwarding time
+    lv_block sign;                              ///< Signature of the packet
+
+    const char *error;                          ///< Name of the field which could not be read or NULL
+
+    PASER_UB_RREQ_view();
+
+    /**
+     * Check the structure of the char array and read the fixed fields.
+     *
+     *@param packet received char array
+     *@param l length of the char array
+     *
+     *@return 1 on successful or 0 if the array is no valid UB-RREQ.
+     *        <b>error</b> names the wrong field in this case.
+     */
+    int parse(const uint8_t *packet, u_int32_t l);
+
+    /**
+     * Get a reader over the route list. The entries are read with nextAddress().
+     */
+    PASER_wire_reader getAddressList() const;
+
+    /**
+     * Read the next entry of the route list. The structure of the list
+     * is checked by parse(), so the function only fails at the end.
+     *
+     *@param list reader returned by getAddressList()
+     *@param addr IP address of the entry
+     *@param ranges span of the subnetworks of the entry (pairs of IP address and mask)
+     *
+     *@return 1 on successful or 0 at the end of the list
+     */
+    static int nextAddress(PASER_wire_reader *list, struct in_addr *addr, lv_block *ranges);
+
+private:
+    lv_block addressList;                       ///< Span of the route list (without its length)
+};
+
+#endif /* PASER_UB_RREQ_VIEW_H_ */
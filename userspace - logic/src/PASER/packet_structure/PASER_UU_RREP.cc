@@ -21,6 +21,7 @@
  ********************************************************************************/
 
 #include "PASER_UU_RREP.h"
+#include "PASER_UU_RREP_view.h"
 #include <openssl/sha.h>
 #include <openssl/x509.h>
 
@@ -77,571 +78,66 @@ PASER_UU_RREP::~PASER_UU_RREP() {
 }
 
 PASER_UU_RREP* PASER_UU_RREP::create(uint8_t *packet, u_int32_t l) {
-    int length = 0;
-    uint8_t *pointer;
-    pointer = packet;
-    if (l < 1) {
-        std::cout << "ERROR: Wrong packet length(Length < 1)." << std::endl;
+    PASER_UU_RREP_view view;
+    if (!view.parse(packet, l)) {
+        std::cout << "ERROR: Wrong " << view.error << "." << std::endl;
         std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
         return NULL;
     }
-    // read packet type
-    if (packet[0] != 0x01) {
-        std::cout << "ERROR: Wrong packet type." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    length++;
-    pointer++;
-
-    // read IP address of source node
-    in_addr tempSrcAddr;
-    if ((length + sizeof(tempSrcAddr.s_addr)) > l) {
-        std::cout << "ERROR: Wrong SrcAddr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSrcAddr.s_addr, pointer, sizeof(tempSrcAddr.s_addr));
-    pointer += sizeof(tempSrcAddr.s_addr);
-    length += sizeof(tempSrcAddr.s_addr);
-
-    // read IP address of destination node
-    in_addr tempDestAddr;
-    if ((length + sizeof(tempDestAddr.s_addr)) > l) {
-        std::cout << "ERROR: Wrong DestAddr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempDestAddr.s_addr, pointer, sizeof(tempDestAddr.s_addr));
-    pointer += sizeof(tempDestAddr.s_addr);
-    length += sizeof(tempDestAddr.s_addr);
-
-    // read Sending node's current sequence number
-    u_int32_t tempSeq;
-    if ((length + sizeof(tempSeq)) > l) {
-        std::cout << "ERROR: Wrong SeqNr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSeq, pointer, sizeof(tempSeq));
-    pointer += sizeof(tempSeq);
-    length += sizeof(tempSeq);
-
-    // read GTK number
-    u_int32_t tempKeyNr;
-    if ((length + sizeof(tempKeyNr)) > l) {
-        std::cout << "ERROR: Wrong KeyNr." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempKeyNr, pointer, sizeof(tempKeyNr));
-    pointer += sizeof(tempKeyNr);
-    length += sizeof(tempKeyNr);
-
-    // read searchGW
-    uint8_t tempSearchGW;
-    if ((length + sizeof(tempSearchGW)) > l) {
-        std::cout << "ERROR: Wrong tempSearchGW." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempSearchGW, pointer, sizeof(tempSearchGW));
-    length++;
-    pointer++;
-
-    // read GFlag
-    uint8_t tempGFlag;
-    if ((length + sizeof(tempGFlag)) > l) {
-        std::cout << "ERROR: Wrong GFlag." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGFlag, pointer, sizeof(tempGFlag));
-    length++;
-    pointer++;
-
-    // read length of AddressRangeList
-    u_int32_t tempAddrRangeListLength;
-    if ((length + sizeof(tempAddrRangeListLength)) > l) {
-        std::cout << "ERROR: Wrong length of AddressRangeList." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempAddrRangeListLength, pointer, sizeof(tempAddrRangeListLength));
-    pointer += sizeof(tempAddrRangeListLength);
-    length += sizeof(tempAddrRangeListLength);
-
-    // read AddressRangeList
-    std::list<address_list> tempAddressRangeList;
-    for (u_int32_t i = 0; i < tempAddrRangeListLength; i++) {
-        // read address
-        in_addr tempAddr;
-        if ((length + sizeof(tempAddr.s_addr)) > l) {
-            std::cout << "ERROR: Wrong Addr. i=" << i << std::endl;
-            std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempAddr.s_addr, pointer, sizeof(tempAddr.s_addr));
-        pointer += sizeof(tempAddr.s_addr);
-        length += sizeof(tempAddr.s_addr);
-        // read subnetwork list length
-        u_int32_t tempSubnetworkLength;
-        if ((length + sizeof(tempSubnetworkLength)) > l) {
-            std::cout << "ERROR: Wrong length of AddressRangeList." << std::endl;
-            std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempSubnetworkLength, pointer, sizeof(tempSubnetworkLength));
-        pointer += sizeof(tempSubnetworkLength);
-        length += sizeof(tempSubnetworkLength);
-
-        // read subnetwork
-        std::list<address_range> subnetwork;
-        for (u_int32_t j = 0; j < tempSubnetworkLength; j++) {
-            //read subnetwork IP
-            in_addr tempSubnetworkIP;
-            if ((length + sizeof(tempSubnetworkIP.s_addr)) > l) {
-                std::cout << "ERROR: Wrong Addr. i=" << i << " j= " << j << std::endl;
-                std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-                return NULL;
-            }
-            memcpy((uint8_t *) &tempSubnetworkIP.s_addr, pointer, sizeof(tempSubnetworkIP.s_addr));
-            pointer += sizeof(tempSubnetworkIP.s_addr);
-            length += sizeof(tempSubnetworkIP.s_addr);
-            //read subnetwork MASK
-            in_addr tempSubnetworkMask;
-            if ((length + sizeof(tempSubnetworkMask.s_addr)) > l) {
-                std::cout << "ERROR: Wrong Mask. i=" << i << " j= " << j << std::endl;
-                std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-                return NULL;
-            }
-            memcpy((uint8_t *) &tempSubnetworkMask.s_addr, pointer, sizeof(tempSubnetworkMask.s_addr));
-            pointer += sizeof(tempSubnetworkMask.s_addr);
-            length += sizeof(tempSubnetworkMask.s_addr);
-
-            address_range tempAddRange;
-            tempAddRange.ipaddr.s_addr = tempSubnetworkIP.s_addr;
-            tempAddRange.mask.s_addr = tempSubnetworkMask.s_addr;
-
-            subnetwork.push_back(tempAddRange);
-        }
+    return create(&view);
+}
 
-        address_list tempAddrList;
+PASER_UU_RREP* PASER_UU_RREP::create(const PASER_UU_RREP_view *view) {
+    PASER_UU_RREP *tempPacket = new PASER_UU_RREP();
+    tempPacket->type = UU_RREP;
+    tempPacket->timestamp = view->timestamp;
+    tempPacket->srcAddress_var.s_addr = view->srcAddress_var.s_addr;
+    tempPacket->destAddress_var.s_addr = view->destAddress_var.s_addr;
+    tempPacket->seq = view->seq;
+    tempPacket->keyNr = view->keyNr;
+    tempPacket->searchGW = view->searchGW;
+    tempPacket->GFlag = view->GFlag;
+
+    PASER_wire_reader list = view->getAddressList();
+    struct in_addr tempAddr;
+    lv_block tempRanges;
+    while (PASER_wire_reader::nextAddress(&list, &tempAddr, &tempRanges)) {
+        tempPacket->AddressRangeList.push_back(address_list());
+        address_list &tempAddrList = tempPacket->AddressRangeList.back();
         tempAddrList.ipaddr.s_addr = tempAddr.s_addr;
-        tempAddrList.range.assign(subnetwork.begin(), subnetwork.end());
-        tempAddressRangeList.push_back(tempAddrList);
-    }
-
-    // read Metric for the route between querying node and forwarding node
-    uint8_t tempMetricBetweenQueryingAndForw;
-    if ((length + sizeof(tempMetricBetweenQueryingAndForw)) > l) {
-        std::cout << "ERROR: Wrong MetricBetweenQueryingAndForw." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempMetricBetweenQueryingAndForw, pointer, sizeof(tempMetricBetweenQueryingAndForw));
-    pointer += sizeof(tempMetricBetweenQueryingAndForw);
-    length += sizeof(tempMetricBetweenQueryingAndForw);
-
-    // read Metric for the route between destination node and forwarding node
-    uint8_t tempMetricBetweenDestAndForw;
-    if ((length + sizeof(tempMetricBetweenDestAndForw)) > l) {
-        std::cout << "ERROR: Wrong MetricBetweenDestAndForw." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UU_RREP packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempMetricBetweenDestAndForw, pointer, sizeof(tempMetricBetweenDestAndForw));
-    pointer += sizeof(tempMetricBetweenDestAndForw);
-    length += sizeof(tempMetricBetweenDestAndForw);
-
-    // read Certificate length
-    u_int32_t tempCertForwL;
-    if ((length + sizeof(tempCertForwL)) > l) {
-        std::cout << "ERROR: Wrong length of Certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempCertForwL, pointer, sizeof(tempCertForwL));
-    pointer += sizeof(tempCertForwL);
-    length += sizeof(tempCertForwL);
-
-    // read Certificate
-    u_int8_t * tempCertForw;
-    if ((length + tempCertForwL) > l) {
-        std::cout << "ERROR: Wrong Certificate." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        return NULL;
-    }
-    tempCertForw = (uint8_t *) malloc(tempCertForwL);
-    memcpy((uint8_t *) tempCertForw, pointer, tempCertForwL);
-    pointer += tempCertForwL;
-    length += tempCertForwL;
-
-    // read Root
-    u_int8_t * tempRoot;
-    if ((length + PASER_SECRET_HASH_LEN) > l) {
-        std::cout << "ERROR: Wrong Root." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempCertForw);
-        return NULL;
-    }
-    tempRoot = (uint8_t *) malloc(PASER_SECRET_HASH_LEN);
-    memcpy((uint8_t *) tempRoot, pointer, PASER_SECRET_HASH_LEN);
-    pointer += PASER_SECRET_HASH_LEN;
-    length += PASER_SECRET_HASH_LEN;
-
-    // read IV
-    u_int32_t tempIV;
-    if ((length + sizeof(tempIV)) > l) {
-        std::cout << "ERROR: Wrong IV." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempIV, pointer, sizeof(tempIV));
-    pointer += sizeof(tempIV);
-    length += sizeof(tempIV);
-
-    // Geographical position of sending node (lat)
-    double tempGeoDestLat;
-    if ((length + sizeof(tempGeoDestLat)) > l) {
-        std::cout << "ERROR: Wrong GeoDestLat." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoDestLat, pointer, sizeof(tempGeoDestLat));
-    pointer += sizeof(tempGeoDestLat);
-    length += sizeof(tempGeoDestLat);
-
-    // read Geographical position of sending node (lon)
-    double tempGeoDestLon;
-    if ((length + sizeof(tempGeoDestLon)) > l) {
-        std::cout << "ERROR: Wrong GeoDestLon." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoDestLon, pointer, sizeof(tempGeoDestLon));
-    pointer += sizeof(tempGeoDestLon);
-    length += sizeof(tempGeoDestLon);
-
-    // Geographical position of sending node (lat)
-    double tempGeoForwLat;
-    if ((length + sizeof(tempGeoForwLat)) > l) {
-        std::cout << "ERROR: Wrong GeoForwLat." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoForwLat, pointer, sizeof(tempGeoForwLat));
-    pointer += sizeof(tempGeoForwLat);
-    length += sizeof(tempGeoForwLat);
-
-    // read Geographical position of sending node (lon)
-    double tempGeoForwLon;
-    if ((length + sizeof(tempGeoForwLon)) > l) {
-        std::cout << "ERROR: Wrong GeoForwLon." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempGeoForwLon, pointer, sizeof(tempGeoForwLon));
-    pointer += sizeof(tempGeoForwLon);
-    length += sizeof(tempGeoForwLon);
-
-    // If GFlag is set then read KDC Block
-    kdc_block tempKdcData;
-    if (tempGFlag) {
-        // read GTK length
-        u_int32_t tempGTKL;
-        if ((length + sizeof(tempGTKL)) > l) {
-            std::cout << "ERROR: Wrong length of GTK." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempGTKL, pointer, sizeof(tempGTKL));
-        pointer += sizeof(tempGTKL);
-        length += sizeof(tempGTKL);
-
-        // read GTK
-        u_int8_t * tempGTK;
-        if ((length + tempGTKL) > l) {
-            std::cout << "ERROR: Wrong GTK." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        tempGTK = (uint8_t *) malloc(tempGTKL);
-        memcpy((uint8_t *) tempGTK, pointer, tempGTKL);
-        pointer += tempGTKL;
-        length += tempGTKL;
-
-        // read nonce
-        u_int32_t tempNonce;
-        if ((length + sizeof(tempNonce)) > l) {
-            std::cout << "ERROR: Wrong nonce." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempRoot);
-            free(tempCertForw);
-            free(tempGTK);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempNonce, pointer, sizeof(tempNonce));
-        pointer += sizeof(tempNonce);
-        length += sizeof(tempNonce);
-
-        // read CRL length
-        u_int32_t tempCRLL;
-        if ((length + sizeof(tempCRLL)) > l) {
-            std::cout << "ERROR: Wrong length of CRL." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempRoot);
-            free(tempCertForw);
-            free(tempGTK);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempCRLL, pointer, sizeof(tempCRLL));
-        pointer += sizeof(tempCRLL);
-        length += sizeof(tempCRLL);
-
-        // read CRL
-        u_int8_t * tempCRL;
-        if ((length + tempCRLL) > l) {
-            std::cout << "ERROR: Wrong CRL." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempRoot);
-            free(tempCertForw);
-            free(tempGTK);
-            return NULL;
-        }
-        tempCRL = (uint8_t *) malloc(tempCRLL);
-        memcpy((uint8_t *) tempCRL, pointer, tempCRLL);
-        pointer += tempCRLL;
-        length += tempCRLL;
-
-        // read Length of KDC's certificate
-        u_int32_t tempCertKDCL;
-        if ((length + sizeof(tempCertKDCL)) > l) {
-            std::cout << "ERROR: Wrong Length of KDC's certificate." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempCertKDCL, pointer, sizeof(tempCertKDCL));
-        pointer += sizeof(tempCertKDCL);
-        length += sizeof(tempCertKDCL);
-
-        // read KDC's certificate
-        u_int8_t * tempCertKDC;
-        if ((length + tempCertKDCL) > l) {
-            std::cout << "ERROR: Wrong KDC's certificate." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        tempCertKDC = (uint8_t *) malloc(tempCertKDCL);
-        memcpy((uint8_t *) tempCertKDC, pointer, tempCertKDCL);
-        pointer += tempCertKDCL;
-        length += tempCertKDCL;
-
-        // read Length of KDC's signature
-        u_int32_t tempSignKDCL;
-        if ((length + sizeof(tempSignKDCL)) > l) {
-            std::cout << "ERROR: Wrong length of KDC's signature." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempCertKDC);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempSignKDCL, pointer, sizeof(tempSignKDCL));
-        pointer += sizeof(tempSignKDCL);
-        length += sizeof(tempSignKDCL);
-
-        // read KDC's signature
-        u_int8_t * tempSignKDC;
-        if ((length + tempSignKDCL) > l) {
-            std::cout << "ERROR: Wrong KDC's signature." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempCertKDC);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        tempSignKDC = (uint8_t *) malloc(tempSignKDCL);
-        memcpy((uint8_t *) tempSignKDC, pointer, tempSignKDCL);
-        pointer += tempSignKDCL;
-        length += tempSignKDCL;
-
-        // read KDC's key number
-        u_int32_t tempKDCKeyNr;
-        if ((length + sizeof(tempKDCKeyNr)) > l) {
-            std::cout << "ERROR: Wrong length of KDC's key number." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempCertKDC);
-            free(tempSignKDC);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempKDCKeyNr, pointer, sizeof(tempKDCKeyNr));
-        pointer += sizeof(tempKDCKeyNr);
-        length += sizeof(tempKDCKeyNr);
-
-        // read Length of key's signature
-        u_int32_t tempSignKeyL;
-        if ((length + sizeof(tempSignKeyL)) > l) {
-            std::cout << "ERROR: Wrong length of key's signature." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempCertKDC);
-            free(tempSignKDC);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
-        }
-        memcpy((uint8_t *) &tempSignKeyL, pointer, sizeof(tempSignKeyL));
-        pointer += sizeof(tempSignKeyL);
-        length += sizeof(tempSignKeyL);
-
-        // read key's signature
-        u_int8_t * tempSignKey;
-        if ((length + tempSignKeyL) > l) {
-            std::cout << "ERROR: Wrong key's signature." << std::endl;
-            std::cout << "ERROR: cann't create PASER_TU_RREP packet from given char array." << std::endl;
-            free(tempGTK);
-            free(tempCRL);
-            free(tempCertKDC);
-            free(tempSignKDC);
-            free(tempRoot);
-            free(tempCertForw);
-            return NULL;
+        PASER_wire_reader ranges(tempRanges.buf, tempRanges.len);
+        address_range tempAddRange;
+        while (ranges.read(&tempAddRange.ipaddr.s_addr) && ranges.read(&tempAddRange.mask.s_addr)) {
+            tempAddrList.range.push_back(tempAddRange);
         }
-        tempSignKey = (uint8_t *) malloc(tempSignKeyL);
-        memcpy((uint8_t *) tempSignKey, pointer, tempSignKeyL);
-        pointer += tempSignKeyL;
-        length += tempSignKeyL;
-
-        tempKdcData.GTK.len = tempGTKL;
-        tempKdcData.GTK.buf = tempGTK;
-        tempKdcData.nonce = tempNonce;
-        tempKdcData.CRL.len = tempCRLL;
-        tempKdcData.CRL.buf = tempCRL;
-        tempKdcData.cert_kdc.len = tempCertKDCL;
-        tempKdcData.cert_kdc.buf = tempCertKDC;
-        tempKdcData.sign.len = tempSignKDCL;
-        tempKdcData.sign.buf = tempSignKDC;
-        tempKdcData.key_nr = tempKDCKeyNr;
-        tempKdcData.sign_key.len = tempSignKeyL;
-        tempKdcData.sign_key.buf = tempSignKey;
-    }
-
-    // read Sending time
-    unsigned long tempTime;
-    if ((length + sizeof(tempTime)) > l) {
-        std::cout << "ERROR: Wrong Timestamp." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        if (tempGFlag) {
-            free(tempKdcData.GTK.buf);
-            free(tempKdcData.CRL.buf);
-            free(tempKdcData.cert_kdc.buf);
-            free(tempKdcData.sign.buf);
-            free(tempKdcData.sign_key.buf);
-        }
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    memcpy((uint8_t *) &tempTime, pointer, sizeof(tempTime));
-    pointer += sizeof(tempTime);
-    length += sizeof(tempTime);
-
-    // read Length of Signature
-    u_int32_t tempSignL;
-    if ((length + sizeof(tempSignL)) > l) {
-        std::cout << "ERROR: Wrong length of signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        if (tempGFlag) {
-            free(tempKdcData.GTK.buf);
-            free(tempKdcData.CRL.buf);
-            free(tempKdcData.cert_kdc.buf);
-            free(tempKdcData.sign.buf);
-            free(tempKdcData.sign_key.buf);
-        }
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
     }
-    memcpy((uint8_t *) &tempSignL, pointer, sizeof(tempSignL));
-    pointer += sizeof(tempSignL);
-    length += sizeof(tempSignL);
-
-    // read Signature
-    u_int8_t * tempSign;
-    if ((length + tempSignL) > l) {
-        std::cout << "ERROR: Wrong signature." << std::endl;
-        std::cout << "ERROR: cann't create PASER_UB_RREQ packet from given char array." << std::endl;
-        if (tempGFlag) {
-            free(tempKdcData.GTK.buf);
-            free(tempKdcData.CRL.buf);
-            free(tempKdcData.cert_kdc.buf);
-            free(tempKdcData.sign.buf);
-            free(tempKdcData.sign_key.buf);
-        }
-        free(tempRoot);
-        free(tempCertForw);
-        return NULL;
-    }
-    tempSign = (uint8_t *) malloc(tempSignL);
-    memcpy((uint8_t *) tempSign, pointer, tempSignL);
-    pointer += tempSignL;
-    length += tempSignL;
-
-    PASER_UU_RREP *tempPacket = new PASER_UU_RREP();
-    tempPacket->type = UU_RREP;
-    tempPacket->timestamp = tempTime;
-    tempPacket->srcAddress_var.s_addr = tempSrcAddr.s_addr;
-    tempPacket->destAddress_var.s_addr = tempDestAddr.s_addr;
-    tempPacket->seq = tempSeq;
-    tempPacket->searchGW = tempSearchGW;
-    tempPacket->GFlag = tempGFlag;
-    tempPacket->AddressRangeList.assign(tempAddressRangeList.begin(), tempAddressRangeList.end());
-    tempPacket->metricBetweenQueryingAndForw = tempMetricBetweenQueryingAndForw;
-    tempPacket->metricBetweenDestAndForw = tempMetricBetweenDestAndForw;
-    tempPacket->certForw.len = tempCertForwL;
-    tempPacket->certForw.buf = tempCertForw;
-    tempPacket->root = tempRoot;
-    tempPacket->initVector = tempIV;
-    tempPacket->geoDestination.lat = tempGeoDestLat;
-    tempPacket->geoDestination.lon = tempGeoDestLon;
-    tempPacket->geoForwarding.lat = tempGeoForwLat;
-    tempPacket->geoForwarding.lon = tempGeoForwLon;
-    tempPacket->kdc_data = tempKdcData;
-    tempPacket->keyNr = tempKeyNr;
-    tempPacket->sign.len = tempSignL;
-    tempPacket->sign.buf = tempSign;
+    tempPacket->metricBetweenQueryingAndForw = view->metricBetweenQueryingAndForw;
+    tempPacket->metricBetweenDestAndForw = view->metricBetweenDestAndForw;
+    tempPacket->certForw.len = view->certForw.len;
+    tempPacket->certForw.buf = (uint8_t *) malloc(view->certForw.len);
+    memcpy(tempPacket->certForw.buf, view->certForw.buf, view->certForw.len);
+    tempPacket->root = (uint8_t *) malloc(PASER_SECRET_HASH_LEN);
+    memcpy(tempPacket->root, view->root.buf, PASER_SECRET_HASH_LEN);
+    tempPacket->initVector = view->initVector;
+    tempPacket->geoDestination = view->geoDestination;
+    tempPacket->geoForwarding = view->geoForwarding;
+    if (tempPacket->GFlag) {
+        const kdc_block &kdc = view->kdc_data;
+        tempPacket->kdc_data = kdc;
+        tempPacket->kdc_data.GTK.buf = (uint8_t *) malloc(kdc.GTK.len);
+        memcpy(tempPacket->kdc_data.GTK.buf, kdc.GTK.buf, kdc.GTK.len);
+        tempPacket->kdc_data.CRL.buf = (uint8_t *) malloc(kdc.CRL.len);
+        memcpy(tempPacket->kdc_data.CRL.buf, kdc.CRL.buf, kdc.CRL.len);
+        tempPacket->kdc_data.cert_kdc.buf = (uint8_t *) malloc(kdc.cert_kdc.len);
+        memcpy(tempPacket->kdc_data.cert_kdc.buf, kdc.cert_kdc.buf, kdc.cert_kdc.len);
+        tempPacket->kdc_data.sign.buf = (uint8_t *) malloc(kdc.sign.len);
+        memcpy(tempPacket->kdc_data.sign.buf, kdc.sign.buf, kdc.sign.len);
+        tempPacket->kdc_data.sign_key.buf = (uint8_t *) malloc(kdc.sign_key.len);
+        memcpy(tempPacket->kdc_data.sign_key.buf, kdc.sign_key.buf, kdc.sign_key.len);
+    }
+    tempPacket->sign.len = view->sign.len;
+    tempPacket->sign.buf = (uint8_t *) malloc(view->sign.len);
+    memcpy(tempPacket->sign.buf, view->sign.buf, view->sign.len);
     return tempPacket;
 }
 
@@ -837,213 +333,96 @@ std::string PASER_UU_RREP::detailedInfo() const {
 }
 
 /**
- * Creates and return an array of all fields that must be secured with hash or signature
+ * Writes all fields that must be secured with hash or signature to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_UU_RREP::toByteArray(int *l) {
-    int len = 0;
-    len += 1;
-    len += sizeof(srcAddress_var.s_addr);
-    len += sizeof(destAddress_var.s_addr);
-    len += sizeof(seq);
-    len += sizeof(keyNr);
-
-    len += sizeof(searchGW);
-    len += sizeof(GFlag);
-    len += sizeof(len); // length of Adl
-    for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
-        address_list temp = (address_list) *it;
-        len += sizeof(temp.ipaddr.s_addr);
-        len += sizeof(len); // length of add_r
-        for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
-            struct in_addr temp_addr;
-            temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            len += sizeof(temp_addr.s_addr);
-            temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            len += sizeof(temp_addr.s_addr);
-        }
-    }
-    len += sizeof(metricBetweenQueryingAndForw);
-    len += sizeof(metricBetweenDestAndForw);
-    len += sizeof(certForw.len);
-    len += certForw.len;
-    len += SHA256_DIGEST_LENGTH;
-    len += sizeof(initVector);
-    len += sizeof(geoDestination.lat);
-    len += sizeof(geoDestination.lon);
-    len += sizeof(geoForwarding.lat);
-    len += sizeof(geoForwarding.lon);
-    if (GFlag) {
-        len += sizeof(kdc_data.GTK.len);
-        len += kdc_data.GTK.len;
-        len += sizeof(kdc_data.nonce);
-        len += sizeof(kdc_data.CRL.len);
-        len += kdc_data.CRL.len;
-        len += sizeof(kdc_data.cert_kdc.len);
-        len += kdc_data.cert_kdc.len;
-        len += sizeof(kdc_data.sign.len);
-        len += kdc_data.sign.len;
-        len += sizeof(kdc_data.key_nr);
-        len += sizeof(kdc_data.sign_key.len);
-        len += kdc_data.sign_key.len;
-    }
-    len += sizeof(timestamp);
-
-    //messageType
-    uint8_t *buf;
-    uint8_t *data = (uint8_t *) malloc(len);
-    memset(data, 0xEE, len);
-    buf = data;
+void PASER_UU_RREP::writeFields(PASER_field_sink *sink) {
     //messageType
-    data[0] = 0x01;
-    buf++;
+    sink->writeByte(0x01);
     //Querying node
-    memcpy(buf, (uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
-    buf += sizeof(srcAddress_var.s_addr);
+    sink->write((uint8_t *) &srcAddress_var.s_addr, sizeof(srcAddress_var.s_addr));
     //Dest node
-    memcpy(buf, (uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
-    buf += sizeof(destAddress_var.s_addr);
+    sink->write((uint8_t *) &destAddress_var.s_addr, sizeof(destAddress_var.s_addr));
     // Sequence number
-    memcpy(buf, (uint8_t *) &seq, sizeof(seq));
-    buf += sizeof(seq);
+    sink->write((uint8_t *) &seq, sizeof(seq));
     // Key number
-    memcpy(buf, (uint8_t *) &keyNr, sizeof(keyNr));
-    buf += sizeof(keyNr);
+    sink->write((uint8_t *) &keyNr, sizeof(keyNr));
 
     // searchGW
-    if (searchGW)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(searchGW);
+    sink->writeByte(searchGW ? 0x01 : 0x00);
     // GFlag
-    if (GFlag)
-        buf[0] = 0x01;
-    else
-        buf[0] = 0x00;
-    buf += sizeof(GFlag);
+    sink->writeByte(GFlag ? 0x01 : 0x00);
     // AddL
     // Length of ADL
     int tempListSize = AddressRangeList.size();
-    memcpy(buf, (uint8_t *) &tempListSize, sizeof(tempListSize));
-    buf += sizeof(tempListSize);
+    sink->write((uint8_t *) &tempListSize, sizeof(tempListSize));
     for (std::list<address_list>::iterator it = AddressRangeList.begin(); it != AddressRangeList.end(); it++) {
         address_list temp = (address_list) *it;
-        memcpy(buf, (uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
-        buf += sizeof(temp.ipaddr.s_addr);
+        sink->write((uint8_t *) &temp.ipaddr.s_addr, sizeof(temp.ipaddr.s_addr));
         // Groesse der address_range
         int tempAdd = temp.range.size();
-        memcpy(buf, (uint8_t *) &tempAdd, sizeof(tempAdd));
-        buf += sizeof(tempAdd);
+        sink->write((uint8_t *) &tempAdd, sizeof(tempAdd));
         for (std::list<address_range>::iterator it2 = temp.range.begin(); it2 != temp.range.end(); it2++) {
             struct in_addr temp_addr;
             temp_addr.s_addr = ((address_range) *it2).ipaddr.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
             temp_addr.s_addr = ((address_range) *it2).mask.s_addr;
-            memcpy(buf, (uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
-            buf += sizeof(temp_addr.s_addr);
+            sink->write((uint8_t *) &temp_addr.s_addr, sizeof(temp_addr.s_addr));
         }
     }
     // Metric
-    memcpy(buf, (uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
-    buf += sizeof(metricBetweenQueryingAndForw);
+    sink->write((uint8_t *) &metricBetweenQueryingAndForw, sizeof(metricBetweenQueryingAndForw));
     // Metric
-    memcpy(buf, (uint8_t *) &metricBetweenDestAndForw, sizeof(metricBetweenDestAndForw));
-    buf += sizeof(metricBetweenDestAndForw);
+    sink->write((uint8_t *) &metricBetweenDestAndForw, sizeof(metricBetweenDestAndForw));
     // Cert of forwarding node
-    memcpy(buf, (uint8_t *) &certForw.len, sizeof(certForw.len));
-    buf += sizeof(certForw.len);
-    memcpy(buf, certForw.buf, certForw.len);
-    buf += certForw.len;
+    sink->write((uint8_t *) &certForw.len, sizeof(certForw.len));
+    sink->write(certForw.buf, certForw.len);
     // root
-    memcpy(buf, root, SHA256_DIGEST_LENGTH);
-    buf += SHA256_DIGEST_LENGTH;
+    sink->write(root, SHA256_DIGEST_LENGTH);
     // IV
-    memcpy(buf, (uint8_t *) &initVector, sizeof(initVector));
-    buf += sizeof(initVector);
+    sink->write((uint8_t *) &initVector, sizeof(initVector));
     // GEO of geoDestination node
-    memcpy(buf, (uint8_t *) &geoDestination.lat, sizeof(geoDestination.lat));
-    buf += sizeof(geoDestination.lat);
-    memcpy(buf, (uint8_t *) &geoDestination.lon, sizeof(geoDestination.lon));
-    buf += sizeof(geoDestination.lon);
+    sink->write((uint8_t *) &geoDestination.lat, sizeof(geoDestination.lat));
+    sink->write((uint8_t *) &geoDestination.lon, sizeof(geoDestination.lon));
     // GEO of forwarding node
-    memcpy(buf, (uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
-    buf += sizeof(geoForwarding.lat);
-    memcpy(buf, (uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
-    buf += sizeof(geoForwarding.lon);
+    sink->write((uint8_t *) &geoForwarding.lat, sizeof(geoForwarding.lat));
+    sink->write((uint8_t *) &geoForwarding.lon, sizeof(geoForwarding.lon));
     // GTK
     if (GFlag) {
-        memcpy(buf, (uint8_t *) &kdc_data.GTK.len, sizeof(kdc_data.GTK.len));
-        buf += sizeof(kdc_data.GTK.len);
-        memcpy(buf, kdc_data.GTK.buf, kdc_data.GTK.len);
-        buf += kdc_data.GTK.len;
+        sink->write((uint8_t *) &kdc_data.GTK.len, sizeof(kdc_data.GTK.len));
+        sink->write(kdc_data.GTK.buf, kdc_data.GTK.len);
 
-        memcpy(buf, (uint8_t *) &kdc_data.nonce, sizeof(kdc_data.nonce));
-        buf += sizeof(kdc_data.nonce);
+        sink->write((uint8_t *) &kdc_data.nonce, sizeof(kdc_data.nonce));
 
-        memcpy(buf, (uint8_t *) &kdc_data.CRL.len, sizeof(kdc_data.CRL.len));
-        buf += sizeof(kdc_data.CRL.len);
-        memcpy(buf, kdc_data.CRL.buf, kdc_data.CRL.len);
-        buf += kdc_data.CRL.len;
+        sink->write((uint8_t *) &kdc_data.CRL.len, sizeof(kdc_data.CRL.len));
+        sink->write(kdc_data.CRL.buf, kdc_data.CRL.len);
 
-        memcpy(buf, (uint8_t *) &kdc_data.cert_kdc.len, sizeof(kdc_data.cert_kdc.len));
-        buf += sizeof(kdc_data.cert_kdc.len);
-        memcpy(buf, kdc_data.cert_kdc.buf, kdc_data.cert_kdc.len);
-        buf += kdc_data.cert_kdc.len;
+        sink->write((uint8_t *) &kdc_data.cert_kdc.len, sizeof(kdc_data.cert_kdc.len));
+        sink->write(kdc_data.cert_kdc.buf, kdc_data.cert_kdc.len);
 
-        memcpy(buf, (uint8_t *) &kdc_data.sign.len, sizeof(kdc_data.sign.len));
-        buf += sizeof(kdc_data.sign.len);
-        memcpy(buf, kdc_data.sign.buf, kdc_data.sign.len);
-        buf += kdc_data.sign.len;
+        sink->write((uint8_t *) &kdc_data.sign.len, sizeof(kdc_data.sign.len));
+        sink->write(kdc_data.sign.buf, kdc_data.sign.len);
 
-        memcpy(buf, (uint8_t *) &kdc_data.key_nr, sizeof(kdc_data.key_nr));
-        buf += sizeof(kdc_data.key_nr);
+        sink->write((uint8_t *) &kdc_data.key_nr, sizeof(kdc_data.key_nr));
 
-        memcpy(buf, (uint8_t *) &kdc_data.sign_key.len, sizeof(kdc_data.sign_key.len));
-        buf += sizeof(kdc_data.sign_key.len);
-        memcpy(buf, kdc_data.sign_key.buf, kdc_data.sign_key.len);
-        buf += kdc_data.sign_key.len;
+        sink->write((uint8_t *) &kdc_data.sign_key.len, sizeof(kdc_data.sign_key.len));
+        sink->write(kdc_data.sign_key.buf, kdc_data.sign_key.len);
     }
     //timestamp
-    memcpy(buf, (uint8_t *) &timestamp, sizeof(timestamp));
-    buf += sizeof(timestamp);
-
-    *l = len;
-    return data;
+    sink->write((uint8_t *) &timestamp, sizeof(timestamp));
 }
 
 /**
- * Creates and return an array of all fields of the package
+ * Writes all fields of the package to the sink
  *
- *@param l length of created array
- *@return packet array
+ *@param sink sink which receives the fields
  */
-uint8_t * PASER_UU_RREP::getCompleteByteArray(int *l) {
-    int lengthOld = 0;
-    uint8_t *tempPacket = toByteArray(&lengthOld);
-
-    int lengthNew = lengthOld;
-    lengthNew += sizeof(sign.len); // Length of signature
-    lengthNew += sign.len; // Signature
-    // Allocate block of size "lengthNew" bytes memory.
-    uint8_t *data = (uint8_t *) malloc(lengthNew);
-    uint8_t *buf;
-    buf = data;
-
-    memcpy(buf, tempPacket, lengthOld);
-    buf += lengthOld;
+void PASER_UU_RREP::writeCompleteFields(PASER_field_sink *sink) {
+    writeFields(sink);
     //sign
-    memcpy(buf, (uint8_t *) &sign.len, sizeof(sign.len));
-    buf += sizeof(sign.len);
-    memcpy(buf, sign.buf, sign.len);
-    buf += sign.len;
-
-    *l = lengthNew;
-    free(tempPacket);
-    return data;
+    sink->write((uint8_t *) &sign.len, sizeof(sign.len));
+    sink->write(sign.buf, sign.len);
 
 //    int len = 0;
 //    len += 1;
@@ -27,6 +27,8 @@
 
 #include "PASER_MSG.h"
 
+class PASER_UU_RREP_view;
+
 /**
  * Implementation of PASER_UU_RREP classes
  */
@@ -54,6 +56,11 @@ public:
 	PASER_UU_RREP(struct in_addr src, struct in_addr dest, u_int32_t seqNr);
 
     static PASER_UU_RREP* create(uint8_t *packet, u_int32_t l);
+    /**
+     * Materialize a message from the view of a received UU-RREP.
+     * The fields are copied, so the message outlives the receive buffer.
+     */
+    static PASER_UU_RREP* create(const PASER_UU_RREP_view *view);
 
     ~PASER_UU_RREP();
 
@@ -61,8 +68,8 @@ public:
     virtual PASER_UU_RREP *dup() const {return new PASER_UU_RREP(*this);}
     std::string detailedInfo() const;
 
-    uint8_t * toByteArray(int *l);
-    uint8_t * getCompleteByteArray(int *l);
+    void writeFields(PASER_field_sink *sink);
+    void writeCompleteFields(PASER_field_sink *sink);
 private:
     PASER_UU_RREP();
 };
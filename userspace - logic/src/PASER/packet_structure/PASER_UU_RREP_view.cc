@@ -0,0 +1,163 @@
+/**
+ *\class  		PASER_UU_RREP_view
+ *@brief       	Class implements a read-only view of a received PASER_UU_RREP message
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_UU_RREP_view.h"
+
+PASER_UU_RREP_view::PASER_UU_RREP_view() {
+    srcAddress_var.s_addr = 0;
+    destAddress_var.s_addr = 0;
+    seq = 0;
+    keyNr = 0;
+    searchGW = 0;
+    GFlag = 0;
+    addressCount = 0;
+    forwarding.s_addr = 0;
+    metricBetweenQueryingAndForw = 0;
+    metricBetweenDestAndForw = 0;
+    certForw.buf = NULL;
+    certForw.len = 0;
+    root.buf = NULL;
+    root.len = 0;
+    initVector = 0;
+    geoDestination.lat = 0;
+    geoDestination.lon = 0;
+    geoForwarding.lat = 0;
+    geoForwarding.lon = 0;
+    memset(&kdc_data, 0, sizeof(kdc_data));
+    timestamp = 0;
+    sign.buf = NULL;
+    sign.len = 0;
+    error = NULL;
+    addressList.buf = NULL;
+    addressList.len = 0;
+}
+
+int PASER_UU_RREP_view::parse(const uint8_t *packet, u_int32_t l) {
+    PASER_wire_reader reader(packet, l);
+
+    // read packet type
+    uint8_t type;
+    if (!reader.read(&type) || type != 0x01) {
+        error = "packet type";
+        return 0;
+    }
+    if (!reader.read(&srcAddress_var.s_addr)) {
+        error = "SrcAddr";
+        return 0;
+    }
+    if (!reader.read(&destAddress_var.s_addr)) {
+        error = "DestAddr";
+        return 0;
+    }
+    if (!reader.read(&seq)) {
+        error = "SeqNr";
+        return 0;
+    }
+    if (!reader.read(&keyNr)) {
+        error = "KeyNr";
+        return 0;
+    }
+    if (!reader.read(&searchGW)) {
+        error = "searchGW";
+        return 0;
+    }
+    if (!reader.read(&GFlag)) {
+        error = "GFlag";
+        return 0;
+    }
+    if (!reader.readAddressList(&addressCount, &addressList, &forwarding)) {
+        error = "AddressRangeList";
+        return 0;
+    }
+    if (!reader.read(&metricBetweenQueryingAndForw)) {
+        error = "MetricBetweenQueryingAndForw";
+        return 0;
+    }
+    if (!reader.read(&metricBetweenDestAndForw)) {
+        error = "MetricBetweenDestAndForw";
+        return 0;
+    }
+    if (!reader.readLVSpan(&certForw)) {
+        error = "Certificate";
+        return 0;
+    }
+    if (!reader.readSpan(PASER_SECRET_HASH_LEN, &root)) {
+        error = "Root";
+        return 0;
+    }
+    if (!reader.read(&initVector)) {
+        error = "IV";
+        return 0;
+    }
+    if (!reader.read(&geoDestination.lat) || !reader.read(&geoDestination.lon)) {
+        error = "GeoDestination";
+        return 0;
+    }
+    if (!reader.read(&geoForwarding.lat) || !reader.read(&geoForwarding.lon)) {
+        error = "GeoForwarding";
+        return 0;
+    }
+    if (GFlag) {
+        if (!reader.readLVSpan(&kdc_data.GTK)) {
+            error = "GTK";
+            return 0;
+        }
+        if (!reader.read(&kdc_data.nonce)) {
+            error = "nonce";
+            return 0;
+        }
+        if (!reader.readLVSpan(&kdc_data.CRL)) {
+            error = "CRL";
+            return 0;
+        }
+        if (!reader.readLVSpan(&kdc_data.cert_kdc)) {
+            error = "KDC's certificate";
+            return 0;
+        }
+        if (!reader.readLVSpan(&kdc_data.sign)) {
+            error = "KDC's signature";
+            return 0;
+        }
+        if (!reader.read(&kdc_data.key_nr)) {
+            error = "KDC's key number";
+            return 0;
+        }
+        if (!reader.readLVSpan(&kdc_data.sign_key)) {
+            error = "key's signature";
+            return 0;
+        }
+    }
+    if (!reader.read(&timestamp)) {
+        error = "Timestamp";
+        return 0;
+    }
+    if (!reader.readLVSpan(&sign)) {
+        error = "signature";
+        return 0;
+    }
+    error = NULL;
+    return 1;
+}
+
+PASER_wire_reader PASER_UU_RREP_view::getAddressList() const {
+    return PASER_wire_reader(addressList.buf, addressList.len);
+}
@@ -0,0 +1,84 @@
+/**
+ *\class  		PASER_UU_RREP_view
+ *@brief       	Class implements a read-only view of a received PASER_UU_RREP message
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_UU_RREP_view;
+
+#ifndef PASER_UU_RREP_VIEW_H_
+#define PASER_UU_RREP_VIEW_H_
+
+#include "../config/PASER_defs.h"
+#include "PASER_wire_reader.h"
+
+/**
+ * View of a received UU-RREP. parse() checks the complete structure of
+ * the message like PASER_UB_RREQ_view and does not allocate anything. The
+ * route list is iterated with nextAddress(), the certificate, the root, the
+ * signature and the blobs of the KDC block are spans into the receive
+ * buffer. PASER_UU_RREP::create() materializes the message.
+ */
+class PASER_UU_RREP_view {
+public:
+    struct in_addr srcAddress_var;              ///< IP address of querying node
+    struct in_addr destAddress_var;             ///< IP address of destination node
+    u_int32_t seq;                              ///< Sequence number of destination node
+    u_int32_t keyNr;                            ///< Current number of GTK
+    uint8_t searchGW;                           ///< search for the gateway
+    uint8_t GFlag;                              ///< Gateway flag
+    u_int32_t addressCount;                     ///< Number of entries of the route list
+    struct in_addr forwarding;                  ///< IP address of the last entry of the route list
+    uint8_t metricBetweenQueryingAndForw;       ///< Metric for the route between querying node and forwarding node
+    uint8_t metricBetweenDestAndForw;           ///< Metric for the route between destination node and forwarding node
+    lv_block certForw;                          ///< Certificate of forwarding node
+    lv_block root;                              ///< Root element of forwarding node
+    u_int32_t initVector;                       ///< IV of forwarding node
+    geo_pos geoDestination;                     ///< Geographical position of destination node
+    geo_pos geoForwarding;                      ///< Geographical position of forwarding node
+    kdc_block kdc_data;                         ///< KDC block (only if GFlag is set), the blobs are spans
+    long timestamp;                             ///< Sending or forwarding time
+    lv_block sign;                              ///< Signature of the packet
+
+    const char *error;                          ///< Name of the field which could not be read or NULL
+
+    PASER_UU_RREP_view();
+
+    /**
+     * Check the structure of the char array and read the fixed fields.
+     *
+     *@param packet received char array
+     *@param l length of the char array
+     *
+     *@return 1 on successful or 0 if the array is no valid UU-RREP.
+     *        <b>error</b> names the wrong field in this case.
+     */
+    int parse(const uint8_t *packet, u_int32_t l);
+
+    /**
+     * Get a reader over the route list. The entries are read with
+     * PASER_wire_reader::nextAddress().
+     */
+    PASER_wire_reader getAddressList() const;
+
+private:
+    lv_block addressList;                       ///< Span of the route list (without its length)
+};
+
+#endif /* PASER_UU_RREP_VIEW_H_ */
@@ -0,0 +1,56 @@
+/**
+ *\class  		PASER_field_sink
+ *@brief       	Class (abstract) that receives the serialized fields of a PASER packet.
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#ifndef PASER_FIELD_SINK_H_
+#define PASER_FIELD_SINK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Receiver of the serialized fields of a PASER packet. A packet writes its fields
+ * in wire order, the sink e.g. copies them to a buffer or feeds them into a digest.
+ */
+class PASER_field_sink {
+public:
+    virtual ~PASER_field_sink() {
+    }
+
+    /**
+     * Write a field
+     *
+     *@param data pointer to the field
+     *@param len length of the field
+     */
+    virtual void write(const void *data, size_t len)=0;
+
+    /**
+     * Write a field of one byte
+     *
+     *@param value value of the field
+     */
+    void writeByte(uint8_t value) {
+        write(&value, 1);
+    }
+};
+
+#endif /* PASER_FIELD_SINK_H_ */
@@ -0,0 +1,187 @@
+/**
+ *\class  		PASER_wire_reader
+ *@brief       	Class reads the fields of a received PASER packet with bounds checks.
+ *@ingroup		PS
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http://www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#ifndef PASER_WIRE_READER_H_
+#define PASER_WIRE_READER_H_
+
+#include "../config/PASER_defs.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Cursor over a received char array. The fields are read in wire order,
+ * every read checks the remaining length first and fails without moving
+ * the cursor if the field does not fit. Blobs are returned as spans
+ * (lv_block which points into the array), so nothing is allocated or copied.
+ */
+class PASER_wire_reader {
+private:
+    const uint8_t *buf;
+    u_int32_t len;
+    u_int32_t pos;
+
+public:
+    PASER_wire_reader() {
+        buf = NULL;
+        len = 0;
+        pos = 0;
+    }
+
+    PASER_wire_reader(const uint8_t *buf, u_int32_t len) {
+        this->buf = buf;
+        this->len = len;
+        pos = 0;
+    }
+
+    /**
+     * Get the number of bytes which are not yet read.
+     */
+    u_int32_t left() const {
+        return len - pos;
+    }
+
+    /**
+     * Get the pointer to the next field.
+     */
+    const uint8_t *current() const {
+        return buf + pos;
+    }
+
+    /**
+     * Copy the next field to <b>data</b>. The field may be unaligned.
+     *
+     *@return 1 on successful or 0 if the array is too short
+     */
+    int read(void *data, u_int32_t n) {
+        if (n > len - pos) {
+            return 0;
+        }
+        memcpy(data, buf + pos, n);
+        pos += n;
+        return 1;
+    }
+
+    /**
+     * Read a field with the size of its type.
+     *
+     *@return 1 on successful or 0 if the array is too short
+     */
+    template<typename T>
+    int read(T *value) {
+        return read(value, sizeof(T));
+    }
+
+    /**
+     * Get the next <b>n</b> bytes as span without copying them.
+     *
+     *@return 1 on successful or 0 if the array is too short
+     */
+    int readSpan(u_int32_t n, lv_block *span) {
+        if (n > len - pos) {
+            return 0;
+        }
+        span->buf = (uint8_t *) (buf + pos);
+        span->len = n;
+        pos += n;
+        return 1;
+    }
+
+    /**
+     * Read a 32 bit length followed by a blob of this length as span.
+     *
+     *@return 1 on successful or 0 if the array is too short
+     */
+    int readLVSpan(lv_block *span) {
+        u_int32_t n;
+        u_int32_t start = pos;
+        if (!read(&n) || !readSpan(n, span)) {
+            pos = start;
+            return 0;
+        }
+        return 1;
+    }
+
+    /**
+     * Skip the next <b>n</b> bytes.
+     *
+     *@return 1 on successful or 0 if the array is too short
+     */
+    int skip(u_int32_t n) {
+        if (n > len - pos) {
+            return 0;
+        }
+        pos += n;
+        return 1;
+    }
+
+    /**
+     * Read a route list: a 32 bit number of entries, every entry is an IP
+     * address followed by a 32 bit number of subnetworks (pairs of IP address
+     * and mask). The structure of the complete list is checked, the entries
+     * are read later with nextAddress().
+     *
+     *@param count number of entries
+     *@param list span of the entries (without the number of entries)
+     *@param last IP address of the last entry (unchanged if the list is empty)
+     *
+     *@return 1 on successful or 0 if the list does not fit in the array
+     */
+    int readAddressList(u_int32_t *count, lv_block *list, struct in_addr *last) {
+        u_int32_t start = pos;
+        if (!read(count)) {
+            return 0;
+        }
+        u_int32_t listStart = pos;
+        for (u_int32_t i = 0; i < *count; i++) {
+            u_int32_t rangeCount;
+            if (!read(&last->s_addr) || !read(&rangeCount)
+                    || rangeCount > left() / (2 * sizeof(in_addr_t)) || !skip(rangeCount * 2 * sizeof(in_addr_t))) {
+                pos = start;
+                return 0;
+            }
+        }
+        list->buf = (uint8_t *) (buf + listStart);
+        list->len = pos - listStart;
+        return 1;
+    }
+
+    /**
+     * Read the next entry of a route list which was checked by readAddressList(),
+     * so the function only fails at the end of the list.
+     *
+     *@param list reader over the span returned by readAddressList()
+     *@param addr IP address of the entry
+     *@param ranges span of the subnetworks of the entry (pairs of IP address and mask)
+     *
+     *@return 1 on successful or 0 at the end of the list
+     */
+    static int nextAddress(PASER_wire_reader *list, struct in_addr *addr, lv_block *ranges) {
+        u_int32_t rangeCount;
+        if (!list->read(&addr->s_addr) || !list->read(&rangeCount)) {
+            return 0;
+        }
+        return list->readSpan(rangeCount * 2 * sizeof(in_addr_t), ranges);
+    }
+};
+
+#endif /* PASER_WIRE_READER_H_ */
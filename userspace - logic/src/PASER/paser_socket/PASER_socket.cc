@@ -34,6 +34,7 @@
 #include <netinet/ip.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <sys/epoll.h>
 
 #include <openssl/crypto.h>
 #include <openssl/x509.h>
@@ -61,13 +62,39 @@ PASER_socket::PASER_socket(PASER_global *paser_global) {
     lastPacket.buf = NULL;
 
     socketToKernel = -1;
+    epollFD = -1;
     ctx = NULL;
+    sendTransactionDepth = 0;
+
+    // initialize receive buffer pool
+    recvPool = (uint8_t*) malloc(PASER_RECV_BATCH_SIZE * (SO_RECVBUF_SIZE + 1));
+    if (!recvPool) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Cann't allocate receive buffer pool.\n");
+        exit(1);
+    }
+    memset(recvMsgs, 0, sizeof(recvMsgs));
+    for (int i = 0; i < PASER_RECV_BATCH_SIZE; i++) {
+        recvIov[i].iov_base = recvPool + i * (SO_RECVBUF_SIZE + 1);
+        recvIov[i].iov_len = SO_RECVBUF_SIZE;
+        recvMsgs[i].msg_hdr.msg_iov = &recvIov[i];
+        recvMsgs[i].msg_hdr.msg_iovlen = 1;
+        recvMsgs[i].msg_hdr.msg_name = &recvAddr[i];
+    }
 #ifndef PASER_MODULE_TEST
+    epollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFD < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "epoll_create1() failed.\nError: (%d)%s\n", errno, strerror(errno));
+        exit(1);
+    }
+
     // initialize PASER sockets
     initDeviceSockets();
 
     // initialize kernel Socket
     initSocketToKernel();
+    if (!registerSocket(socketToKernel, SOCKET_KERNEL, socketToKernel)) {
+        exit(1);
+    }
 
     // initialize rom_policy ROM_A_UNSPEC
     rom_genl_policy[ROM_A_UNSPEC].type = NLA_U32;
@@ -90,6 +117,14 @@ PASER_socket::PASER_socket(PASER_global *paser_global) {
     rom_genl_policy[ROM_A_GWSTATE].maxlen = 0xFFFF;
 
     rom = new rom_client(pGlobal);
+    if (rom->getRtnlSocket() >= 0 && !registerSocket(rom->getRtnlSocket(), SOCKET_ROUTE, rom->getRtnlSocket())) {
+        exit(1);
+    }
+    // eventfd of the signature verification threads
+    int verifyFD = pGlobal->getVerify_pool()->getEventFD();
+    if (verifyFD >= 0 && !registerSocket(verifyFD, SOCKET_VERIFY, verifyFD)) {
+        exit(1);
+    }
     // initialize SSL structure
     const SSL_METHOD *meth;
 
@@ -148,6 +183,13 @@ PASER_socket::~PASER_socket() {
     lastPacket.len = 0;
     lastPacket.buf = NULL;
 
+    for (std::map<network_device *, std::vector<send_entry> >::iterator it = sendQueue.begin(); it != sendQueue.end(); it++) {
+        for (std::vector<send_entry>::iterator entry = it->second.begin(); entry != it->second.end(); entry++) {
+            free(entry->buf);
+        }
+    }
+    sendQueue.clear();
+
 #ifndef PASER_MODULE_TEST
     delete rom;
 
@@ -165,10 +207,12 @@ PASER_socket::~PASER_socket() {
     }
 
     nl_socket_free(sk);
+    close(epollFD);
 #endif
     if (ctx) {
         SSL_CTX_free(ctx);
     }
+    free(recvPool);
 
 }
 
@@ -179,6 +223,7 @@ void PASER_socket::initDeviceSockets() {
     unsigned int i;
     int on = 1;
     int tos = IPTOS_LOWDELAY;
+    int ttl = PASER_IPTTL;
     int bufsize = SO_RECVBUF_SIZE;
     socklen_t bufoptlen = sizeof(bufsize);
 
@@ -243,6 +288,12 @@ void PASER_socket::initDeviceSockets() {
             exit(EXIT_FAILURE);
         }
 
+        // Set TTL of IP datagrams
+        if (setsockopt(DEV_NR(i).sock, SOL_IP, IP_TTL, &ttl, sizeof(int)) < 0) {
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "setsockopt(IP_TTL) failed\nError: (%d)%s\n", errno, strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+
         PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Set receive buffer size ...\n");
         // Set maximum allowable receive buffer size
         for (;; bufsize -= 1024) {
@@ -256,8 +307,32 @@ void PASER_socket::initDeviceSockets() {
             }
         }
         PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "receive buffer size set to %d\n", bufsize);
+
+        if (!registerSocket(DEV_NR(i).sock, SOCKET_DEVICE, i)) {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+}
+
+bool PASER_socket::registerSocket(int sock, paser_socket_type type, u_int32_t index) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = ((u_int64_t) type << 32) | index;
+    if (epoll_ctl(epollFD, EPOLL_CTL_ADD, sock, &event) < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "epoll_ctl(ADD) failed on socket %d\nError: (%d)%s\n", sock, errno, strerror(errno));
+        return false;
     }
+    return true;
+}
 
+void PASER_socket::unregisterSocket(int sock) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    if (epoll_ctl(epollFD, EPOLL_CTL_DEL, sock, &event) < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "epoll_ctl(DEL) failed on socket %d\nError: (%d)%s\n", sock, errno, strerror(errno));
+    }
 }
 
 int PASER_socket::msg_handler(struct nlmsghdr *msg, void *arg) {
@@ -511,6 +586,13 @@ int PASER_socket::initEthSocket(network_device *netDevice) {
 
     PASER_LOG_WRITE_LOG(PASER_LOG_CONFIGURATION, "Initialize Ethernet Socket...OK\n");
 
+    if (!registerSocket(tempSocket, SOCKET_SSL, tempSocket)) {
+        if (!SSL_get_shutdown(ssl))
+            SSL_shutdown(ssl);
+        close(tempSocket);
+        SSL_free(ssl);
+        return -1;
+    }
     socketMap.insert(std::make_pair(tempSocket, ssl));
     return tempSocket;
 }
@@ -520,41 +602,98 @@ int PASER_socket::getSocketToKernel() {
 }
 
 void PASER_socket::sendUDPToIPOverNetwork(uint8_t *s, int length, const in_addr destAddr, int destPort, network_device *netDevice) {
+#ifndef PASER_MODULE_TEST
+    send_entry entry;
+    entry.buf = s;
+    entry.len = length;
+    memset(&entry.dest, 0, sizeof(entry.dest));
+    entry.dest.sin_family = AF_INET;
+    entry.dest.sin_addr = destAddr;
+    entry.dest.sin_port = htons(destPort);
+    sendQueue[netDevice].push_back(entry);
+
+    if (sendTransactionDepth == 0) {
+        flushSendQueue();
+    }
+#else
     if (lastPacket.len > 0) {
         free(lastPacket.buf);
     }
-#ifndef PASER_MODULE_TEST
-    struct sockaddr_in dest_sockaddr;
-    u_int8_t ttl;
+    lastPacket.len = length;
+    lastPacket.buf = s;
+#endif
+}
 
-    dest_sockaddr.sin_family = AF_INET;
-    dest_sockaddr.sin_addr = destAddr;
-    dest_sockaddr.sin_port = htons(destPort);
+void PASER_socket::beginSendTransaction() {
+    sendTransactionDepth++;
+}
 
-    // Set TTL
-    ttl = PASER_IPTTL;
-    if (setsockopt(netDevice->sock, SOL_IP, IP_TTL, &ttl, sizeof(ttl)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "setsockopt(IP_TTL) failed: %s(%d)\n", crt_strerror(errno), errno);
-        exit(1);
+void PASER_socket::commitSendTransaction() {
+    if (sendTransactionDepth > 0) {
+        sendTransactionDepth--;
     }
-    // Send
-    if (sendto(netDevice->sock, s, length, 0, (struct sockaddr *) &dest_sockaddr, sizeof(dest_sockaddr)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "failed send to %s: %s(%d)\n", inet_ntoa(destAddr), crt_strerror(errno), errno);
-        lastPacket.len = 0;
-        lastPacket.buf = NULL;
-        return;
+    if (sendTransactionDepth == 0) {
+        flushSendQueue();
     }
+}
 
-    // add data to statistic
-    pGlobal->getPaserStatistic()->addToSendBytes((long) lastPacket.len);
-    if (destAddr.s_addr == PASER_BROADCAST ) {
-        pGlobal->getPaserStatistic()->incBroadcastPackets();
-    } else {
-        pGlobal->getPaserStatistic()->incUnicastPackets();
+void PASER_socket::flushSendQueue() {
+    struct mmsghdr msgs[PASER_SEND_BATCH_SIZE];
+    struct iovec iov[PASER_SEND_BATCH_SIZE];
+
+    for (std::map<network_device *, std::vector<send_entry> >::iterator it = sendQueue.begin(); it != sendQueue.end(); it++) {
+        network_device *netDevice = it->first;
+        std::vector<send_entry> &queue = it->second;
+        if (queue.empty()) {
+            continue;
+        }
+        int packets = 0;
+        long bytes = 0;
+        u_int32_t next = 0;
+        while (next < queue.size()) {
+            // prepare next batch
+            u_int32_t count = 0;
+            memset(msgs, 0, sizeof(msgs));
+            for (; count < PASER_SEND_BATCH_SIZE && next + count < queue.size(); count++) {
+                send_entry *entry = &queue[next + count];
+                iov[count].iov_base = entry->buf;
+                iov[count].iov_len = entry->len;
+                msgs[count].msg_hdr.msg_iov = &iov[count];
+                msgs[count].msg_hdr.msg_iovlen = 1;
+                msgs[count].msg_hdr.msg_name = &entry->dest;
+                msgs[count].msg_hdr.msg_namelen = sizeof(entry->dest);
+            }
+            // Send
+            int sent = sendmmsg(netDevice->sock, msgs, count, 0);
+            if (sent <= 0) {
+                // skip the datagram which can not be sent
+                send_entry *entry = &queue[next];
+                PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "failed send to %s: %s(%d)\n", inet_ntoa(entry->dest.sin_addr),
+                        crt_strerror(errno), errno);
+                next++;
+                continue;
+            }
+            // add data to statistic
+            for (int i = 0; i < sent; i++) {
+                send_entry *entry = &queue[next + i];
+                pGlobal->getPaserStatistic()->addToSendBytes((long) entry->len);
+                if (entry->dest.sin_addr.s_addr == PASER_BROADCAST) {
+                    pGlobal->getPaserStatistic()->incBroadcastPackets();
+                } else {
+                    pGlobal->getPaserStatistic()->incUnicastPackets();
+                }
+                packets++;
+                bytes += entry->len;
+            }
+            next += sent;
+        }
+        PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Sent %d packets (%ld bytes) on %s\n", packets, bytes, netDevice->ifname);
+        pGlobal->getPaserStatistic()->addSendFlush(netDevice->ifindex, packets, bytes);
+        for (std::vector<send_entry>::iterator entry = queue.begin(); entry != queue.end(); entry++) {
+            free(entry->buf);
+        }
+        queue.clear();
     }
-#endif
-    lastPacket.len = length;
-    lastPacket.buf = s;
 }
 
 bool PASER_socket::addRouteDev(in_addr destIP, in_addr destMask, network_device *netDevice) {
@@ -591,6 +730,26 @@ bool PASER_socket::deleteRoute(in_addr destIP, in_addr destMask) {
     return true;
 }
 
+bool PASER_socket::replaceRouteDev(in_addr destIP, in_addr destMask, network_device *netDevice, bool isNew) {
+    if (rom->send(CAT_ROUTE, CMD_ROUTE_REPLACE, destIP, destMask, CMD2_DEV, destIP, netDevice) != 0) {
+        return false;
+    }
+    if (isNew) {
+        rom->send(CAT_CORE, CMD_CORE_RT_ADD, destIP, destMask, CMD2_UNSPEC, destIP, netDevice);
+    }
+    return true;
+}
+
+bool PASER_socket::replaceRouteVia(in_addr destIP, in_addr destMask, in_addr neighborIP, bool isNew) {
+    if (rom->send(CAT_ROUTE, CMD_ROUTE_REPLACE, destIP, destMask, CMD2_VIA, neighborIP, NULL) != 0) {
+        return false;
+    }
+    if (isNew) {
+        rom->send(CAT_CORE, CMD_CORE_RT_ADD, destIP, destMask, CMD2_UNSPEC, destIP, NULL);
+    }
+    return true;
+}
+
 bool PASER_socket::releaseQueue(in_addr destIP, in_addr destMask) {
     rom->send(CAT_QUEUE, CMD_QUEUE_RELEASE, destIP, destMask, CMD2_UNSPEC, destIP, NULL);
     return true;
@@ -629,6 +788,26 @@ bool PASER_socket::releaseQueue_for_AddList(std::list<address_list> AddList) {
     return true;
 }
 
+void PASER_socket::beginRouteTransaction() {
+    rom->beginTransaction();
+}
+
+void PASER_socket::commitRouteTransaction() {
+    rom->commitTransaction();
+}
+
+int PASER_socket::getRouteSocket() {
+    return rom->getRtnlSocket();
+}
+
+void PASER_socket::readRouteAcks() {
+    rom->readAcks();
+}
+
+void PASER_socket::getFailedRoutes(std::list<std::pair<Uint128, Uint128> > *routes) {
+    rom->getFailedRoutes(routes);
+}
+
 void PASER_socket::sendUDPToIPOverSSL(uint8_t *s, int length, const in_addr destAddr, int destPort, network_device *netDevice) {
     if (lastPacket.len > 0) {
         free(lastPacket.buf);
@@ -663,25 +842,34 @@ void PASER_socket::sendUDPToIPOverSSL(uint8_t *s, int length, const in_addr dest
     lastPacket.buf = s;
 }
 
-lv_block PASER_socket::readDataFromNetwork(network_device *netDevice) {
-    lv_block buffer;
-    buffer.len = 0;
-    buffer.buf = NULL;
-    buffer.buf = (uint8_t*) malloc(SO_RECVBUF_SIZE + 1);
-    int len;
-    struct sockaddr_in sender_addr;
-    socklen_t addr_len = sizeof(struct sockaddr_in);
+int PASER_socket::readDataFromNetwork(network_device *netDevice, lv_block *packets) {
+    for (int i = 0; i < PASER_RECV_BATCH_SIZE; i++) {
+        recvMsgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        recvMsgs[i].msg_hdr.msg_flags = 0;
+    }
 
-    // Receive message
-    if ((len = recvfrom(netDevice->sock, buffer.buf, SO_RECVBUF_SIZE, 0, (struct sockaddr *) &sender_addr, &addr_len)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "could not receive message: %s(%d)", crt_strerror(errno), errno);
-        free(buffer.buf);
-        buffer.len = 0;
-        buffer.buf = NULL;
-        return buffer;
+    // Receive messages
+    int n = recvmmsg(netDevice->sock, recvMsgs, PASER_RECV_BATCH_SIZE, MSG_DONTWAIT, NULL);
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "could not receive message: %s(%d)", crt_strerror(errno), errno);
+            pGlobal->getPaserStatistic()->incReceiveDrops(netDevice->ifindex);
+        }
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        packets[i].buf = (uint8_t*) recvIov[i].iov_base;
+        packets[i].len = recvMsgs[i].msg_len;
+        if (recvMsgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Message on %s is truncated.\n", netDevice->ifname);
+            pGlobal->getPaserStatistic()->incReceiveDrops(netDevice->ifindex);
+            packets[i].len = -1;
+        }
     }
-    buffer.len = len;
-    return buffer;
+    if (n > 0) {
+        pGlobal->getPaserStatistic()->addReceiveBatch(netDevice->ifindex, n);
+    }
+    return n;
 }
 
 lv_block PASER_socket::readDataFromSSL(int sock) {
@@ -724,6 +912,7 @@ void PASER_socket::closeSSLSocket(int sock) {
     }
     if (!SSL_get_shutdown(it->second))
         SSL_shutdown(it->second);
+    unregisterSocket(it->first);
     close(it->first);
     SSL_free(it->second);
     socketMap.erase(it);
@@ -31,6 +31,7 @@ class PASER_socket;
 
 #include <list>
 #include <map>
+#include <vector>
 
 #include <openssl/ssl.h>
 
@@ -42,9 +43,37 @@ class PASER_socket;
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/socket.h>
 
 #include "rom.h"
 
+/// Maximum number of datagrams which are read from a PASER device socket with one call
+#define PASER_RECV_BATCH_SIZE 32
+/// Maximum number of datagrams which are sent on a PASER device socket with one call
+#define PASER_SEND_BATCH_SIZE 32
+
+/**
+ * A datagram in the send queue of a PASER network device.
+ */
+struct send_entry {
+    uint8_t *buf;
+    int len;
+    struct sockaddr_in dest;
+};
+
+/**
+ * Types of sockets which are registered in the epoll instance of PASER_socket.
+ * The type is stored in the upper 32 bit of epoll_event.data.u64,
+ * the lower 32 bit contain the device index or the socket FD.
+ */
+enum paser_socket_type {
+    SOCKET_DEVICE,
+    SOCKET_SSL,
+    SOCKET_KERNEL,
+    SOCKET_ROUTE,
+    SOCKET_VERIFY
+};
+
 /**
  * The main PASER class.
  */
@@ -52,6 +81,8 @@ class PASER_socket {
 private:
     // PASER Sockets
     int socketToKernel;
+    // epoll instance with all PASER sockets
+    int epollFD;
     struct nl_sock *sk;
     rom_client *rom;
     struct nla_policy rom_genl_policy[ROM_A_MAX + 1];
@@ -63,6 +94,16 @@ private:
 
     std::map<int, SSL*> socketMap;
 
+    // receive buffer pool. One slab per datagram of a batch.
+    uint8_t *recvPool;
+    struct mmsghdr recvMsgs[PASER_RECV_BATCH_SIZE];
+    struct iovec recvIov[PASER_RECV_BATCH_SIZE];
+    struct sockaddr_in recvAddr[PASER_RECV_BATCH_SIZE];
+
+    // send queue of each PASER network device
+    std::map<network_device *, std::vector<send_entry> > sendQueue;
+    int sendTransactionDepth;
+
 public:
     PASER_socket(PASER_global *paser_global);
     ~PASER_socket();
@@ -71,6 +112,9 @@ public:
 
     /**
      * Send PASER packet over PASER network.
+     * The packet is added to the send queue of the device and will be sent
+     * with the call of commitSendTransaction() or immediately if no
+     * transaction is open. The buffer <b>s</b> will be freed.
      */
     void sendUDPToIPOverNetwork(uint8_t *s, int length, const in_addr destAddr, int destPort, network_device *netDevice);
 
@@ -80,14 +124,17 @@ public:
     void sendUDPToIPOverSSL(uint8_t *s, int length, const in_addr destAddr, int destPort, network_device *netDevice);
 
     /**
-     * Read a data from socket.
+     * Read a batch of datagrams from socket.
+     * The datagrams are stored in the receive buffer pool and stay valid
+     * until the next call of the function. The buffers must not be freed.
      *
-     *@param b length of reading data. Will be set after function call.
      *@param netDevice Pointer to network device on which data is available.
+     *@param packets Array of PASER_RECV_BATCH_SIZE entries. Will be set after function call.
+     *               Dropped datagrams have the length -1.
      *
-     *@return on success, Pointer to Buffer. On Error NULL.
+     *@return number of read datagrams, 0 if no data is available or on error.
      */
-    lv_block readDataFromNetwork(network_device *netDevice);
+    int readDataFromNetwork(network_device *netDevice, lv_block *packets);
 
     /**
      * Read a data from socket.
@@ -105,7 +152,7 @@ public:
     lv_block readDataFromKernel();
 
     /**
-     * Get last sent packet.
+     * Get last packet sent over SSL connection.
      * @return last sent packet.
      */
     lv_block getLastPacket() {
@@ -119,10 +166,20 @@ public:
      */
     void closeSSLSocket(int sock);
 
-    std::map<int, SSL*> getSocketMap() {
+    const std::map<int, SSL*> &getSocketMap() {
         return socketMap;
     }
 
+    /**
+     * Get file descriptor of the epoll instance. All device sockets,
+     * the kernel socket, the rtnetlink socket, all SSL sockets and the
+     * eventfd of the signature verification threads are registered in it. Each event carries the paser_socket_type of the
+     * socket in the upper 32 bit of data.u64.
+     */
+    int getEpollFD() {
+        return epollFD;
+    }
+
     bool addRouteDev(in_addr destIP, in_addr destMask, network_device *netDevice);
 
     bool addDefaultRoute(in_addr destIP, network_device *netDevice, int metric);
@@ -133,6 +190,26 @@ public:
 
     bool deleteRoute(in_addr destIP, in_addr destMask);
 
+    /**
+     * Add a route to a directly reachable node or replace an existing route
+     * to the same destination with a single netlink message.
+     *
+     *@param isNew if true then the route will be announced to ROM too.
+     *
+     *@return false if the route could not be sent. Errors of the kernel are reported by getFailedRoutes().
+     */
+    bool replaceRouteDev(in_addr destIP, in_addr destMask, network_device *netDevice, bool isNew);
+
+    /**
+     * Add a route over a next hop or replace an existing route
+     * to the same destination with a single netlink message.
+     *
+     *@param isNew if true then the route will be announced to ROM too.
+     *
+     *@return false if the route could not be sent. Errors of the kernel are reported by getFailedRoutes().
+     */
+    bool replaceRouteVia(in_addr destIP, in_addr destMask, in_addr neighborIP, bool isNew);
+
     bool releaseQueue(in_addr destIP, in_addr destMask);
 
     bool releaseQueue_for_AddList(std::list<address_list> AddList);
@@ -141,6 +218,45 @@ public:
 
     bool setGWFlag(bool flag);
 
+    /**
+     * Start collecting of route and ROM commands.
+     * All commands will be sent to kernel with the call of commitRouteTransaction().
+     */
+    void beginRouteTransaction();
+
+    /**
+     * Send all collected route and ROM commands to kernel.
+     */
+    void commitRouteTransaction();
+
+    /**
+     * Start collecting of PASER packets.
+     * All packets will be sent with the call of commitSendTransaction().
+     */
+    void beginSendTransaction();
+
+    /**
+     * Send all collected PASER packets.
+     */
+    void commitSendTransaction();
+
+    /**
+     * Get file descriptor of the rtnetlink socket on which route ACKs are received.
+     */
+    int getRouteSocket();
+
+    /**
+     * Read all available route ACKs from kernel.
+     */
+    void readRouteAcks();
+
+    /**
+     * Get all routes which the kernel refused to add or replace since the last call.
+     *
+     *@param routes List to which the pairs of destination and mask are appended
+     */
+    void getFailedRoutes(std::list<std::pair<Uint128, Uint128> > *routes);
+
 private:
     /**
      * The function initialize all PASER sockets on which PASER protocol is active.
@@ -158,6 +274,27 @@ private:
      */
     int initEthSocket(network_device *netDevice);
 
+    /**
+     * Register a socket for read events in the epoll instance.
+     *
+     *@param sock Socket FD
+     *@param type Type of the socket
+     *@param index Device index for SOCKET_DEVICE, socket FD for all other types
+     *
+     *@return true on success
+     */
+    bool registerSocket(int sock, paser_socket_type type, u_int32_t index);
+
+    /**
+     * Remove a socket from the epoll instance.
+     */
+    void unregisterSocket(int sock);
+
+    /**
+     * Send all queued PASER packets with sendmmsg() and free them.
+     */
+    void flushSendQueue();
+
     char const* crt_strerror(int err);
 
     int msg_handler(struct nlmsghdr *msg, void *arg);
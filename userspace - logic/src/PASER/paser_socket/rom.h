@@ -87,6 +87,7 @@ enum {
 	CMD_CORE_RT_ADD,
 	CMD_CORE_RT_DELETE,
 	CMD_ROUTE_RT_DUMP,
+	CMD_ROUTE_REPLACE,
 	__CMD_MAX,
 };
 
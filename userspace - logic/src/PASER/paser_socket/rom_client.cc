@@ -32,25 +32,49 @@ rom_client::rom_client(PASER_global *paser_global) {
     }
 
     genl_connect(sk_rom);
+    // ROM does not answer with useful data. Nobody reads from this socket.
+    nl_socket_disable_auto_ack(sk_rom);
     rom_family = genl_ctrl_resolve(sk_rom, "ROUTE-O-MATIC");
 
     sk_rtnl = NULL;
+    cache_mngr = NULL;
+    rtnl_cb = NULL;
     msg_rom = NULL;
-    route = NULL;
-    rtnl_add_msg_pending = 0;
-    rtnl_del_msg_pending = 0;
-    rom_msg_pending = 0;
     link_cache = NULL;
-    route_cache = NULL;
     cmd = CMD_UNSPEC;
     cat = CAT_UNSPEC;
+
+    transaction_depth = 0;
+    rtnl_ack_pending = 0;
+    rtnl_msg_count = 0;
+    rtnl_write_count = 0;
+    rtnl_error_count = 0;
+
+    batch_buf = (uint8_t *) malloc(ROM_NL_BATCH_SIZE);
+    if (!batch_buf) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
+        exit(1);
+    }
+
+    if (!rom_init()) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to initialize rtnetlink session\n");
+        exit(1);
+    }
 }
 
 rom_client::~rom_client() {
+    // send all queued messages
+    transaction_depth = 0;
+    flush_batch(sk_rtnl, &rtnl_batch);
+    flush_batch(sk_rom, &rom_batch);
+    readAcks();
+
+    rom_nl_cleanup();
     if (sk_rom) {
         nl_close(sk_rom);
         nl_socket_free(sk_rom);
     }
+    free(batch_buf);
 }
 
 int rom_client::get_ip_from_arg(const char *src, __u32 *dst) {
@@ -69,15 +93,43 @@ void rom_client::create_rom_msg(int type) {
     msg_rom = nlmsg_alloc();
     if (!msg_rom) {
         msg_rom = NULL;
-        rom_msg_pending = 0;
         return;
     }
 
     genlmsg_put(msg_rom, NL_AUTO_PID, NL_AUTO_SEQ, rom_family, 0, NLM_F_CREATE, type, 1);
-    rom_msg_pending = 1;
 }
 
-void rom_client::rtnl_add_nexthop_via(struct rtnl_route *route, const char *via_addr) {
+struct rtnl_route *rom_client::create_route(in_addr destIP, int maskSize) {
+    struct rtnl_route *route;
+    struct nl_addr *addr;
+    int err;
+
+    route = rtnl_route_alloc();
+    if (!route) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate route object\n");
+        return NULL;
+    }
+    rtnl_route_set_family(route, AF_INET);
+
+    addr = nl_addr_build(AF_INET, &destIP.s_addr, sizeof(destIP.s_addr));
+    if (!addr) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
+        rtnl_route_put(route);
+        return NULL;
+    }
+    nl_addr_set_prefixlen(addr, maskSize);
+    if ((err = rtnl_route_set_dst(route, addr)) < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to set destination address: %s\n", nl_geterror(err));
+        nl_addr_put(addr);
+        rtnl_route_put(route);
+        return NULL;
+    }
+    nl_addr_put(addr);
+
+    return route;
+}
+
+bool rom_client::rtnl_add_nexthop_via(struct rtnl_route *route, in_addr via_addr) {
     struct rtnl_nexthop *nh;
     struct nl_addr *addr;
 
@@ -85,82 +137,83 @@ void rom_client::rtnl_add_nexthop_via(struct rtnl_route *route, const char *via_
 
     if (!nh) {
         PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
-        return;
+        return false;
     }
 
-    addr = nl_cli_addr_parse(via_addr, rtnl_route_get_family(route));
+    addr = nl_addr_build(AF_INET, &via_addr.s_addr, sizeof(via_addr.s_addr));
+    if (!addr) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
+        rtnl_route_nh_free(nh);
+        return false;
+    }
     rtnl_route_nh_set_gateway(nh, addr);
     nl_addr_put(addr);
 
     rtnl_route_add_nexthop(route, nh);
+    return true;
 }
 
-void rom_client::rtnl_add_nexthop_dev(struct rtnl_route *route, network_device * _device, struct nl_cache *link_cache) {
+bool rom_client::rtnl_add_nexthop_dev(struct rtnl_route *route, network_device * _device) {
     struct rtnl_nexthop *nh;
     int ival;
 
-    nh = rtnl_route_nh_alloc();
-    if (!nh) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
-        return;
-    }
+    // apply pending link notifications to the link cache
+    nl_cache_mngr_data_ready(cache_mngr);
 
     ival = rtnl_link_name2i(link_cache, _device->ifname);
     if (!ival) {
         PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Device \"%s\" does not exist\n", _device->ifname);
-        return;
+        return false;
+    }
+
+    nh = rtnl_route_nh_alloc();
+    if (!nh) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
+        return false;
     }
 
     rtnl_route_nh_set_ifindex(nh, ival);
 
     rtnl_route_add_nexthop(route, nh);
-}
-
-void rom_client::delete_cb(struct nl_object *obj, void *arg) {
-    struct rtnl_route *route = (struct rtnl_route *) obj;
-    int err;
-
-    struct nl_sock *__sk_rtnl = (struct nl_sock *) arg;
-
-    err = rtnl_route_delete(__sk_rtnl, route, 0);
-    if (err < 0) {
-//        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to delete route: %s", nl_geterror(err));
-        return;
-    }
+    return true;
 }
 
 bool rom_client::rom_init(void) {
     int err;
 
-    sk_rtnl = nl_cli_alloc_socket();
-    nl_cli_connect(sk_rtnl, NETLINK_ROUTE);
-
-    msg_rom = NULL;
-
-    if ((err = rtnl_link_alloc_cache(sk_rtnl, AF_UNSPEC, &link_cache)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate link cache: %s\n", nl_geterror(err));
-        nl_close(sk_rtnl);
+    sk_rtnl = nl_socket_alloc();
+    if (!sk_rtnl) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to nl_socket_alloc()\n");
+        return false;
+    }
+    if ((err = nl_connect(sk_rtnl, NETLINK_ROUTE)) < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to connect rtnetlink socket: %s\n", nl_geterror(err));
         nl_socket_free(sk_rtnl);
+        sk_rtnl = NULL;
         return false;
     }
-    nl_cache_mngt_provide(link_cache);
+    // more than one request can be in flight. ACKs are collected in readAcks()
+    nl_socket_disable_seq_check(sk_rtnl);
+    nl_socket_set_nonblocking(sk_rtnl);
 
-    if ((err = rtnl_route_alloc_cache(sk_rtnl, AF_UNSPEC, 0, &route_cache)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate route cache: %s\n", nl_geterror(err));
-        nl_close(sk_rtnl);
-        nl_socket_free(sk_rtnl);
-        nl_cache_free(link_cache);
+    rtnl_cb = nl_cb_alloc(NL_CB_DEFAULT);
+    if (!rtnl_cb) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate netlink callback\n");
+        rom_nl_cleanup();
         return false;
     }
-    nl_cache_mngt_provide(route_cache);
+    nl_cb_set(rtnl_cb, NL_CB_ACK, NL_CB_CUSTOM, rtnl_ack_cb, this);
+    nl_cb_err(rtnl_cb, NL_CB_CUSTOM, rtnl_err_cb, this);
 
-    route = rtnl_route_alloc();
-    if (!route) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate route object\n");
-        nl_close(sk_rtnl);
-        nl_socket_free(sk_rtnl);
-        nl_cache_free(link_cache);
-        nl_cache_free(route_cache);
+    // The link cache is allocated once and updated by kernel notifications
+    if ((err = nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, NL_AUTO_PROVIDE, &cache_mngr)) < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate cache manager: %s\n", nl_geterror(err));
+        rom_nl_cleanup();
+        return false;
+    }
+    if ((err = nl_cache_mngr_add(cache_mngr, "route/link", NULL, NULL, &link_cache)) < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to allocate link cache: %s\n", nl_geterror(err));
+        rom_nl_cleanup();
         return false;
     }
 
@@ -168,15 +221,233 @@ bool rom_client::rom_init(void) {
 }
 
 void rom_client::rom_nl_cleanup(void) {
+    for (std::list<struct nl_msg *>::iterator it = rtnl_batch.begin(); it != rtnl_batch.end(); it++) {
+        nlmsg_free(*it);
+    }
+    rtnl_batch.clear();
+    for (std::list<struct nl_msg *>::iterator it = rom_batch.begin(); it != rom_batch.end(); it++) {
+        nlmsg_free(*it);
+    }
+    rom_batch.clear();
+
+    // frees link_cache too
+    if (cache_mngr) {
+        nl_cache_mngr_free(cache_mngr);
+    }
+    cache_mngr = NULL;
+    link_cache = NULL;
+
+    if (rtnl_cb) {
+        nl_cb_put(rtnl_cb);
+    }
+    rtnl_cb = NULL;
 
     if (sk_rtnl) {
         nl_close(sk_rtnl);
         nl_socket_free(sk_rtnl);
     }
-    nl_cache_free(link_cache);
-    nl_cache_free(route_cache);
+    sk_rtnl = NULL;
+}
+
+int rom_client::rtnl_ack_cb(struct nl_msg *msg, void *arg) {
+    rom_client *client = (rom_client *) arg;
+    if (client->rtnl_ack_pending > 0) {
+        client->rtnl_ack_pending--;
+    }
+    client->rtnl_in_flight.erase(nlmsg_hdr(msg)->nlmsg_seq);
+    return NL_OK;
+}
+
+int rom_client::rtnl_err_cb(struct sockaddr_nl *nla, struct nlmsgerr *nlerr, void *arg) {
+    rom_client *client = (rom_client *) arg;
+    PASER_global *pGlobal = client->pGlobal;
+    if (client->rtnl_ack_pending > 0) {
+        client->rtnl_ack_pending--;
+    }
+    client->rtnl_error_count++;
+    std::map<u_int32_t, rtnl_request>::iterator it = client->rtnl_in_flight.find(nlerr->msg.nlmsg_seq);
+    if (it != client->rtnl_in_flight.end()) {
+        if (it->second.type == RTM_NEWROUTE) {
+            client->rtnl_failed.push_back(std::make_pair(it->second.dst.s_addr, it->second.mask.s_addr));
+        }
+        client->rtnl_in_flight.erase(it);
+    }
+    if (nlerr->msg.nlmsg_type == RTM_DELROUTE && nlerr->error == -ESRCH) {
+        // route was not in kernel table
+        PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to delete does not exist (seq: %u)\n", nlerr->msg.nlmsg_seq);
+    } else {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "rtnetlink request (type: %d, seq: %u) failed: %s\n",
+                nlerr->msg.nlmsg_type, nlerr->msg.nlmsg_seq, strerror(-nlerr->error));
+    }
+    // continue with the next message
+    return NL_SKIP;
+}
+
+int rom_client::getRtnlSocket() {
+    if (!sk_rtnl) {
+        return -1;
+    }
+    return nl_socket_get_fd(sk_rtnl);
+}
+
+void rom_client::readAcks() {
+    if (!sk_rtnl) {
+        return;
+    }
+    while (rtnl_ack_pending > 0) {
+        // socket is non-blocking: nl_recvmsgs returns -NLE_AGAIN if no data are available
+        int err = nl_recvmsgs(sk_rtnl, rtnl_cb);
+        if (err == -NLE_AGAIN) {
+            break;
+        }
+        if (err < 0) {
+            // e.g. receive buffer overrun: the outstanding ACKs are lost
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to read rtnetlink ACKs: %s\n", nl_geterror(err));
+            rtnl_ack_pending = 0;
+            rtnl_in_flight.clear();
+            break;
+        }
+    }
+}
+
+void rom_client::getFailedRoutes(std::list<std::pair<Uint128, Uint128> > *routes) {
+    routes->splice(routes->end(), rtnl_failed);
+}
+
+bool rom_client::get_route_request(struct nlmsghdr *hdr, rtnl_request *request) {
+    if ((hdr->nlmsg_type != RTM_NEWROUTE && hdr->nlmsg_type != RTM_DELROUTE) || !nlmsg_valid_hdr(hdr, sizeof(struct rtmsg))) {
+        return false;
+    }
+    struct rtmsg *rtm = (struct rtmsg *) nlmsg_data(hdr);
+    request->type = hdr->nlmsg_type;
+    request->dst.s_addr = 0;
+    request->mask.s_addr = rtm->rtm_dst_len ? htonl(0xFFFFFFFF << (32 - rtm->rtm_dst_len)) : 0;
+    struct nlattr *dst = nlmsg_find_attr(hdr, sizeof(struct rtmsg), RTA_DST);
+    if (dst && nla_len(dst) >= (int) sizeof(in_addr_t)) {
+        memcpy(&request->dst.s_addr, nla_data(dst), sizeof(in_addr_t));
+    }
+    return true;
+}
+
+bool rom_client::write_batch(struct nl_sock *sock, size_t len, std::vector<std::pair<u_int32_t, rtnl_request> > *requests) {
+    bool done = nl_sendto(sock, batch_buf, len) >= 0;
+    if (sock == sk_rtnl) {
+        rtnl_write_count++;
+        for (std::vector<std::pair<u_int32_t, rtnl_request> >::iterator it = requests->begin(); it != requests->end(); it++) {
+            if (done) {
+                rtnl_in_flight[it->first] = it->second;
+            } else if (it->second.type == RTM_NEWROUTE) {
+                rtnl_failed.push_back(std::make_pair(it->second.dst.s_addr, it->second.mask.s_addr));
+            }
+        }
+        if (done) {
+            rtnl_ack_pending += requests->size();
+        }
+    }
+    requests->clear();
+    return done;
+}
+
+int rom_client::queue_route(struct rtnl_route *route, bool del_entry, int flags) {
+    struct nl_msg *msg = NULL;
+    int err;
+
+    if (del_entry) {
+        err = rtnl_route_build_del_request(route, flags, &msg);
+    } else {
+        err = rtnl_route_build_add_request(route, flags, &msg);
+    }
+    if (err < 0) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to build route message: %s\n", nl_geterror(err));
+        return 1;
+    }
+    rtnl_batch.push_back(msg);
+    return 0;
+}
+
+int rom_client::flush_batch(struct nl_sock *sock, std::list<struct nl_msg *> *batch) {
+    if (batch->empty()) {
+        return 0;
+    }
+    if (!sock) {
+        return -1;
+    }
+    size_t len = 0;
+    int count = 0;
+    int err = 0;
+    // route requests in batch_buf
+    std::vector<std::pair<u_int32_t, rtnl_request> > requests;
+
+    for (std::list<struct nl_msg *>::iterator it = batch->begin(); it != batch->end(); it++) {
+        struct nl_msg *msg = *it;
+        // set port id, sequence number and NLM_F_ACK (if enabled)
+        nl_complete_msg(sock, msg);
+        struct nlmsghdr *hdr = nlmsg_hdr(msg);
+        size_t msgLen = NLMSG_ALIGN(hdr->nlmsg_len);
+
+        if (len + msgLen > ROM_NL_BATCH_SIZE && len > 0) {
+            if (!write_batch(sock, len, &requests)) {
+                err = -1;
+            }
+            len = 0;
+        }
+        if (msgLen > ROM_NL_BATCH_SIZE) {
+            // never happens with route messages, but send it alone
+            if (nl_send(sock, msg) < 0) {
+                err = -1;
+            }
+        } else {
+            rtnl_request request;
+            if (sock == sk_rtnl && get_route_request(hdr, &request)) {
+                requests.push_back(std::make_pair(hdr->nlmsg_seq, request));
+            }
+            memcpy(batch_buf + len, hdr, hdr->nlmsg_len);
+            memset(batch_buf + len + hdr->nlmsg_len, 0, msgLen - hdr->nlmsg_len);
+            len += msgLen;
+        }
+        count++;
+        nlmsg_free(msg);
+    }
+    if (len > 0) {
+        if (!write_batch(sock, len, &requests)) {
+            err = -1;
+        }
+    }
+    batch->clear();
 
-    nl_object_free((struct nl_object *) route);
+    if (sock == sk_rtnl) {
+        rtnl_msg_count += count;
+    }
+    if (err) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to send netlink batch: %s(%d)\n", strerror(errno), errno);
+        return -1;
+    }
+    return count;
+}
+
+void rom_client::beginTransaction() {
+    transaction_depth++;
+}
+
+int rom_client::commitTransaction() {
+    if (transaction_depth > 0) {
+        transaction_depth--;
+    }
+    if (transaction_depth > 0) {
+        return 0;
+    }
+    // free the receive buffer before sending new requests
+    readAcks();
+
+    int err = 0;
+    // routes have to be set before ROM releases its queues
+    if (flush_batch(sk_rtnl, &rtnl_batch) < 0) {
+        err = 1;
+    }
+    if (flush_batch(sk_rom, &rom_batch) < 0) {
+        err = 1;
+    }
+    return err;
 }
 
 void rom_client::printCMD(int _cat, int _cmd, in_addr destIP, in_addr destMask, int __cmd2, in_addr nextHopIP, network_device *_device) {
@@ -203,6 +474,9 @@ void rom_client::printCMD(int _cat, int _cmd, in_addr destIP, in_addr destMask,
     case CMD_ROUTE_DELETE:
         PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_ROUTING_TABLE, "CMD_ROUTE_DELETE ");
         break;
+    case CMD_ROUTE_REPLACE:
+        PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_ROUTING_TABLE, "CMD_ROUTE_REPLACE ");
+        break;
     case CMD_ROUTE_RT_DUMP:
         PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_ROUTING_TABLE, "CMD_ROUTE_RT_DUMP ");
         break;
@@ -263,125 +537,96 @@ void rom_client::printCMD(int _cat, int _cmd, in_addr destIP, in_addr destMask,
 int rom_client::addDefaultRoute(in_addr destIP, network_device *_device, int metric) {
     PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Add default route. GW: %s. Device: %s. Metric: %d.\n",
             inet_ntoa(destIP), _device->ifname, metric);
+    struct rtnl_route *route;
     struct rtnl_nexthop *nh;
+    struct nl_addr *addr;
     int ival;
     int err = 0;
 
-    if (!rom_init())
+    in_addr defaultAddr;
+    defaultAddr.s_addr = 0;
+    route = create_route(defaultAddr, 0);
+    if (!route) {
         return 1;
+    }
 
-    /* preparing netlink messages */
-    struct nl_addr *addr;
-    std::stringstream destAddr;
-    destAddr << "0.0.0.0/0";
-    /* add route (send rtnl msg) and release queue (send rom msg) */
-    rtnl_route_set_family(route, AF_INET);
-    addr = nl_cli_addr_parse(destAddr.str().c_str(), rtnl_route_get_family(route));
-    if ((err = rtnl_route_set_dst(route, addr)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to set destination address: %s\n", nl_geterror(err));
-        rom_nl_cleanup();
+    // get if device number
+    nl_cache_mngr_data_ready(cache_mngr);
+    ival = rtnl_link_name2i(link_cache, _device->ifname);
+    if (!ival) {
+        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Device \"%s\" does not exist\n", _device->ifname);
+        rtnl_route_put(route);
         return 1;
     }
-    nl_addr_put(addr);
 
     // allocate nh
     nh = rtnl_route_nh_alloc();
     if (!nh) {
         PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Out of memory\n");
-        rom_nl_cleanup();
+        rtnl_route_put(route);
         return 1;
     }
 
     // set GW IP-address
-    addr = nl_cli_addr_parse(inet_ntoa(destIP), rtnl_route_get_family(route));
+    addr = nl_addr_build(AF_INET, &destIP.s_addr, sizeof(destIP.s_addr));
     rtnl_route_nh_set_gateway(nh, addr);
     nl_addr_put(addr);
-    // get if device number
-    ival = rtnl_link_name2i(link_cache, _device->ifname);
-    if (!ival) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Device \"%s\" does not exist\n", _device->ifname);
-        rom_nl_cleanup();
-        return 1;
-    }
     // set if
     rtnl_route_nh_set_ifindex(nh, ival);
     // set weight
     rtnl_route_nh_set_weight(nh, 64);
     rtnl_route_add_nexthop(route, nh);
 
-//    create_rom_msg(ROM_C_QREL);
-//
-//    dst_addr = destIP.s_addr;
-//    nla_put_u32(msg_rom, ROM_A_DST, dst_addr);
-
-    err = rtnl_route_add(sk_rtnl, route, 0);
-    if (err < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to add route: %s\n", nl_geterror(err));
-        rom_nl_cleanup();
-        return 1;
+    beginTransaction();
+    err = queue_route(route, false, NLM_F_CREATE);
+    rtnl_route_put(route);
+    if (commitTransaction() != 0) {
+        err = 1;
     }
 
-//    nl_send_auto_complete(sk_rom, msg_rom);
-
-    rom_nl_cleanup();
-
-    return 0;
+    return err;
 }
 
 int rom_client::deleteDefaultRoute() {
     PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Delete default route\n");
+    struct rtnl_route *route;
     int err = 0;
 
-    if (!rom_init())
-        return 1;
-
-    /* preparing netlink messages */
-    struct nl_addr *addr;
-    std::stringstream destAddr;
-    destAddr << "default/0";
-    /* add route (send rtnl msg) and release queue (send rom msg) */
-    rtnl_route_set_family(route, AF_INET);
-    addr = nl_cli_addr_parse(destAddr.str().c_str(), rtnl_route_get_family(route));
-    if ((err = rtnl_route_set_dst(route, addr)) < 0) {
-        PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to set destination address: %s\n", nl_geterror(err));
-        rom_nl_cleanup();
+    in_addr defaultAddr;
+    defaultAddr.s_addr = 0;
+    route = create_route(defaultAddr, 0);
+    if (!route) {
         return 1;
     }
-    nl_addr_put(addr);
 
-    nl_cache_foreach_filter(route_cache, OBJ_CAST(route), delete_cb, sk_rtnl);
-
-    rom_nl_cleanup();
+    beginTransaction();
+    err = queue_route(route, true, 0);
+    rtnl_route_put(route);
+    if (commitTransaction() != 0) {
+        err = 1;
+    }
 
-    return 0;
+    return err;
 }
 
 int rom_client::send(int _cat, int _cmd, in_addr destIP, in_addr destMask, int _cmd2, in_addr nextHopIP, network_device * _device) {
     printCMD(_cat, _cmd, destIP, destMask, _cmd2, nextHopIP, _device);
 
-    rtnl_add_msg_pending = 0;
-    rtnl_del_msg_pending = 0;
-    rom_msg_pending = 0;
-
     __u32 dst_addr;
     int gwstate;
     int err = 0;
-
-    if (!rom_init())
-        return 1;
+    struct rtnl_route *route = NULL;
 
     cat = _cat;
 
     if (cat == CAT_UNSPEC) {
-        rom_nl_cleanup();
         return 1;
     }
 
     cmd = _cmd;
+    msg_rom = NULL;
 
     /* preparing netlink messages */
-    struct nl_addr *addr;
-    std::stringstream destAddr;
     int maskSize = 0;
     if (_cmd != CMD_CORE_SETGW) {
         uint32_t maskBit = 1;
@@ -394,51 +639,39 @@ int rom_client::send(int _cat, int _cmd, in_addr destIP, in_addr destMask, int _
     }
     switch (cmd) {
     case CMD_ROUTE_ADD:
-        /* add route (send rtnl msg) and release queue (send rom msg) */
-//        nl_cli_route_parse_dst(route, argv[3]);
-        destAddr << inet_ntoa(destIP) << "/" << maskSize;
-        PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_ROUTING_TABLE, "dest addr = %s\n", destAddr.str().c_str());
-        addr = nl_cli_addr_parse(destAddr.str().c_str(), rtnl_route_get_family(route));
-        if ((err = rtnl_route_set_dst(route, addr)) < 0) {
-            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to set destination address: %s\n", nl_geterror(err));
+    case CMD_ROUTE_REPLACE:
+        /* add or replace route (send rtnl msg) */
+        route = create_route(destIP, maskSize);
+        if (!route) {
             return 1;
         }
-        nl_addr_put(addr);
 
         if (_cmd2 == CMD2_VIA) {
-            route_dest_IP.str("");
-            route_dest_IP << destAddr;
-            route_nextHop_IP.str("");
-            route_nextHop_IP << inet_ntoa(destIP);
-//            route_device.str("");
-//            route_device << _device->ifname;
-            rtnl_add_nexthop_via(route, inet_ntoa(nextHopIP));
+            if (!rtnl_add_nexthop_via(route, nextHopIP)) {
+                err = 1;
+            }
         } else if (_cmd2 == CMD2_DEV) {
-            route_dest_IP.str("");
-            route_dest_IP << destAddr;
-            route_nextHop_IP.str("");
-            route_nextHop_IP << inet_ntoa(nextHopIP);
-//            route_device.str("");
-            rtnl_add_nexthop_dev(route, _device, link_cache);
+            if (!rtnl_add_nexthop_dev(route, _device)) {
+                err = 1;
+            }
         } else {
             err = 1;
         }
 
-        rtnl_add_msg_pending = 1;
+        if (err == 0 && cmd == CMD_ROUTE_REPLACE) {
+            err = queue_route(route, false, NLM_F_CREATE | NLM_F_REPLACE);
+        } else if (err == 0) {
+            err = queue_route(route, false, NLM_F_CREATE);
+        }
         break;
 
     case CMD_ROUTE_DELETE:
         /* delete route (send rtnl msg) */
-//        nl_cli_route_parse_dst(route, argv[3]);
-        destAddr << inet_ntoa(destIP) << "/" << maskSize;
-        addr = nl_cli_addr_parse(destAddr.str().c_str(), rtnl_route_get_family(route));
-        if ((err = rtnl_route_set_dst(route, addr)) < 0) {
-            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to set destination address: %s\n", nl_geterror(err));
+        route = create_route(destIP, maskSize);
+        if (!route) {
             return 1;
         }
-        nl_addr_put(addr);
-
-        rtnl_del_msg_pending = 1;
+        err = queue_route(route, true, 0);
         break;
 
     case CMD_ROUTE_TIMEOUT:
@@ -493,36 +726,25 @@ int rom_client::send(int _cat, int _cmd, in_addr destIP, in_addr destMask, int _
         break;
     }
 
+    if (route) {
+        rtnl_route_put(route);
+    }
+
     if (err != 0) {
-        rom_nl_cleanup();
         if (msg_rom) {
             nlmsg_free(msg_rom);
         }
+        msg_rom = NULL;
         return EXIT_FAILURE;
     }
 
-    if (rtnl_add_msg_pending) {
-        err = rtnl_route_add(sk_rtnl, route, 0);
-        if (err < 0) {
-            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "Unable to add route: %s\n", nl_geterror(err));
-            rom_nl_cleanup();
-            if (msg_rom) {
-                nlmsg_free(msg_rom);
-            }
-            return 1;
-        }
-    }
-
-    if (rtnl_del_msg_pending) {
-        nl_cache_foreach_filter(route_cache, OBJ_CAST(route), delete_cb, sk_rtnl);
-    }
-
-    if (rom_msg_pending)
-        nl_send_auto_complete(sk_rom, msg_rom);
-
-    rom_nl_cleanup();
+    beginTransaction();
     if (msg_rom) {
-        nlmsg_free(msg_rom);
+        rom_batch.push_back(msg_rom);
+    }
+    msg_rom = NULL;
+    if (commitTransaction() != 0) {
+        return 1;
     }
 
     return 0;
@@ -32,6 +32,9 @@ class rom_client;
 #include <stdlib.h>
 #include <arpa/inet.h>
 #include <string.h>
+#include <list>
+#include <map>
+#include <vector>
 #include "rom.h"
 
 #include <netlink/netlink.h>
@@ -40,8 +43,23 @@ class rom_client;
 #include <netlink/cli/utils.h>
 #include <netlink/cli/route.h>
 #include <netlink/cli/link.h>
+#include <netlink/cache.h>
+#include <netlink/route/route.h>
+#include <netlink/route/link.h>
 
 
+/// Maximum size of one batched netlink write (bytes)
+#define ROM_NL_BATCH_SIZE (16 * 1024)
+
+/**
+ * A route request which is sent to the kernel and not yet acknowledged.
+ */
+struct rtnl_request {
+    int type;                   ///< RTM_NEWROUTE or RTM_DELROUTE
+    struct in_addr dst;         ///< Destination of the route
+    struct in_addr mask;        ///< Network mask of the route
+};
+
 class rom_client {
 private:
     int cat;
@@ -49,29 +67,83 @@ private:
     struct nl_msg *msg_rom;
     struct nl_sock *sk_rom;
     struct nl_sock *sk_rtnl;
+    struct nl_cache_mngr *cache_mngr;
+    struct nl_cb *rtnl_cb;
     int rom_family;
-    int rom_msg_pending;
-    int rtnl_add_msg_pending;
-    int rtnl_del_msg_pending;
     struct nl_cache *link_cache;
-    struct nl_cache *route_cache;
-    struct rtnl_route *route;
 
     PASER_global *pGlobal;
 
-    std::stringstream route_dest_IP;
-    std::stringstream route_nextHop_IP;
-//    std::stringstream route_device;
+    /// Number of opened transactions. Messages are only sent if the counter drops to 0.
+    int transaction_depth;
+    /// Pending rtnetlink messages of the current transaction
+    std::list<struct nl_msg *> rtnl_batch;
+    /// Pending ROM messages of the current transaction
+    std::list<struct nl_msg *> rom_batch;
+
+    /// Number of rtnetlink messages which are not acknowledged yet
+    u_int32_t rtnl_ack_pending;
+    /// Number of sent rtnetlink messages
+    u_int32_t rtnl_msg_count;
+    /// Number of rtnetlink writes (syscalls)
+    u_int32_t rtnl_write_count;
+    /// Number of rtnetlink messages which are acknowledged with an error
+    u_int32_t rtnl_error_count;
+
+    /// Write buffer of flush_batch() (ROM_NL_BATCH_SIZE bytes)
+    uint8_t *batch_buf;
+    /// Sent route requests by sequence number
+    std::map<u_int32_t, rtnl_request> rtnl_in_flight;
+    /// Routes (destination, mask) which could not be added or replaced
+    std::list<std::pair<Uint128, Uint128> > rtnl_failed;
+
 private:
     int get_ip_from_arg(const char *src, __u32 *dst);
     int arg_is_str(char *arg, char *str);
     void create_rom_msg(int type);
-    void rtnl_add_nexthop_via(struct rtnl_route *route, const char *via_addr);
-    void rtnl_add_nexthop_dev(struct rtnl_route *route, network_device * _device, struct nl_cache *link_cache);
-    static void delete_cb(struct nl_object *obj, void *arg);
+    struct rtnl_route *create_route(in_addr destIP, int maskSize);
+    bool rtnl_add_nexthop_via(struct rtnl_route *route, in_addr via_addr);
+    bool rtnl_add_nexthop_dev(struct rtnl_route *route, network_device * _device);
     bool rom_init(void);
     void rom_nl_cleanup(void);
 
+    /**
+     * Put a route request into the current transaction.
+     *
+     *@param route Route template. Will be not freed.
+     *@param del_entry if true then RTM_DELROUTE will be queued. Else RTM_NEWROUTE.
+     *@param flags Netlink flags of the message (NLM_F_CREATE, NLM_F_REPLACE, ...)
+     *
+     *@return 0 on success
+     */
+    int queue_route(struct rtnl_route *route, bool del_entry, int flags);
+
+    /**
+     * Send all messages from the list in as few writes as possible and free them.
+     * Route requests of a failed write are reported by getFailedRoutes().
+     *
+     *@return number of sent messages or -1 on error
+     */
+    int flush_batch(struct nl_sock *sock, std::list<struct nl_msg *> *batch);
+
+    /**
+     * Write the buffer to the socket. The route requests in the buffer are
+     * waiting for an ACK on success, else they are reported as failed.
+     *
+     *@return true on success
+     */
+    bool write_batch(struct nl_sock *sock, size_t len, std::vector<std::pair<u_int32_t, rtnl_request> > *requests);
+
+    /**
+     * Get the route request of an rtnetlink message.
+     *
+     *@return false if the message is no route request
+     */
+    static bool get_route_request(struct nlmsghdr *hdr, rtnl_request *request);
+
+    static int rtnl_ack_cb(struct nl_msg *msg, void *arg);
+    static int rtnl_err_cb(struct sockaddr_nl *nla, struct nlmsgerr *nlerr, void *arg);
+
     void printCMD(int _cat, int _cmd, in_addr destIP, in_addr destMask, int _cmd2, in_addr nextHopIP, network_device *_device);
 
 public:
@@ -82,6 +154,54 @@ public:
     int addDefaultRoute(in_addr destIP, network_device *_device, int metric);
     int deleteDefaultRoute();
 
+    /**
+     * Open a transaction. All following route and ROM commands will be queued
+     * and sent with the matching call of commitTransaction().
+     * Transactions can be nested.
+     */
+    void beginTransaction();
+
+    /**
+     * Close a transaction. If it is the outermost transaction, all queued
+     * rtnetlink messages will be sent in one multi-message write followed by
+     * the queued ROM messages. The acknowledgements are collected in readAcks().
+     *
+     *@return 0 on success
+     */
+    int commitTransaction();
+
+    /**
+     * Read all available acknowledgements from the rtnetlink socket.
+     * The function does not block.
+     */
+    void readAcks();
+
+    /**
+     * Get file descriptor of the rtnetlink socket.
+     */
+    int getRtnlSocket();
+
+    /**
+     * Get all routes which the kernel refused to add or replace, or which
+     * could not be sent, since the last call. The errors of the kernel are
+     * received asynchronously in readAcks().
+     *
+     *@param routes List to which the pairs of destination and mask are appended
+     */
+    void getFailedRoutes(std::list<std::pair<Uint128, Uint128> > *routes);
+
+    u_int32_t getAckPending() {
+        return rtnl_ack_pending;
+    }
+    u_int32_t getMsgCount() {
+        return rtnl_msg_count;
+    }
+    u_int32_t getWriteCount() {
+        return rtnl_write_count;
+    }
+    u_int32_t getErrorCount() {
+        return rtnl_error_count;
+    }
 };
 
 #endif
@@ -104,7 +104,7 @@ void PASER_route_maintenance::timeout_KDC_request(PASER_timer_packet *t) {
                 paser_configuration->getNetDevice()[0].ipaddr, cert, pGlobal->getLastGwSearchNonce());
         free(cert.buf);
         t->timeout = timeval_add(t->timeout, PASER_KDC_REQUEST_TIME);
-        pGlobal->getTimer_queue()->timer_sort();
+        pGlobal->getTimer_queue()->timer_add(t);
     }
     return;
 }
@@ -178,7 +178,7 @@ void PASER_route_maintenance::timeout_ROUTE_DISCOVERY_UB(PASER_timer_packet *t)
         pGlobal->incSeqNr();
         pGlobal->getPASERtimeofday(&(t->timeout));
         t->timeout = timeval_add(t->timeout, PASER_UB_RREQ_WAIT_TIME);
-        pGlobal->getTimer_queue()->timer_sort();
+        pGlobal->getTimer_queue()->timer_add(t);
         if (pGlobal->getPaser_configuration()->isResetHelloByBroadcast()) {
             pGlobal->resetHelloTimer();
         }
@@ -231,7 +231,7 @@ void PASER_route_maintenance::timeout_ROUTINGTABLE_NO_VALID_ENTRY(PASER_timer_pa
     struct in_addr destAddr = t->destAddr;
     PASER_routing_entry *rEntry = pGlobal->getRouting_table()->findDest(t->destAddr);
     if (rEntry != NULL) {
-        rEntry->isValid = 0;
+        pGlobal->getRouting_table()->setValid(rEntry, 0);
         rEntry->validTimer = NULL;
         PASER_neighbor_entry *nEntry = pGlobal->getNeighbor_table()->findNeigh(t->destAddr);
         if (nEntry != NULL) {
@@ -351,7 +351,7 @@ void PASER_route_maintenance::timeout_TU_RREP_ACK_TIMEOUT(PASER_timer_packet *t)
 
         pGlobal->getPASERtimeofday(&(t->timeout));
         t->timeout = timeval_add(t->timeout, PASER_UU_RREP_WAIT_TIME);
-        pGlobal->getTimer_queue()->timer_sort();
+        pGlobal->getTimer_queue()->timer_add(t);
         delete packetToSend;
         return;
     }
@@ -427,7 +427,7 @@ void PASER_route_maintenance::timeout_HELLO_SEND_TIMEOUT(PASER_timer_packet *t)
     }
     pGlobal->getPASERtimeofday(&(t->timeout));
     t->timeout = timeval_add(t->timeout, PASER_TB_HELLO_Interval);
-    pGlobal->getTimer_queue()->timer_sort();
+    pGlobal->getTimer_queue()->timer_add(t);
 }
 
 void PASER_route_maintenance::timeout_ROOT_TIMEOUT(PASER_timer_packet *t) {
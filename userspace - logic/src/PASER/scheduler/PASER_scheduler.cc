@@ -32,6 +32,12 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <sys/epoll.h>
+
+/// Maximum number of socket events handled in one scheduler step
+#define PASER_SCHEDULER_MAX_EVENTS 64
+/// Maximum number of batched reads from one PASER device socket in one scheduler step
+#define PASER_SCHEDULER_MAX_BATCHES 4
 
 PASER_scheduler::PASER_scheduler(PASER_global *paser_global) {
     pGlobal = paser_global;
@@ -42,9 +48,10 @@ PASER_scheduler::~PASER_scheduler() {
 }
 
 void PASER_scheduler::scheduler() {
-    int maxFD = 0;
     int numberOfRrequests = 0;
-    fd_set rset;
+    struct epoll_event events[PASER_SCHEDULER_MAX_EVENTS];
+    lv_block packets[PASER_RECV_BATCH_SIZE];
+    int epollFD = pGlobal->getPASER_socket()->getEpollFD();
 
     // main Loop - endless
 //#ifdef PASER_SOCKET_TEST
@@ -54,59 +61,26 @@ void PASER_scheduler::scheduler() {
     while(isRunning) {
 //#endif
         pGlobal->UpdateTime();
-        maxFD = 0;
-        FD_ZERO(&rset);
         PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Start scheduler step.\n");
-        // add PASER Device sockets to select
-        for (uint32_t i = 0; i < pGlobal->getPaser_configuration()->getNetDeviceNumber(); i++) {
-            if (DEV_NR(i).enabled) {
-                FD_SET(DEV_NR(i).sock, &rset);
-                PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, " Add net device socket to select: %s\n", DEV_NR(i).ifname);
-                if (maxFD < DEV_NR(i).sock) {
-                    maxFD = DEV_NR(i).sock;
-                }
-            }
-        }
-
-        // add PASER Ethernet Device sockets to select
-        std::map<int, SSL*> socketMap = pGlobal->getPASER_socket()->getSocketMap();
-        for (std::map<int, SSL*>::iterator it = socketMap.begin(); it != socketMap.end(); it++) {
-            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, " Add net SSL socket to select: %d\n", it->first);
-            FD_SET(it->first, &rset);
-            if (maxFD < it->first) {
-                maxFD = it->first;
-            }
-        }
-
-        FD_SET(pGlobal->getPASER_socket()->getSocketToKernel(), &rset);
-        if (maxFD < pGlobal->getPASER_socket()->getSocketToKernel()) {
-            maxFD = pGlobal->getPASER_socket()->getSocketToKernel();
-        }
-
-        maxFD++;
 
         // get next Timeout
-        timeval timeEvent;
-        timeval diff;
+        int timeout;
         if (pGlobal->getTimer_queue()->timer_get_next_timer() != NULL) {
-            timeEvent = pGlobal->getTimer_queue()->timer_get_next_timer()->timeout;
+            timeval timeEvent = pGlobal->getTimer_queue()->timer_get_next_timer()->timeout;
             timeval now;
             pGlobal->getPASERtimeofday(&now);
             // calculate time to next timeout (next - now)
-//            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "next timeout: sec:%ld, usec: %ld\n", timeEvent.tv_sec, timeEvent.tv_usec);
-//            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "now  timeout: sec:%ld, usec: %ld\n", now.tv_sec, now.tv_usec);
-            diff = timeDiff(timeEvent, now);
+            timeval diff = timeDiff(timeEvent, now);
+            // round up to milliseconds, so the timer is expired after wakeup
+            timeout = diff.tv_sec * 1000 + (diff.tv_usec + 999) / 1000;
             // wait for data/connect/timeouts...
-            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "select timeout: sec:%ld, usec: %ld\n", diff.tv_sec, diff.tv_usec);
-            numberOfRrequests = select(maxFD, &rset, NULL, NULL, &diff);
+            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "epoll timeout: sec:%ld, usec: %ld\n", diff.tv_sec, diff.tv_usec);
         } else {
             // wait for data/connect/timeouts...
-            timeval waiting;
-            waiting.tv_sec = 2;
-            waiting.tv_usec = 0;
-            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "select timeout: waiting\n");
-            numberOfRrequests = select(maxFD, &rset, NULL, NULL, &waiting);
+            timeout = 2000;
+            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "epoll timeout: waiting\n");
         }
+        numberOfRrequests = epoll_wait(epollFD, events, PASER_SCHEDULER_MAX_EVENTS, timeout);
         if(!isRunning){
             break;
         }
@@ -114,50 +88,81 @@ void PASER_scheduler::scheduler() {
 
         if (numberOfRrequests < 0) {
             // print ERROR
-            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "select failed: (%d)%s\n", errno, strerror( errno ));
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "epoll_wait failed: (%d)%s\n", errno, strerror( errno ));
             continue;
         }
 
-        // check PASER PASER Device sockets
-        for (uint32_t i = 0; i < pGlobal->getPaser_configuration()->getNetDeviceNumber(); i++) {
-            if (DEV_NR(i).enabled) {
-                if (FD_ISSET(DEV_NR(i).sock, &rset)) {
-                    lv_block data = pGlobal->getPASER_socket()->readDataFromNetwork(&(DEV_NR(i)));
-                    PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Read data from PASER device: %s\n", DEV_NR(i).ifname);
-                    if (data.len != -1) {
-                        pGlobal->getPacket_processing()->handleLowerMsg(data.buf, data.len, DEV_NR(i).ifindex);
+        // collect all kernel route changes and all outgoing packets of this step and send them at once
+        pGlobal->getPASER_socket()->beginRouteTransaction();
+        pGlobal->getPASER_socket()->beginSendTransaction();
+
+        bool routeSocketReady = false;
+        for (int i = 0; i < numberOfRrequests; i++) {
+            paser_socket_type type = (paser_socket_type) (events[i].data.u64 >> 32);
+            u_int32_t index = (u_int32_t) events[i].data.u64;
+            switch (type) {
+            case SOCKET_DEVICE: {
+                // check PASER Device socket. Drain the socket in batches,
+                // but not more than PASER_SCHEDULER_MAX_BATCHES to serve the other sockets and timers.
+                for (int batch = 0; batch < PASER_SCHEDULER_MAX_BATCHES; batch++) {
+                    int n = pGlobal->getPASER_socket()->readDataFromNetwork(&(DEV_NR(index)), packets);
+                    PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Read %d packets from PASER device: %s\n", n, DEV_NR(index).ifname);
+                    pGlobal->getPacket_processing()->handleLowerMsgs(packets, n, DEV_NR(index).ifindex);
+                    if (n < PASER_RECV_BATCH_SIZE) {
+                        break;
                     }
                 }
+                break;
             }
-        }
-
-        // check PASER Ethernet Device sockets
-        for (std::map<int, SSL*>::iterator it = socketMap.begin(); it != socketMap.end(); it++) {
-            if (FD_ISSET(it->first, &rset)) {
-                lv_block data = pGlobal->getPASER_socket()->readDataFromSSL(it->first);
-                PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Read data from SSL socket: %d\n", it->first);
+            case SOCKET_SSL: {
+                // check PASER Ethernet Device socket
+                int sock = (int) index;
+                // the socket could be closed while processing of previous events
+                if (pGlobal->getPASER_socket()->getSocketMap().count(sock) == 0) {
+                    break;
+                }
+                lv_block data = pGlobal->getPASER_socket()->readDataFromSSL(sock);
+                PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Read data from SSL socket: %d\n", sock);
                 if (data.len == 0) {
                     //close SSL Socket
-                    PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Close SSL socket: %d\n", it->first);
-                    pGlobal->getPASER_socket()->closeSSLSocket(it->first);
-                    continue;
+                    PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Close SSL socket: %d\n", sock);
+                    pGlobal->getPASER_socket()->closeSSLSocket(sock);
+                    break;
                 }
                 pGlobal->getPacket_processing()->handleLowerMsg(data.buf, data.len, ETHDEV_NR(0).ifindex);
+                break;
             }
-        }
-
-        // check kernel Socket
-        if(FD_ISSET(pGlobal->getPASER_socket()->getSocketToKernel(), &rset)){
-            lv_block data = pGlobal->getPASER_socket()->readDataFromKernel();
-            PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Read data from Kernel Socket\n");
-            if(data.len > 0){
-            	free(data.buf);
+            case SOCKET_KERNEL: {
+                // check kernel Socket
+                lv_block data = pGlobal->getPASER_socket()->readDataFromKernel();
+                PASER_LOG_WRITE_LOG(PASER_LOG_SCHEDULER, "Read data from Kernel Socket\n");
+                if(data.len > 0){
+                    free(data.buf);
+                }
+                break;
+            }
+            case SOCKET_ROUTE:
+                // route ACKs are read after the commit of this step
+                routeSocketReady = true;
+                break;
+            case SOCKET_VERIFY:
+                // continue with the messages whose signatures are verified
+                pGlobal->getPacket_processing()->handleVerifiedMsgs();
+                break;
             }
         }
 
 //        PASER_LOG_WRITE_LOG(PASER_LOG_TIMEOUT_INFO, "%s",pGlobal->getTimer_queue()->detailedInfo().c_str());
 //        PASER_LOG_WRITE_LOG(PASER_LOG_TIMEOUT_INFO, "%s",pGlobal->getNeighbor_table()->detailedInfo().c_str());
         walk_timers();
+
+        pGlobal->getPASER_socket()->commitSendTransaction();
+        pGlobal->getPASER_socket()->commitRouteTransaction();
+
+        // check rtnetlink socket
+        if (routeSocketReady) {
+            pGlobal->getPASER_socket()->readRouteAcks();
+        }
     }
 
 }
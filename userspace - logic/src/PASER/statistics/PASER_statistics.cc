@@ -38,6 +38,17 @@ PASER_statistics::PASER_statistics(PASER_global *paser_global) {
     unicastPackets = 0;
     sendbytes = 0;
 
+    certCacheHits = 0;
+    certCacheMisses = 0;
+    certHitTime = 0;
+    certMissTime = 0;
+    signCacheHits = 0;
+    signCacheMisses = 0;
+
+    memset(verifyLatency, 0, sizeof(verifyLatency));
+    memset(verifyQueueDepth, 0, sizeof(verifyQueueDepth));
+    verifyDrops = 0;
+
     RoutingAdd = NULL;
     RoutingDelete = NULL;
     RoutingBreak = NULL;
@@ -52,6 +63,10 @@ PASER_statistics::PASER_statistics(PASER_global *paser_global) {
     if (PASER_LOG_ROUTE_MODIFICATION_TIMEOUT)
         RoutingTimeout = fopen(PASERD_ROUTE_TIMEOUT_LOG_FILE, "w");
     logfile = fopen(PASERD_OVERHEAD_LOG_FILE, "w");
+    receiveLogfile = fopen(PASERD_RECEIVE_LOG_FILE, "w");
+    sendLogfile = fopen(PASERD_SEND_LOG_FILE, "w");
+    cryptoLogfile = fopen(PASERD_CRYPTO_LOG_FILE, "w");
+    verifyLogfile = fopen(PASERD_VERIFY_LOG_FILE, "w");
 
 }
 
@@ -60,6 +75,39 @@ PASER_statistics::~PASER_statistics() {
         fprintf(logfile, "%d\t%d\t%ld\n", broatcastPackets, unicastPackets, sendbytes);
         fclose(logfile);
     }
+    if (receiveLogfile) {
+        // ifIndex  batches  packets  maxBatch  drops
+        for (std::map<u_int32_t, receive_stats>::iterator it = receiveStats.begin(); it != receiveStats.end(); it++) {
+            fprintf(receiveLogfile, "%u\t%ld\t%ld\t%d\t%ld\n", it->first, it->second.batches, it->second.packets,
+                    it->second.maxBatch, it->second.drops);
+        }
+        fclose(receiveLogfile);
+    }
+    if (sendLogfile) {
+        // ifIndex  flushes  packets  bytes  maxFlush
+        for (std::map<u_int32_t, send_stats>::iterator it = sendStats.begin(); it != sendStats.end(); it++) {
+            fprintf(sendLogfile, "%u\t%ld\t%ld\t%ld\t%d\n", it->first, it->second.flushes, it->second.packets,
+                    it->second.bytes, it->second.maxFlush);
+        }
+        fclose(sendLogfile);
+    }
+    if (cryptoLogfile) {
+        // hits  misses  hitRate  avgHitTime(usec)  avgMissTime(usec)
+        fprintf(cryptoLogfile, "%ld\t%ld\t%.3f\t%ld\t%ld\n", certCacheHits, certCacheMisses, getCertCacheHitRate(),
+                certCacheHits ? certHitTime / certCacheHits : 0, certCacheMisses ? certMissTime / certCacheMisses : 0);
+        // signHits  signMisses
+        fprintf(cryptoLogfile, "%ld\t%ld\n", signCacheHits, signCacheMisses);
+        fclose(cryptoLogfile);
+    }
+    if (verifyLogfile) {
+        // drops
+        // upperBound  latency(usec)  queueDepth
+        fprintf(verifyLogfile, "%ld\n", verifyDrops);
+        for (int i = 0; i < PASER_STATS_HISTOGRAM_SIZE; i++) {
+            fprintf(verifyLogfile, "%ld\t%ld\t%ld\n", 1L << i, verifyLatency[i], verifyQueueDepth[i]);
+        }
+        fclose(verifyLogfile);
+    }
     if (RoutingAdd)
         fclose(RoutingAdd);
     if (RoutingDelete)
@@ -124,3 +172,87 @@ void PASER_statistics::incUnicastPackets() {
 void PASER_statistics::addToSendBytes(long s) {
     sendbytes += s;
 }
+
+static receive_stats &getReceiveStats(std::map<u_int32_t, receive_stats> &stats, u_int32_t ifIndex) {
+    std::map<u_int32_t, receive_stats>::iterator it = stats.find(ifIndex);
+    if (it == stats.end()) {
+        receive_stats empty;
+        memset(&empty, 0, sizeof(empty));
+        it = stats.insert(std::make_pair(ifIndex, empty)).first;
+    }
+    return it->second;
+}
+
+void PASER_statistics::addReceiveBatch(u_int32_t ifIndex, int packets) {
+    receive_stats &stats = getReceiveStats(receiveStats, ifIndex);
+    stats.batches++;
+    stats.packets += packets;
+    if (stats.maxBatch < packets) {
+        stats.maxBatch = packets;
+    }
+}
+
+void PASER_statistics::incReceiveDrops(u_int32_t ifIndex) {
+    getReceiveStats(receiveStats, ifIndex).drops++;
+}
+
+void PASER_statistics::addSendFlush(u_int32_t ifIndex, int packets, long bytes) {
+    std::map<u_int32_t, send_stats>::iterator it = sendStats.find(ifIndex);
+    if (it == sendStats.end()) {
+        send_stats empty;
+        memset(&empty, 0, sizeof(empty));
+        it = sendStats.insert(std::make_pair(ifIndex, empty)).first;
+    }
+    it->second.flushes++;
+    it->second.packets += packets;
+    it->second.bytes += bytes;
+    if (it->second.maxFlush < packets) {
+        it->second.maxFlush = packets;
+    }
+}
+
+void PASER_statistics::addCertVerify(bool cacheHit, long usec) {
+    if (cacheHit) {
+        certCacheHits++;
+        certHitTime += usec;
+    } else {
+        certCacheMisses++;
+        certMissTime += usec;
+    }
+}
+
+double PASER_statistics::getCertCacheHitRate() {
+    if (certCacheHits + certCacheMisses == 0) {
+        return 0;
+    }
+    return (double) certCacheHits / (certCacheHits + certCacheMisses);
+}
+
+void PASER_statistics::addSignVerify(bool cacheHit) {
+    if (cacheHit) {
+        signCacheHits++;
+    } else {
+        signCacheMisses++;
+    }
+}
+
+static int getHistogramBucket(long value) {
+    int bucket = 0;
+    while (value > 0 && bucket < PASER_STATS_HISTOGRAM_SIZE - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void PASER_statistics::addVerifyLatency(long usec) {
+    verifyLatency[getHistogramBucket(usec)]++;
+}
+
+void PASER_statistics::addVerifyQueueDepth(u_int32_t depth) {
+    verifyQueueDepth[getHistogramBucket(depth)]++;
+}
+
+void PASER_statistics::incVerifyDrops() {
+    verifyDrops++;
+}
@@ -27,8 +27,32 @@ class PASER_statistics;
 
 
 #include <stdio.h>
+#include <map>
 #include "../config/PASER_global.h"
 
+/// Number of buckets of a histogram. Bucket i counts the values in [2^(i-1), 2^i), bucket 0 counts 0.
+#define PASER_STATS_HISTOGRAM_SIZE 24
+
+/**
+ * Receive counters of a PASER network device.
+ */
+struct receive_stats {
+    long batches;   ///< Number of batched reads which returned at least one datagram
+    long packets;   ///< Number of received datagrams
+    int maxBatch;   ///< Largest number of datagrams received with one read
+    long drops;     ///< Number of truncated or unreadable datagrams
+};
+
+/**
+ * Send counters of a PASER network device.
+ */
+struct send_stats {
+    long flushes;   ///< Number of flushes of the send queue
+    long packets;   ///< Number of sent datagrams
+    long bytes;     ///< Number of sent bytes
+    int maxFlush;   ///< Largest number of datagrams sent with one flush
+};
+
 class PASER_statistics {
 public:
     PASER_statistics(PASER_global *paser_global);
@@ -42,6 +66,51 @@ public:
     void incBroadcastPackets();
     void incUnicastPackets();
     void addToSendBytes(long s);
+
+    /**
+     * Count a batched read of <b>packets</b> datagrams on the interface <b>ifIndex</b>.
+     */
+    void addReceiveBatch(u_int32_t ifIndex, int packets);
+    /**
+     * Count a dropped datagram on the interface <b>ifIndex</b>.
+     */
+    void incReceiveDrops(u_int32_t ifIndex);
+    /**
+     * Count a flush of the send queue on the interface <b>ifIndex</b>
+     * with <b>packets</b> datagrams and <b>bytes</b> bytes.
+     */
+    void addSendFlush(u_int32_t ifIndex, int packets, long bytes);
+
+    /**
+     * Count a certificate verification which took <b>usec</b> microseconds.
+     *
+     *@param cacheHit true if the result was found in the cache of verified certificates
+     */
+    void addCertVerify(bool cacheHit, long usec);
+    /**
+     * Get the hit rate of the cache of verified certificates (0..1).
+     */
+    double getCertCacheHitRate();
+    /**
+     * Count a message signature check.
+     *
+     *@param cacheHit true if the result was found in the cache of checked signatures
+     */
+    void addSignVerify(bool cacheHit);
+
+    /**
+     * Count an asynchronous signature verification which took <b>usec</b>
+     * microseconds from the submission to the return to the scheduler.
+     */
+    void addVerifyLatency(long usec);
+    /**
+     * Count the number of pending signature verifications at the submission of a new one.
+     */
+    void addVerifyQueueDepth(u_int32_t depth);
+    /**
+     * Count a message which was dropped because the verification queue was full.
+     */
+    void incVerifyDrops();
 private:
     PASER_global *pGlobal;
 
@@ -49,11 +118,29 @@ private:
     int unicastPackets;
     long sendbytes;
 
+    std::map<u_int32_t, receive_stats> receiveStats;
+    std::map<u_int32_t, send_stats> sendStats;
+
+    long certCacheHits;
+    long certCacheMisses;
+    long certHitTime;   ///< Sum of verification times of cache hits (usec)
+    long certMissTime;  ///< Sum of verification times of cache misses (usec)
+    long signCacheHits;
+    long signCacheMisses;
+
+    long verifyLatency[PASER_STATS_HISTOGRAM_SIZE];     ///< Histogram of signature verification latencies (usec)
+    long verifyQueueDepth[PASER_STATS_HISTOGRAM_SIZE];  ///< Histogram of verification queue depths
+    long verifyDrops;   ///< Number of messages dropped because the verification queue was full
+
     FILE *RoutingAdd;
     FILE *RoutingTimeout;
     FILE *RoutingDelete;
     FILE *RoutingBreak;
     FILE *logfile;
+    FILE *receiveLogfile;
+    FILE *sendLogfile;
+    FILE *cryptoLogfile;
+    FILE *verifyLogfile;
 
 };
 
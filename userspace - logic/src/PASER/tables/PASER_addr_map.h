@@ -0,0 +1,254 @@
+/**
+ *\class  		PASER_addr_map
+ *@brief       	Class implements a flat hash map which is keyed by IPv4 addresses.
+ *@ingroup 		Tables
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#ifndef PASER_ADDR_MAP_H_
+#define PASER_ADDR_MAP_H_
+
+#include "../config/PASER_defs.h"
+
+#include <vector>
+#include <utility>
+
+/// Minimum number of slots of a PASER_addr_map
+#define PASER_ADDR_MAP_MIN_SIZE 16
+
+/**
+ * Hash map from an IP address (s_addr) to a value which is stored inline
+ * in a flat slot array. Collisions are resolved by linear probing. The
+ * table is kept at most half full. An erased slot is refilled by shifting
+ * the following slots of its probe sequence back, so no tombstones are left.
+ *
+ * Like std::map, the slots have the members <b>first</b> (address) and
+ * <b>second</b> (value). The order of the iteration is not defined.
+ * insert() and erase() invalidate all iterators.
+ */
+template<class V>
+class PASER_addr_map {
+public:
+    struct slot {
+        Uint128 first;
+        V second;
+        bool used;
+    };
+
+    class iterator {
+    private:
+        std::vector<slot> *slots;
+        size_t pos;
+
+    public:
+        iterator() {
+            slots = NULL;
+            pos = 0;
+        }
+
+        iterator(std::vector<slot> *slots, size_t pos) {
+            this->slots = slots;
+            this->pos = pos;
+            skipUnused();
+        }
+
+        slot &operator*() const {
+            return (*slots)[pos];
+        }
+
+        slot *operator->() const {
+            return &(*slots)[pos];
+        }
+
+        iterator &operator++() {
+            pos++;
+            skipUnused();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator &other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return pos != other.pos;
+        }
+
+        size_t getPos() const {
+            return pos;
+        }
+
+    private:
+        void skipUnused() {
+            while (pos < slots->size() && !(*slots)[pos].used) {
+                pos++;
+            }
+        }
+    };
+
+private:
+    std::vector<slot> slots;
+    size_t count;
+    size_t mask;        ///< Number of slots - 1
+    int bits;           ///< log2 of the number of slots
+
+public:
+    PASER_addr_map() {
+        count = 0;
+        init(PASER_ADDR_MAP_MIN_SIZE);
+    }
+
+    iterator begin() {
+        return iterator(&slots, 0);
+    }
+
+    iterator end() {
+        return iterator(&slots, slots.size());
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * Find the slot of an address.
+     *
+     *@return iterator to the slot or end()
+     */
+    iterator find(Uint128 key) {
+        for (size_t i = home(key);; i = (i + 1) & mask) {
+            if (!slots[i].used) {
+                return end();
+            }
+            if (slots[i].first == key) {
+                return iterator(&slots, i);
+            }
+        }
+    }
+
+    /**
+     * Insert a value if the address is not yet in the map.
+     *
+     *@return iterator to the slot of the address and true if the value was inserted
+     */
+    std::pair<iterator, bool> insert(const std::pair<Uint128, V> &value) {
+        iterator it = find(value.first);
+        if (it != end()) {
+            return std::make_pair(it, false);
+        }
+        if ((count + 1) * 2 > slots.size()) {
+            rehash(slots.size() * 2);
+        }
+        size_t i = home(value.first);
+        while (slots[i].used) {
+            i = (i + 1) & mask;
+        }
+        slots[i].first = value.first;
+        slots[i].second = value.second;
+        slots[i].used = true;
+        count++;
+        return std::make_pair(iterator(&slots, i), true);
+    }
+
+    /**
+     * Erase the slot of an iterator.
+     */
+    void erase(iterator it) {
+        size_t i = it.getPos();
+        // move the following slots of the probe sequence back into the gap
+        for (size_t j = (i + 1) & mask; slots[j].used; j = (j + 1) & mask) {
+            size_t h = home(slots[j].first);
+            if (((j - h) & mask) >= ((j - i) & mask)) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i].used = false;
+        slots[i].second = V();
+        count--;
+    }
+
+    /**
+     * Erase an address.
+     *
+     *@return number of erased slots
+     */
+    size_t erase(Uint128 key) {
+        iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    void clear() {
+        count = 0;
+        init(PASER_ADDR_MAP_MIN_SIZE);
+    }
+
+private:
+    void init(size_t size) {
+        slot empty;
+        empty.first = 0;
+        empty.second = V();
+        empty.used = false;
+        slots.assign(size, empty);
+        mask = size - 1;
+        bits = 0;
+        while (((size_t) 1 << bits) < size) {
+            bits++;
+        }
+    }
+
+    /**
+     * Get the first slot of the probe sequence of an address (Fibonacci hashing).
+     * The upper bits of the product depend on all bits of the address.
+     */
+    size_t home(Uint128 key) const {
+        return (u_int32_t) (key * 2654435769u) >> (32 - bits);
+    }
+
+    void rehash(size_t size) {
+        std::vector<slot> old;
+        old.swap(slots);
+        init(size);
+        for (typename std::vector<slot>::iterator it = old.begin(); it != old.end(); it++) {
+            if (!it->used) {
+                continue;
+            }
+            size_t i = home(it->first);
+            while (slots[i].used) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = *it;
+        }
+    }
+};
+
+#endif /* PASER_ADDR_MAP_H_ */
@@ -29,7 +29,7 @@ PASER_neighbor_table::PASER_neighbor_table(PASER_global *paser_global) {
 }
 
 PASER_neighbor_table::~PASER_neighbor_table() {
-    for (std::map<Uint128, PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
+    for (PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
         PASER_neighbor_entry *temp = it->second;
         delete temp;
     }
@@ -38,7 +38,7 @@ PASER_neighbor_table::~PASER_neighbor_table() {
 
 /* Find an neighbor entry given the destination address */
 PASER_neighbor_entry *PASER_neighbor_table::findNeigh(struct in_addr neigh_addr) {
-    std::map<Uint128, PASER_neighbor_entry*>::iterator it = neighbor_table_map.find(neigh_addr.s_addr);
+    PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.find(neigh_addr.s_addr);
     if (it != neighbor_table_map.end()) {
         if (it->second)
             return it->second;
@@ -68,7 +68,7 @@ PASER_neighbor_entry *PASER_neighbor_table::insert(struct in_addr neigh_addr, PA
 PASER_neighbor_entry *PASER_neighbor_table::update(PASER_neighbor_entry *entry, struct in_addr neigh_addr, PASER_timer_packet * deleteTimer,
         PASER_timer_packet * validTimer, int neighFlag, u_int8_t *root, u_int32_t IV, geo_pos position, u_int8_t *Cert, u_int32_t ifIndex) {
     if (entry) {
-        std::map<Uint128, PASER_neighbor_entry*>::iterator it = neighbor_table_map.find(entry->neighbor_addr.s_addr);
+        PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.find(entry->neighbor_addr.s_addr);
         if (it != neighbor_table_map.end()) {
             if ((*it).second == entry) {
                 neighbor_table_map.erase(it);
@@ -101,7 +101,7 @@ void PASER_neighbor_table::delete_entry(PASER_neighbor_entry *entry) {
         return;
 
     if (entry) {
-        std::map<Uint128, PASER_neighbor_entry*>::iterator it = neighbor_table_map.find(entry->neighbor_addr.s_addr);
+        PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.find(entry->neighbor_addr.s_addr);
         if (it != neighbor_table_map.end()) {
             if ((*it).second == entry) {
                 neighbor_table_map.erase(it);
@@ -224,50 +224,44 @@ void PASER_neighbor_table::updateNeighborTableIV(struct in_addr neigh, u_int32_t
 }
 
 int PASER_neighbor_table::checkAllCert() {
-    int i = 0;
-    bool found = true;
-    while (found) {
-        found = false;
-        int j = 0;
-        for (std::map<Uint128, PASER_neighbor_entry *>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
-            if (j >= i) {
-                PASER_neighbor_entry *nEntry = it->second;
-                if (pGlobal->getCrypto_sign()->checkOneCert((X509*) nEntry->Cert) == 0) {
-                    found = true;
-                    //delete neighbor
-                    delete_entry(nEntry);
-                    if (nEntry->deleteTimer) {
-                        timer_queue->timer_remove(nEntry->deleteTimer);
-                        delete nEntry->deleteTimer;
-                    }
-                    if (nEntry->validTimer) {
-                        timer_queue->timer_remove(nEntry->validTimer);
-                        delete nEntry->validTimer;
-                    }
-                    //delete all routes
-                    std::list<PASER_routing_entry*> routeList = pGlobal->getRouting_table()->getListWithNextHop(nEntry->neighbor_addr);
-                    for (std::list<PASER_routing_entry*>::iterator it2 = routeList.begin(); it2 != routeList.end(); it2++) {
-                        PASER_routing_entry *tempEntry = (PASER_routing_entry*) *it2;
-                        if (tempEntry) {
-                            pGlobal->getRouting_table()->delete_entry(tempEntry);
-                            if (tempEntry->deleteTimer) {
-                                timer_queue->timer_remove(tempEntry->deleteTimer);
-                                delete tempEntry->deleteTimer;
-                            }
-                            if (tempEntry->validTimer) {
-                                timer_queue->timer_remove(tempEntry->validTimer);
-                                delete tempEntry->validTimer;
-                            }
-                            delete tempEntry;
-                        }
-                    }
-                    delete nEntry;
-                    break;
+    // erase() moves the entries of the map, so collect the neighbors first
+    std::list<PASER_neighbor_entry*> invalidList;
+    for (PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
+        PASER_neighbor_entry *nEntry = it->second;
+        if (pGlobal->getCrypto_sign()->checkOneCert((X509*) nEntry->Cert) == 0) {
+            invalidList.push_back(nEntry);
+        }
+    }
+    for (std::list<PASER_neighbor_entry*>::iterator it = invalidList.begin(); it != invalidList.end(); it++) {
+        PASER_neighbor_entry *nEntry = *it;
+        //delete neighbor
+        delete_entry(nEntry);
+        if (nEntry->deleteTimer) {
+            timer_queue->timer_remove(nEntry->deleteTimer);
+            delete nEntry->deleteTimer;
+        }
+        if (nEntry->validTimer) {
+            timer_queue->timer_remove(nEntry->validTimer);
+            delete nEntry->validTimer;
+        }
+        //delete all routes
+        std::list<PASER_routing_entry*> routeList = pGlobal->getRouting_table()->getListWithNextHop(nEntry->neighbor_addr);
+        for (std::list<PASER_routing_entry*>::iterator it2 = routeList.begin(); it2 != routeList.end(); it2++) {
+            PASER_routing_entry *tempEntry = (PASER_routing_entry*) *it2;
+            if (tempEntry) {
+                pGlobal->getRouting_table()->delete_entry(tempEntry);
+                if (tempEntry->deleteTimer) {
+                    timer_queue->timer_remove(tempEntry->deleteTimer);
+                    delete tempEntry->deleteTimer;
+                }
+                if (tempEntry->validTimer) {
+                    timer_queue->timer_remove(tempEntry->validTimer);
+                    delete tempEntry->validTimer;
                 }
+                delete tempEntry;
             }
-            i++;
-            j++;
         }
+        delete nEntry;
     }
 //    PASER_routing_entry *routeToGW = pGlobal->getRouting_table()->getRouteToGw();
 //    if(routeToGW){
@@ -280,7 +274,7 @@ std::string PASER_neighbor_table::shortInfo() {
     std::stringstream out;
     int i = 1;
     out << "Neighbor Table: \n";
-    for (std::map<Uint128, PASER_neighbor_entry *>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
+    for (PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
         PASER_neighbor_entry *nEntry = it->second;
         out << " Neighbor Entry " << i;
         out << ": IP: " << inet_ntoa(nEntry->neighbor_addr);
@@ -299,7 +293,7 @@ std::string PASER_neighbor_table::detailedInfo() {
     std::stringstream out;
     int i = 1;
     out << "Neighbor Table: \n";
-    for (std::map<Uint128, PASER_neighbor_entry *>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
+    for (PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
         PASER_neighbor_entry *nEntry = it->second;
         out << " Neighbor Entry " << i << "\n";
         out << nEntry->detailedInfo();
@@ -309,7 +303,7 @@ std::string PASER_neighbor_table::detailedInfo() {
 }
 
 void PASER_neighbor_table::clearTable() {
-    for (std::map<Uint128, PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
+    for (PASER_addr_map<PASER_neighbor_entry*>::iterator it = neighbor_table_map.begin(); it != neighbor_table_map.end(); it++) {
         PASER_neighbor_entry *temp = it->second;
         delete temp;
     }
@@ -29,6 +29,7 @@ class PASER_neighbor_table;
 #include <list>
 
 #include "../config/PASER_defs.h"
+#include "PASER_addr_map.h"
 #include "PASER_neighbor_entry.h"
 #include "../config/PASER_global.h"
 #include "../timer_management/PASER_timer_queue.h"
@@ -46,7 +47,7 @@ private:
      * Key   - IP address of the node.
      * Value - Pointer to the node's neighbor entry.
      */
-    std::map<Uint128, PASER_neighbor_entry *> neighbor_table_map;
+    PASER_addr_map<PASER_neighbor_entry *> neighbor_table_map;
 
     PASER_timer_queue *timer_queue;
     PASER_global *pGlobal;
@@ -0,0 +1,152 @@
+/**
+ *\class  		PASER_prefix_trie
+ *@brief		Class implements the longest prefix match index of the subnetworks in the routing table.
+ *@ingroup 		Tables
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+#include "PASER_prefix_trie.h"
+
+PASER_prefix_trie::PASER_prefix_trie() {
+    root = new trie_node();
+}
+
+PASER_prefix_trie::~PASER_prefix_trie() {
+    deleteNode(root);
+}
+
+void PASER_prefix_trie::add(address_range range, PASER_routing_entry *entry) {
+    int prefixLen = getPrefixLength(range.mask);
+    if (prefixLen < 0) {
+        irregular.push_back(std::make_pair(range, entry));
+        return;
+    }
+    u_int32_t prefix = ntohl(range.ipaddr.s_addr);
+    trie_node *node = root;
+    for (int i = 0; i < prefixLen; i++) {
+        int bit = (prefix >> (31 - i)) & 1;
+        if (!node->child[bit]) {
+            node->child[bit] = new trie_node();
+        }
+        node = node->child[bit];
+    }
+    std::map<Uint128, trie_ref>::iterator it = node->entries.find(entry->dest_addr.s_addr);
+    if (it != node->entries.end() && it->second.entry == entry) {
+        it->second.count++;
+        return;
+    }
+    trie_ref ref;
+    ref.entry = entry;
+    ref.count = 1;
+    node->entries[entry->dest_addr.s_addr] = ref;
+}
+
+void PASER_prefix_trie::remove(address_range range, PASER_routing_entry *entry) {
+    int prefixLen = getPrefixLength(range.mask);
+    if (prefixLen < 0) {
+        for (std::list<std::pair<address_range, PASER_routing_entry*> >::iterator it = irregular.begin(); it != irregular.end(); it++) {
+            if (it->second == entry && it->first.ipaddr.s_addr == range.ipaddr.s_addr && it->first.mask.s_addr == range.mask.s_addr) {
+                irregular.erase(it);
+                return;
+            }
+        }
+        return;
+    }
+    // remember the path to delete the nodes which become empty
+    trie_node *path[33];
+    u_int32_t prefix = ntohl(range.ipaddr.s_addr);
+    trie_node *node = root;
+    path[0] = root;
+    for (int i = 0; i < prefixLen; i++) {
+        node = node->child[(prefix >> (31 - i)) & 1];
+        if (!node) {
+            return;
+        }
+        path[i + 1] = node;
+    }
+    std::map<Uint128, trie_ref>::iterator it = node->entries.find(entry->dest_addr.s_addr);
+    if (it == node->entries.end() || it->second.entry != entry) {
+        return;
+    }
+    if (--it->second.count > 0) {
+        return;
+    }
+    node->entries.erase(it);
+    for (int i = prefixLen; i > 0; i--) {
+        trie_node *n = path[i];
+        if (!n->entries.empty() || n->child[0] || n->child[1]) {
+            break;
+        }
+        path[i - 1]->child[(prefix >> (31 - (i - 1))) & 1] = NULL;
+        delete n;
+    }
+}
+
+PASER_routing_entry *PASER_prefix_trie::find(struct in_addr addr) {
+    PASER_routing_entry *best = NULL;
+    int bestLen = -1;
+    u_int32_t host = ntohl(addr.s_addr);
+    trie_node *node = root;
+    for (int i = 0; node; i++) {
+        if (!node->entries.empty()) {
+            best = node->entries.begin()->second.entry;
+            bestLen = i;
+        }
+        if (i == 32) {
+            break;
+        }
+        node = node->child[(host >> (31 - i)) & 1];
+    }
+    // a non-contiguous mask is preferred if it has more bits set
+    for (std::list<std::pair<address_range, PASER_routing_entry*> >::iterator it = irregular.begin(); it != irregular.end(); it++) {
+        address_range range = it->first;
+        if ((range.ipaddr.s_addr & range.mask.s_addr) != (addr.s_addr & range.mask.s_addr)) {
+            continue;
+        }
+        int len = __builtin_popcount(range.mask.s_addr);
+        if (len > bestLen || (len == bestLen && best && it->second->dest_addr.s_addr < best->dest_addr.s_addr)) {
+            best = it->second;
+            bestLen = len;
+        }
+    }
+    return best;
+}
+
+void PASER_prefix_trie::clear() {
+    deleteNode(root);
+    root = new trie_node();
+    irregular.clear();
+}
+
+int PASER_prefix_trie::getPrefixLength(struct in_addr mask) {
+    u_int32_t m = ntohl(mask.s_addr);
+    // a contiguous mask has the form 1..10..0
+    if ((~m & (~m + 1)) != 0) {
+        return -1;
+    }
+    return __builtin_popcount(m);
+}
+
+void PASER_prefix_trie::deleteNode(trie_node *node) {
+    if (!node) {
+        return;
+    }
+    deleteNode(node->child[0]);
+    deleteNode(node->child[1]);
+    delete node;
+}
@@ -0,0 +1,100 @@
+/**
+ *\class  		PASER_prefix_trie
+ *@brief		Class implements the longest prefix match index of the subnetworks in the routing table.
+ *@ingroup 		Tables
+ *\authors    	Eugen.Paul | Mohamad.Sbeiti \@paser.info
+ *
+ *\copyright   (C) 2012 Communication Networks Institute (CNI - Prof. Dr.-Ing. Christian Wietfeld)
+ *                  at Technische Universitaet Dortmund, Germany
+ *                  http:///www.kn.e-technik.tu-dortmund.de/
+ *
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ********************************************************************************
+ * This work is part of the secure wireless mesh networks framework, which is currently under development by CNI
+ ********************************************************************************/
+
+class PASER_prefix_trie;
+
+#ifndef PASER_PREFIX_TRIE_H_
+#define PASER_PREFIX_TRIE_H_
+
+#include <list>
+#include <map>
+
+#include "../config/PASER_defs.h"
+#include "PASER_routing_entry.h"
+
+/**
+ * Binary trie over the subnetworks (address_range) which are advertised by
+ * the nodes of the routing table. A lookup walks at most 32 levels and
+ * returns the node with the longest matching prefix. If several nodes
+ * advertise the same prefix, the node with the lowest IP address is returned.
+ * Ranges with a non-contiguous mask can't be stored in the trie and are
+ * checked one by one.
+ */
+class PASER_prefix_trie {
+private:
+    struct trie_ref {
+        PASER_routing_entry *entry;
+        int count;      ///< Number of ranges of the entry with this prefix
+    };
+
+    struct trie_node {
+        trie_node *child[2];
+        std::map<Uint128, trie_ref> entries;    ///< Nodes which advertise the prefix, by IP address
+
+        trie_node() {
+            child[0] = NULL;
+            child[1] = NULL;
+        }
+    };
+
+    trie_node *root;
+    std::list<std::pair<address_range, PASER_routing_entry*> > irregular;  ///< Ranges with a non-contiguous mask
+
+public:
+    PASER_prefix_trie();
+    ~PASER_prefix_trie();
+
+    /**
+     * Add a subnetwork of a routing entry.
+     */
+    void add(address_range range, PASER_routing_entry *entry);
+
+    /**
+     * Remove a subnetwork of a routing entry.
+     */
+    void remove(address_range range, PASER_routing_entry *entry);
+
+    /**
+     * Find the routing entry with the longest prefix which contains the address.
+     *
+     *@return routing entry or NULL if no subnetwork contains the address
+     */
+    PASER_routing_entry *find(struct in_addr addr);
+
+    /**
+     * Remove all subnetworks.
+     */
+    void clear();
+
+private:
+    /**
+     * Get the length of the prefix of a mask or -1 if the mask is non-contiguous.
+     */
+    static int getPrefixLength(struct in_addr mask);
+
+    /**
+     * Delete the node and all its children.
+     */
+    static void deleteNode(trie_node *node);
+};
+
+#endif /* PASER_PREFIX_TRIE_H_ */
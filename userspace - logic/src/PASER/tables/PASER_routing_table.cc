@@ -27,21 +27,23 @@ PASER_routing_table::PASER_routing_table(PASER_global *paser_global) {
     neighbor_table = paser_global->getNeighbor_table();
     pGlobal = paser_global;
 
+    defaultRouteSet = false;
+    defaultRouteGW.s_addr = 0;
+    defaultRouteIfIndex = 0;
+    defaultRouteMetric = 0;
+    kernelWritesSaved = 0;
 }
 
 PASER_routing_table::~PASER_routing_table() {
-    for (std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
+    deleteAllKernelRoutes();
+    for (PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
         PASER_routing_entry *temp = it->second;
-        in_addr tempMask;
-        tempMask.s_addr = PASER_ALLONES_ADDRESS_MASK;
-        pGlobal->getPASER_socket()->deleteRoute(temp->dest_addr, tempMask);
-        for(std::list<address_range>::iterator it = temp->AddL.begin(); it != temp->AddL.end(); it++){
-            address_range range = (address_range)*it;
-            pGlobal->getPASER_socket()->deleteRoute(range.ipaddr, range.mask);
-        }
         delete temp;
     }
     route_table.clear();
+    subnetworks.clear();
+    next_hops.clear();
+    gateways.clear();
 }
 
 void PASER_routing_table::init() {
@@ -53,16 +55,7 @@ void PASER_routing_table::destroy() {
 }
 
 PASER_routing_entry *PASER_routing_table::findAdd(struct in_addr addr) {
-    for (std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
-        PASER_routing_entry *tempEntry = it->second;
-        for (std::list<address_range>::iterator it2 = tempEntry->AddL.begin(); it2 != tempEntry->AddL.end(); it2++) {
-            address_range tempRange = (address_range) *it2;
-            if ((tempRange.ipaddr.s_addr & tempRange.mask.s_addr) == (addr.s_addr & tempRange.mask.s_addr)) {
-                return tempEntry;
-            }
-        }
-    }
-    return NULL;
+    return subnetworks.find(addr);
 }
 
 /* Find an routing entry given the destination address */
@@ -70,7 +63,7 @@ PASER_routing_entry *PASER_routing_table::findDest(struct in_addr dest_addr) {
     if (dest_addr.s_addr == 0xFFFFFFFF) {
         return findBestGW();
     }
-    std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.find(dest_addr.s_addr);
+    PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.find(dest_addr.s_addr);
     if (it != route_table.end()) {
         if (it->second) {
             return it->second;
@@ -95,7 +88,9 @@ PASER_routing_entry *PASER_routing_table::insert(struct in_addr dest_addr, struc
     entry->nxthop_addr = nxthop_addr;
     entry->seqnum = seqnum;
 
-    route_table.insert(std::make_pair(dest_addr.s_addr, entry));
+    if (route_table.insert(std::make_pair(dest_addr.s_addr, entry)).second) {
+        addToIndex(entry);
+    }
     PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Insert route to routing table IP:%s", inet_ntoa(dest_addr));
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_ROUTING_TABLE, " NextHop:%s , metric:%d\n", inet_ntoa(nxthop_addr), hopcnt);
     return entry;
@@ -104,31 +99,29 @@ PASER_routing_entry *PASER_routing_table::insert(struct in_addr dest_addr, struc
 PASER_routing_entry *PASER_routing_table::update(PASER_routing_entry *entry, struct in_addr dest_addr, struct in_addr nxthop_addr,
         PASER_timer_packet * deltimer, PASER_timer_packet * validtimer, u_int32_t seqnum, u_int8_t hopcnt, u_int8_t is_gw,
         std::list<address_range> AddL, u_int8_t *Cert) {
-    u_int32_t oldSeq = entry->seqnum;
-    u_int8_t *oldCert = NULL;
-    if (entry) {
-        std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.find(entry->dest_addr.s_addr);
-        if (it != route_table.end()) {
-            if ((*it).second == entry) {
-                oldSeq = (*it).second->seqnum;
+    if (!entry) {
+        return insert(dest_addr, nxthop_addr, deltimer, validtimer, seqnum, hopcnt, is_gw, AddL, Cert);
+    }
+    PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.find(entry->dest_addr.s_addr);
+    if (it != route_table.end()) {
+        if ((*it).second == entry) {
+            removeFromIndex(entry);
+            if (entry->dest_addr.s_addr != dest_addr.s_addr) {
                 route_table.erase(it);
-            } else {
-                PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "ERROR in routing table structure!\n");
             }
+        } else {
+            PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "ERROR in routing table structure!\n");
         }
-        if (entry->Cert && !Cert) {
-            oldCert = entry->Cert;
-            entry->Cert = NULL;
-        }
-        delete entry;
     }
 
-    entry = new PASER_routing_entry();
-    entry->AddL.assign(AddL.begin(), AddL.end());
-    if (oldCert) {
-        entry->Cert = oldCert;
-    } else
+    // keep the known certificate if no new one is given
+    if (Cert && entry->Cert != Cert) {
+        if (entry->Cert) {
+            X509_free((X509*) entry->Cert);
+        }
         entry->Cert = Cert;
+    }
+    entry->AddL.assign(AddL.begin(), AddL.end());
     entry->deleteTimer = deltimer;
     entry->validTimer = validtimer;
     entry->dest_addr = dest_addr;
@@ -138,13 +131,15 @@ PASER_routing_entry *PASER_routing_table::update(PASER_routing_entry *entry, str
     entry->isValid = 1;
     if (seqnum != 0) {
         entry->seqnum = seqnum;
-    } else {
-        entry->seqnum = oldSeq;
     }
 
     PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Update route in routing table IP:%s", inet_ntoa(dest_addr));
     PASER_LOG_WRITE_LOG_SHORT(PASER_LOG_ROUTING_TABLE, " NextHop:%s , metric:%d\n", inet_ntoa(nxthop_addr), hopcnt);
-    route_table.insert(std::make_pair(dest_addr.s_addr, entry));
+    std::pair<PASER_addr_map<PASER_routing_entry*>::iterator, bool> inserted = route_table.insert(
+            std::make_pair(dest_addr.s_addr, entry));
+    if (inserted.second || inserted.first->second == entry) {
+        addToIndex(entry);
+    }
     return entry;
 }
 
@@ -152,41 +147,136 @@ void PASER_routing_table::delete_entry(PASER_routing_entry *entry) {
     if (!entry)
         return;
 
-    std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.find(entry->dest_addr.s_addr);
+    PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.find(entry->dest_addr.s_addr);
     if (it != route_table.end()) {
         if ((*it).second == entry) {
             PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Delete route from routing table IP:%s\n", inet_ntoa(entry->dest_addr));
             route_table.erase(it);
+            removeFromIndex(entry);
         } else {
             PASER_LOG_WRITE_LOG(PASER_LOG_ERROR, "ERROR in Routing table structure!\n");
         }
     }
 }
 
+void PASER_routing_table::setNextHop(PASER_routing_entry *entry, struct in_addr nxthop_addr) {
+    if (!entry || entry->nxthop_addr.s_addr == nxthop_addr.s_addr) {
+        return;
+    }
+    if (!contains(entry)) {
+        entry->nxthop_addr = nxthop_addr;
+        return;
+    }
+    removeFromIndex(entry);
+    entry->nxthop_addr = nxthop_addr;
+    addToIndex(entry);
+}
+
+void PASER_routing_table::setValid(PASER_routing_entry *entry, u_int8_t isValid) {
+    if (!entry || entry->isValid == isValid) {
+        return;
+    }
+    removeGateway(entry);
+    entry->isValid = isValid;
+    if (contains(entry)) {
+        addGateway(entry);
+    }
+}
+
+void PASER_routing_table::setMetric(PASER_routing_entry *entry, u_int8_t hopcnt) {
+    if (!entry || entry->hopcnt == hopcnt) {
+        return;
+    }
+    removeGateway(entry);
+    entry->hopcnt = hopcnt;
+    if (contains(entry)) {
+        addGateway(entry);
+    }
+}
+
+bool PASER_routing_table::contains(PASER_routing_entry *entry) {
+    PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.find(entry->dest_addr.s_addr);
+    return it != route_table.end() && (*it).second == entry;
+}
+
+void PASER_routing_table::addToIndex(PASER_routing_entry *entry) {
+    for (std::list<address_range>::iterator it = entry->AddL.begin(); it != entry->AddL.end(); it++) {
+        subnetworks.add(*it, entry);
+    }
+    next_hops[entry->nxthop_addr.s_addr][entry->dest_addr.s_addr] = entry;
+    addGateway(entry);
+}
+
+void PASER_routing_table::removeFromIndex(PASER_routing_entry *entry) {
+    for (std::list<address_range>::iterator it = entry->AddL.begin(); it != entry->AddL.end(); it++) {
+        subnetworks.remove(*it, entry);
+    }
+    removeGateway(entry);
+    std::map<Uint128, std::map<Uint128, PASER_routing_entry*> >::iterator it = next_hops.find(entry->nxthop_addr.s_addr);
+    if (it == next_hops.end()) {
+        return;
+    }
+    std::map<Uint128, PASER_routing_entry*>::iterator entryIt = it->second.find(entry->dest_addr.s_addr);
+    if (entryIt != it->second.end() && entryIt->second == entry) {
+        it->second.erase(entryIt);
+    }
+    if (it->second.empty()) {
+        next_hops.erase(it);
+    }
+}
+
+void PASER_routing_table::addGateway(PASER_routing_entry *entry) {
+    if (entry->is_gw && entry->isValid) {
+        gateways[std::make_pair((u_int32_t) entry->hopcnt, entry->dest_addr.s_addr)] = entry;
+    }
+}
+
+void PASER_routing_table::removeGateway(PASER_routing_entry *entry) {
+    std::map<std::pair<u_int32_t, Uint128>, PASER_routing_entry*>::iterator it = gateways.find(
+            std::make_pair((u_int32_t) entry->hopcnt, entry->dest_addr.s_addr));
+    if (it != gateways.end() && it->second == entry) {
+        gateways.erase(it);
+        return;
+    }
+#ifdef PASER_ROUTING_TABLE_CHECK
+    // the metric must only be changed with setMetric()
+    for (it = gateways.begin(); it != gateways.end(); it++) {
+        if (it->second == entry) {
+            fprintf(stderr, "PASER_routing_table: gateway %s is indexed with metric %u, but has metric %u\n",
+                    inet_ntoa(entry->dest_addr), it->first.first, (u_int32_t) entry->hopcnt);
+            abort();
+        }
+    }
+#endif
+}
+
 PASER_routing_entry *PASER_routing_table::getRouteToGw() {
     return findBestGW();
 }
 
 PASER_routing_entry *PASER_routing_table::findBestGW() {
-    // Pointer to best Route to GW
-    PASER_routing_entry* tempBestRouteToGW = NULL;
-    u_int32_t bestMetric = 0;
-    for (std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
-        if ((*it).second->is_gw && (*it).second->isValid && (bestMetric == 0 || bestMetric > (*it).second->hopcnt)) {
-            tempBestRouteToGW = (*it).second;
-            bestMetric = tempBestRouteToGW->hopcnt;
-        }
+    if (gateways.empty()) {
+        return NULL;
+    }
+    return gateways.begin()->second;
+}
+
+std::list<PASER_routing_entry*> PASER_routing_table::getRoutesToGw() {
+    std::list<PASER_routing_entry*> returnList;
+    for (std::map<std::pair<u_int32_t, Uint128>, PASER_routing_entry*>::iterator it = gateways.begin(); it != gateways.end(); it++) {
+        returnList.push_back(it->second);
     }
-    return tempBestRouteToGW;
+    return returnList;
 }
 
 std::list<PASER_routing_entry*> PASER_routing_table::getListWithNextHop(struct in_addr nextHop) {
     std::list<PASER_routing_entry*> returnList;
-    for (std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
-        PASER_routing_entry *tempEntry = (*it).second;
-        if (tempEntry->nxthop_addr.s_addr == nextHop.s_addr) {
-            returnList.push_back(tempEntry);
-        }
+    std::map<Uint128, std::map<Uint128, PASER_routing_entry*> >::iterator it = next_hops.find(nextHop.s_addr);
+    if (it == next_hops.end()) {
+        return returnList;
+    }
+    for (std::map<Uint128, PASER_routing_entry*>::iterator entryIt = it->second.begin(); entryIt != it->second.end(); entryIt++) {
+        returnList.push_back(entryIt->second);
     }
     return returnList;
 }
@@ -197,42 +287,77 @@ void PASER_routing_table::updateKernelRoutingTable(struct in_addr dest_addr, str
     return;
 #endif
     bool done = false;
+    dropFailedKernelRoutes();
+    std::pair<Uint128, Uint128> key = std::make_pair(dest_addr.s_addr, netmask.s_addr);
+    std::map<std::pair<Uint128, Uint128>, kernel_route_entry>::iterator kIt = kernel_table.find(key);
     if (!del_entry) {
-        //delete old entry
-        pGlobal->getPASER_socket()->deleteRoute(dest_addr, netmask);
-        //add new entry
-        if (dest_addr.s_addr == forw_addr.s_addr) {
-            network_device dev = DEV_NR(pGlobal->getPaser_configuration()->getIfIdFromIfIndex(ifIndex));
-            done = pGlobal->getPASER_socket()->addRouteDev(dest_addr, netmask, &dev);
-            //add statistics
-            pGlobal->getPaserStatistic()->routingTableModificationAdd(dest_addr, dest_addr);
+        bool isDev = (dest_addr.s_addr == forw_addr.s_addr);
+        if (kIt != kernel_table.end() && kIt->second.isDev == isDev && kIt->second.nxthop_addr.s_addr == forw_addr.s_addr
+                && (!isDev || kIt->second.ifIndex == ifIndex)) {
+            // route is already programmed (old way: delete and add, each to kernel and ROM)
+            kIt->second.metric = metric;
+            kernelWritesSaved += 4;
+            PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is unchanged in kernel routing table\n", inet_ntoa(dest_addr));
         } else {
-            done = pGlobal->getPASER_socket()->addRouteVia(dest_addr, netmask, forw_addr);
-            pGlobal->getPaserStatistic()->routingTableModificationAdd(dest_addr, forw_addr);
-        }
-        if (done) {
-            PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is added to kernel routing table\n", inet_ntoa(dest_addr));
-        } else {
-            PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is not added to kernel routing table\n", inet_ntoa(dest_addr));
+            bool isNew = (kIt == kernel_table.end());
+            if (isDev) {
+                network_device dev = DEV_NR(pGlobal->getPaser_configuration()->getIfIdFromIfIndex(ifIndex));
+                done = pGlobal->getPASER_socket()->replaceRouteDev(dest_addr, netmask, &dev, isNew);
+                //add statistics
+                pGlobal->getPaserStatistic()->routingTableModificationAdd(dest_addr, dest_addr);
+            } else {
+                done = pGlobal->getPASER_socket()->replaceRouteVia(dest_addr, netmask, forw_addr, isNew);
+                pGlobal->getPaserStatistic()->routingTableModificationAdd(dest_addr, forw_addr);
+            }
+            if (done) {
+                kernel_route_entry kEntry;
+                kEntry.nxthop_addr = forw_addr;
+                kEntry.isDev = isDev;
+                kEntry.ifIndex = ifIndex;
+                kEntry.metric = metric;
+                kernel_table[key] = kEntry;
+                // new route: replace and ROM add instead of 4 messages. Else only replace.
+                kernelWritesSaved += isNew ? 2 : 3;
+                PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is added to kernel routing table\n", inet_ntoa(dest_addr));
+            } else {
+                PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is not added to kernel routing table\n", inet_ntoa(dest_addr));
+            }
         }
         //if necessary, update route to gateway
         PASER_routing_entry *rEntry = findDest(dest_addr);
         if (rEntry && rEntry->is_gw) {
             PASER_neighbor_entry *nEntry = neighbor_table->findNeigh(rEntry->nxthop_addr);
             if (nEntry && nEntry->isValid && nEntry->neighFlag && pGlobal->getRouting_table()->getRouteToGw() == rEntry) {
-                network_device dev = DEV_NR(pGlobal->getPaser_configuration()->getIfIdFromIfIndex(nEntry->ifIndex));
-                pGlobal->getPASER_socket()->deleteDefaultRoute();
-                pGlobal->getPASER_socket()->addDefaultRoute(nEntry->neighbor_addr, &dev, rEntry->hopcnt);
-                pGlobal->getPASER_socket()->setGWFlag(true);
+                if (defaultRouteSet && defaultRouteGW.s_addr == nEntry->neighbor_addr.s_addr && defaultRouteIfIndex == nEntry->ifIndex
+                        && defaultRouteMetric == rEntry->hopcnt) {
+                    // delete and add default route, set gateway flag
+                    kernelWritesSaved += 3;
+                } else {
+                    network_device dev = DEV_NR(pGlobal->getPaser_configuration()->getIfIdFromIfIndex(nEntry->ifIndex));
+                    pGlobal->getPASER_socket()->deleteDefaultRoute();
+                    pGlobal->getPASER_socket()->addDefaultRoute(nEntry->neighbor_addr, &dev, rEntry->hopcnt);
+                    pGlobal->getPASER_socket()->setGWFlag(true);
+                    defaultRouteSet = true;
+                    defaultRouteGW = nEntry->neighbor_addr;
+                    defaultRouteIfIndex = nEntry->ifIndex;
+                    defaultRouteMetric = rEntry->hopcnt;
+                }
             }
         }
     }
     else {
-        done = pGlobal->getPASER_socket()->deleteRoute(dest_addr, netmask);
-        //add statistic
-        pGlobal->getPaserStatistic()->routingTableModificationDelete(dest_addr);
+        if (kIt != kernel_table.end()) {
+            done = pGlobal->getPASER_socket()->deleteRoute(dest_addr, netmask);
+            kernel_table.erase(kIt);
+            //add statistic
+            pGlobal->getPaserStatistic()->routingTableModificationDelete(dest_addr);
+        } else {
+            // route is not programmed
+            kernelWritesSaved += 2;
+        }
         if(pGlobal->getRouting_table()->getRouteToGw() == NULL) {
             pGlobal->getPASER_socket()->setGWFlag(false);
+            resetDefaultRoute();
         }
         if(done) {
             PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is deleted from kernel routing table\n", inet_ntoa(dest_addr));
@@ -243,6 +368,41 @@ void PASER_routing_table::updateKernelRoutingTable(struct in_addr dest_addr, str
     }
 }
 
+void PASER_routing_table::deleteAllKernelRoutes() {
+    for (std::map<std::pair<Uint128, Uint128>, kernel_route_entry>::iterator it = kernel_table.begin(); it != kernel_table.end(); it++) {
+        in_addr tempAddr;
+        in_addr tempMask;
+        tempAddr.s_addr = it->first.first;
+        tempMask.s_addr = it->first.second;
+        pGlobal->getPASER_socket()->deleteRoute(tempAddr, tempMask);
+    }
+    kernel_table.clear();
+    resetDefaultRoute();
+}
+
+void PASER_routing_table::dropFailedKernelRoutes() {
+    std::list<std::pair<Uint128, Uint128> > failed;
+    pGlobal->getPASER_socket()->getFailedRoutes(&failed);
+    for (std::list<std::pair<Uint128, Uint128> >::iterator it = failed.begin(); it != failed.end(); it++) {
+        in_addr tempAddr;
+        tempAddr.s_addr = it->first;
+        PASER_LOG_WRITE_LOG(PASER_LOG_ROUTING_TABLE, "Route to %s is rejected by the kernel\n", inet_ntoa(tempAddr));
+        if (it->first == 0 && it->second == 0) {
+            // default route
+            resetDefaultRoute();
+            continue;
+        }
+        kernel_table.erase(*it);
+    }
+}
+
+void PASER_routing_table::resetDefaultRoute() {
+    defaultRouteSet = false;
+    defaultRouteGW.s_addr = 0;
+    defaultRouteIfIndex = 0;
+    defaultRouteMetric = 0;
+}
+
 void PASER_routing_table::updateRoutingTableAndSetTableTimeout(std::list<address_range> addList, struct in_addr src_addr, uint32_t seq,
         X509 *cert, struct in_addr nextHop, u_int8_t metric, int ifIndex, struct timeval now, u_int8_t gFlag, bool trusted) {
     PASER_routing_entry *entry = findDest(src_addr);
@@ -351,7 +511,7 @@ void PASER_routing_table::updateRoutingTableTimeout(struct in_addr src_addr, str
         validPack->handler = ROUTINGTABLE_VALID_ENTRY;
         entry->validTimer = validPack;
     }
-    entry->isValid = 1;
+    setValid(entry, 1);
     deletePack->timeout = timeval_add(now, PASER_ROUTE_DELETE_TIME);
     validPack->timeout = timeval_add(now, PASER_ROUTE_VALID_TIME);
     timer_queue->timer_add(deletePack);
@@ -385,7 +545,7 @@ void PASER_routing_table::updateRoutingTableTimeout(struct in_addr src_addr, u_i
     timer_queue->timer_add(validPack);
 
     entry->seqnum = seq;
-    entry->isValid = 1;
+    setValid(entry, 1);
 }
 
 void PASER_routing_table::updateRoutingTable(struct timeval now, std::list<address_list> addList, struct in_addr nextHop, int ifIndex) {
@@ -474,7 +634,7 @@ void PASER_routing_table::deleteFromKernelRoutingTableNodesWithNextHopAddr(struc
             delete validTimer;
             tempEntry->validTimer = NULL;
         }
-        tempEntry->isValid = 0;
+        setValid(tempEntry, 0);
     }
 
     PASER_neighbor_entry *nEntry = pGlobal->getNeighbor_table()->findNeigh(nextHop);
@@ -506,7 +666,7 @@ void PASER_routing_table::deleteFromKernelRoutingTableNodesWithNextHopAddr(struc
         delete validTimer;
         rEntry->validTimer = NULL;
     }
-    rEntry->isValid = 0;
+    setValid(rEntry, 0);
 }
 
 void PASER_routing_table::updateRouteLifetimes(struct in_addr dest_addr) {
@@ -584,7 +744,7 @@ void PASER_routing_table::updateRouteLifetimes(struct in_addr dest_addr) {
         validRoutingPack->handler = ROUTINGTABLE_VALID_ENTRY;
         rNeighborEntry->validTimer = validRoutingPack;
     }
-    rNeighborEntry->isValid = 1;
+    setValid(rNeighborEntry, 1);
     deleteRoutingPack->timeout = timeval_add(now, PASER_ROUTE_DELETE_TIME);
     validRoutingPack->timeout = timeval_add(now, PASER_ROUTE_VALID_TIME);
 
@@ -594,7 +754,7 @@ void PASER_routing_table::updateRouteLifetimes(struct in_addr dest_addr) {
 
 std::list<address_list> PASER_routing_table::getNeighborAddressList(int ifNr) {
     std::list<address_list> liste;
-    for (std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
+    for (PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
         PASER_routing_entry *rEntry = it->second;
         PASER_neighbor_entry *nEntry = neighbor_table->findNeigh(rEntry->nxthop_addr);
         if (rEntry->hopcnt == 1 && nEntry != NULL && nEntry->neighFlag && nEntry->isValid) {
@@ -734,7 +894,8 @@ std::string PASER_routing_table::shortInfo() {
     std::stringstream out;
     int i = 1;
     out << "Routing table:\n";
-    for (std::map<Uint128, PASER_routing_entry *>::iterator it = route_table.begin(); it != route_table.end(); it++) {
+    out << " Kernel routes: " << kernel_table.size() << " Saved kernel writes: " << kernelWritesSaved << "\n";
+    for (PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
         PASER_routing_entry *rEntry = it->second;
         out << " Routing Entry " << i;
         out << ": Dest IP: " << inet_ntoa(rEntry->dest_addr);
@@ -754,7 +915,7 @@ std::string PASER_routing_table::detailedInfo() {
     std::stringstream out;
     int i = 1;
     out << "Routing table:\n";
-    for (std::map<Uint128, PASER_routing_entry *>::iterator it = route_table.begin(); it != route_table.end(); it++) {
+    for (PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
         PASER_routing_entry *rEntry = it->second;
         out << " Routing Entry " << i << "\n";
         out << rEntry->detailedInfo();
@@ -764,16 +925,15 @@ std::string PASER_routing_table::detailedInfo() {
 }
 
 void PASER_routing_table::clearTable() {
+    // delete Routes from kernel routing table
+    deleteAllKernelRoutes();
     //reset RoutinigTable
-    for (std::map<Uint128, PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
+    for (PASER_addr_map<PASER_routing_entry*>::iterator it = route_table.begin(); it != route_table.end(); it++) {
         PASER_routing_entry *temp = it->second;
-        // delete Route from kernel routing table
-        pGlobal->getPASER_socket()->deleteRoute(temp->dest_addr, temp->dest_addr);
-        for (std::list<address_range>::iterator it2 = temp->AddL.begin(); it2 != temp->AddL.end(); it2++) {
-            address_range tempRange = (address_range) *it2;
-            pGlobal->getPASER_socket()->deleteRoute(tempRange.ipaddr, tempRange.mask);
-        }
         delete temp;
     }
     route_table.clear();
+    subnetworks.clear();
+    next_hops.clear();
+    gateways.clear();
 }
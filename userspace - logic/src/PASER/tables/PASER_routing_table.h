@@ -31,6 +31,8 @@ class PASER_routing_table;
 #include "openssl/x509.h"
 
 #include "PASER_routing_entry.h"
+#include "PASER_addr_map.h"
+#include "PASER_prefix_trie.h"
 #include "PASER_neighbor_table.h"
 #include "PASER_neighbor_entry.h"
 #include "../timer_management/PASER_timer_packet.h"
@@ -41,6 +43,17 @@ class PASER_routing_table;
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * The class represents a route which is programmed in the kernel routing table.
+ */
+class kernel_route_entry {
+public:
+    struct in_addr nxthop_addr;             ///< IP address of the next hop
+    bool isDev;                             ///< true if the route is set over a device (node is a neighbor)
+    int ifIndex;                            ///< Interface of the route
+    u_int32_t metric;                       ///< Metric of the route
+};
+
 /**
  * Implementation of the routing table.
  * Each valid route will be automatically added to the kernel routing table.
@@ -52,7 +65,46 @@ private:
      * Key   - IP address of the node.
      * Value - Pointer to the node's route entry.
      */
-    std::map<Uint128, PASER_routing_entry*> route_table;
+    PASER_addr_map<PASER_routing_entry*> route_table;
+
+    /**
+     * Index of the subnetworks of all entries of route_table
+     * for longest prefix match.
+     */
+    PASER_prefix_trie subnetworks;
+
+    /**
+     * Index of the entries of route_table by next hop.
+     * Key   - IP address of the next hop.
+     * Value - Map of the entries which are routed over the next hop, by IP address of the node.
+     */
+    std::map<Uint128, std::map<Uint128, PASER_routing_entry*> > next_hops;
+
+    /**
+     * Index of the valid routes to gateways, ordered from the best route.
+     * Key   - Pair of metric and IP address of the gateway.
+     * Value - Pointer to the gateway's route entry.
+     * The metric and the validity of indexed entries must only be changed
+     * with setMetric() and setValid(). If PASER_ROUTING_TABLE_CHECK is
+     * defined, removeGateway() checks that no entry is left in the index.
+     */
+    std::map<std::pair<u_int32_t, Uint128>, PASER_routing_entry*> gateways;
+
+    /**
+     * Shadow of the kernel routing table. Contains all routes which are
+     * programmed by PASER.
+     * Key   - Pair of destination IP address and network mask.
+     * Value - Programmed route.
+     */
+    std::map<std::pair<Uint128, Uint128>, kernel_route_entry> kernel_table;
+
+    bool defaultRouteSet;                   ///< Is the default route programmed
+    struct in_addr defaultRouteGW;          ///< Programmed default gateway
+    u_int32_t defaultRouteIfIndex;          ///< Interface of the programmed default route
+    u_int32_t defaultRouteMetric;           ///< Metric of the programmed default route
+
+    /// Number of netlink messages which are saved by the shadow table
+    u_int32_t kernelWritesSaved;
 
 private:
     PASER_timer_queue *timer_queue;
@@ -67,7 +119,8 @@ public:
     void destroy();
 
     /*
-     * Find a route to a node in subnetwork
+     * Find a route to a node in subnetwork. If several subnetworks
+     * contain the address, the one with the longest prefix wins.
      */
     PASER_routing_entry *findAdd(struct in_addr addr);
 
@@ -89,7 +142,8 @@ public:
             u_int8_t *Cert);
 
     /**
-     * Update a entry in the map
+     * Update a entry in the map. The entry is changed in place,
+     * so pointers to it stay valid.
      *
      *@param entry Pointer to the entry which will be updated.
      *@param dest_addr IP address of the node
@@ -115,6 +169,30 @@ public:
      */
     void delete_entry(PASER_routing_entry *entry);
 
+    /**
+     * Change the next hop of an entry.
+     *
+     *@param entry Pointer to the entry which will be changed.
+     *@param nxthop_addr IP address of the new next hop node
+     */
+    void setNextHop(PASER_routing_entry *entry, struct in_addr nxthop_addr);
+
+    /**
+     * Mark an entry valid or invalid.
+     *
+     *@param entry Pointer to the entry which will be changed.
+     *@param isValid 1 if the route is valid. Else 0.
+     */
+    void setValid(PASER_routing_entry *entry, u_int8_t isValid);
+
+    /**
+     * Change the metric of an entry.
+     *
+     *@param entry Pointer to the entry which will be changed.
+     *@param hopcnt Metric to the node
+     */
+    void setMetric(PASER_routing_entry *entry, u_int8_t hopcnt);
+
     /**
      * Get the shortest Route to Gateway.
      *
@@ -129,6 +207,13 @@ public:
      */
     PASER_routing_entry *findBestGW();
 
+    /**
+     * Get all valid Routes to Gateways.
+     *
+     *@return List of Routes to Gateways, the shortest Route first.
+     */
+    std::list<PASER_routing_entry*> getRoutesToGw();
+
     /**
      * Add a route to kernel routing table.
      *
@@ -231,11 +316,51 @@ public:
     int getSize() {
         return route_table.size();
     }
+
+    /**
+     * Get number of netlink messages which are not sent to kernel
+     * because the route was already programmed.
+     */
+    u_int32_t getKernelWritesSaved() {
+        return kernelWritesSaved;
+    }
     std::string shortInfo();
     std::string detailedInfo();
 
 private:
 
+    /**
+     * Delete all routes which are programmed by PASER from the kernel routing table.
+     */
+    void deleteAllKernelRoutes();
+
+    /**
+     * Delete the routes which are rejected by the kernel from the shadow of
+     * the kernel routing table, so that they are programmed again on the next update.
+     */
+    void dropFailedKernelRoutes();
+
+    /**
+     * Forget the programmed default route.
+     */
+    void resetDefaultRoute();
+
+    /**
+     * Add the entry to the subnetwork and next hop indexes or remove it.
+     */
+    void addToIndex(PASER_routing_entry *entry);
+    void removeFromIndex(PASER_routing_entry *entry);
+
+    /**
+     * Add the entry to the gateway index if it is a valid route to a gateway or remove it.
+     */
+    void addGateway(PASER_routing_entry *entry);
+    void removeGateway(PASER_routing_entry *entry);
+
+    /**
+     * Check whether the entry is stored in the routing table.
+     */
+    bool contains(PASER_routing_entry *entry);
 };
 
 #endif /* PASER_ROUTING_TABLE_H_ */
@@ -24,7 +24,7 @@
 #include "../config/PASER_defs.h"
 
 PASER_rreq_list::~PASER_rreq_list(){
-    for (std::map<Uint128, packet_rreq_entry * >::iterator it = rreq_list.begin(); it!=rreq_list.end(); it++){
+    for (PASER_addr_map<packet_rreq_entry*>::iterator it = rreq_list.begin(); it!=rreq_list.end(); it++){
         packet_rreq_entry *temp = it->second;
         delete temp;
     }
@@ -52,7 +52,7 @@ int PASER_rreq_list::pending_remove(packet_rreq_entry *entry){
     if (!entry)
         return 0;
 
-    std::map<Uint128, packet_rreq_entry * >::iterator it = rreq_list.find(entry->dest_addr.s_addr);
+    PASER_addr_map<packet_rreq_entry*>::iterator it = rreq_list.find(entry->dest_addr.s_addr);
     if (it != rreq_list.end())
     {
         if ((*it).second == entry)
@@ -68,7 +68,7 @@ int PASER_rreq_list::pending_remove(packet_rreq_entry *entry){
 }
 
 packet_rreq_entry* PASER_rreq_list::pending_find(struct in_addr dest_addr){
-    std::map<Uint128, packet_rreq_entry * >::iterator it = rreq_list.find(dest_addr.s_addr);
+    PASER_addr_map<packet_rreq_entry*>::iterator it = rreq_list.find(dest_addr.s_addr);
     if (it != rreq_list.end())
     {
         packet_rreq_entry *entry = it->second;
@@ -82,19 +82,23 @@ packet_rreq_entry* PASER_rreq_list::pending_find(struct in_addr dest_addr){
 }
 
 packet_rreq_entry* PASER_rreq_list::pending_find_addr_with_mask(struct in_addr dest_addr, struct in_addr dest_mask){
-    for(std::map<Uint128, packet_rreq_entry * >::iterator it = rreq_list.begin(); it!=rreq_list.end(); it++){
+    packet_rreq_entry *found = NULL;
+    for(PASER_addr_map<packet_rreq_entry*>::iterator it = rreq_list.begin(); it!=rreq_list.end(); it++){
         Uint128 tempAddr = it->first;
         packet_rreq_entry *entry = it->second;
         if( (tempAddr & dest_mask.s_addr) == (dest_addr.s_addr & dest_mask.s_addr) ){
-            return entry;
+            // the map is not ordered, return the same entry as a scan in address order
+            if (found == NULL || tempAddr < found->dest_addr.s_addr) {
+                found = entry;
+            }
         }
     }
-    return NULL;
+    return found;
 }
 
 void PASER_rreq_list::clearTable(){
     //reset Table
-    for (std::map<Uint128, packet_rreq_entry*>::iterator it = rreq_list.begin(); it != rreq_list.end(); it++) {
+    for (PASER_addr_map<packet_rreq_entry*>::iterator it = rreq_list.begin(); it != rreq_list.end(); it++) {
         packet_rreq_entry *temp = it->second;
         delete temp;
     }
@@ -104,7 +108,7 @@ void PASER_rreq_list::clearTable(){
 std::string PASER_rreq_list::detailedInfo(){
     std::stringstream out;
     out << "RREQ/RREP list:\n";
-    for (std::map<Uint128, packet_rreq_entry*>::iterator it = rreq_list.begin(); it != rreq_list.end(); it++) {
+    for (PASER_addr_map<packet_rreq_entry*>::iterator it = rreq_list.begin(); it != rreq_list.end(); it++) {
         packet_rreq_entry *temp = it->second;
         out << "  IP: " << inet_ntoa(temp->dest_addr) << " retries: " << temp->tries << "\n";
     }
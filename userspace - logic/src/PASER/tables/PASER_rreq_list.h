@@ -24,8 +24,8 @@
 #define PASER_RREQ_LIST_H_
 
 
-#include <map>
 #include "../config/PASER_defs.h"
+#include "PASER_addr_map.h"
 #include "../timer_management/PASER_timer_packet.h"
 
 #include <sstream>
@@ -61,7 +61,7 @@ private:
      * Key   - Destination IP Address
      * Value - Pointer to entry
      */
-    std::map<Uint128, packet_rreq_entry * > rreq_list;
+    PASER_addr_map<packet_rreq_entry *> rreq_list;
 
 public:
     ~PASER_rreq_list();
@@ -82,7 +82,8 @@ public:
     packet_rreq_entry *pending_find(struct in_addr dest_addr);
 
     /*
-     * Find an entry in the list with the given destination address and network mask
+     * Find an entry in the list with the given destination address and network mask.
+     * If several entries match, the entry with the lowest address is returned.
      */
     packet_rreq_entry* pending_find_addr_with_mask(struct in_addr dest_addr, struct in_addr dest_mask);
 
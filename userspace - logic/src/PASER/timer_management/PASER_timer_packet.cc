@@ -29,6 +29,8 @@ PASER_timer_packet::PASER_timer_packet(){
     timeout.tv_usec = 0;
     destAddr.s_addr = 0;
     data = NULL;
+    sslFD = -1;
+    queueIndex = -1;
 }
 
 PASER_timer_packet::~PASER_timer_packet(){
@@ -45,6 +45,7 @@ public:
     timeout_var handler;        ///< Type of timeout
     void *data;                 ///< pointer to data
     int32_t sslFD;              ///< Socket
+    int32_t queueIndex;         ///< Position of the timer in the timer queue. -1 if the timer is not queued.
 
 public:
     PASER_timer_packet();
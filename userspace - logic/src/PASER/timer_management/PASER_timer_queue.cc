@@ -22,12 +22,10 @@
 
 #include "PASER_timer_queue.h"
 
+#include <algorithm>
+
 PASER_timer_queue::~PASER_timer_queue(){
-    for (std::list<PASER_timer_packet *>::iterator it = timer_queue.begin(); it!=timer_queue.end(); it++){
-        PASER_timer_packet *temp = (PASER_timer_packet*)*it;
-        delete temp;
-    }
-    timer_queue.clear();
+    timer_clear();
 }
 
 bool compare_list(PASER_timer_packet *op1, PASER_timer_packet *op2){
@@ -42,14 +40,104 @@ bool compare_list(PASER_timer_packet *op1, PASER_timer_packet *op2){
     return result;
 }
 
-void PASER_timer_queue::timer_sort(){
-    timer_queue.sort(compare_list);
+void PASER_timer_queue::heap_set(u_int32_t i, PASER_timer_packet *t){
+    timer_heap[i] = t;
+    t->queueIndex = i;
+}
+
+void PASER_timer_queue::heap_up(u_int32_t i){
+    PASER_timer_packet *t = timer_heap[i];
+    while (i > 0) {
+        u_int32_t parent = (i - 1) / 2;
+        if (!compare_list(t, timer_heap[parent])) {
+            break;
+        }
+        heap_set(i, timer_heap[parent]);
+        i = parent;
+    }
+    heap_set(i, t);
+}
+
+void PASER_timer_queue::heap_down(u_int32_t i){
+    u_int32_t size = timer_heap.size();
+    PASER_timer_packet *t = timer_heap[i];
+    while (1) {
+        u_int32_t child = 2 * i + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && compare_list(timer_heap[child + 1], timer_heap[child])) {
+            child++;
+        }
+        if (!compare_list(timer_heap[child], t)) {
+            break;
+        }
+        heap_set(i, timer_heap[child]);
+        i = child;
+    }
+    heap_set(i, t);
+}
+
+void PASER_timer_queue::heap_erase(u_int32_t i){
+    PASER_timer_packet *t = timer_heap[i];
+    PASER_timer_packet *last = timer_heap.back();
+    timer_heap.pop_back();
+    timer_index.erase(get_key(t));
+    t->queueIndex = -1;
+    if (last == t) {
+        return;
+    }
+    heap_set(i, last);
+    heap_up(i);
+    heap_down(last->queueIndex);
+}
+
+std::size_t hash_value(const timer_key &key){
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.handler);
+    boost::hash_combine(seed, key.destAddr);
+    boost::hash_combine(seed, key.sslFD);
+    return seed;
+}
+
+timer_key PASER_timer_queue::get_key(PASER_timer_packet *t){
+    timer_key key;
+    key.handler = t->handler;
+    key.destAddr = 0;
+    key.sslFD = -1;
+    if (t->handler == SSL_timer) {
+        key.sslFD = t->sslFD;
+    }
+    else if (t->handler != KDC_REQUEST) {
+        key.destAddr = t->destAddr.s_addr;
+    }
+    return key;
+}
+
+bool PASER_timer_queue::is_queued(PASER_timer_packet *t){
+    return t->queueIndex >= 0 && (u_int32_t) t->queueIndex < timer_heap.size() && timer_heap[t->queueIndex] == t;
 }
 
 int PASER_timer_queue::timer_add(PASER_timer_packet *t){
+    if (!t) {
+        return 0;
+    }
+    // re-arm a queued timer
+    if (is_queued(t)) {
+        heap_up(t->queueIndex);
+        heap_down(t->queueIndex);
+#ifdef PASER_TIMER_QUEUE_CHECK
+        timer_check();
+#endif
+        return 1;
+    }
     timer_remove(t);
-    timer_queue.push_front(t);
-    timer_queue.sort(compare_list);
+    timer_heap.push_back(t);
+    heap_up(timer_heap.size() - 1);
+    timer_index[get_key(t)] = t;
+#ifdef PASER_TIMER_QUEUE_CHECK
+    timer_check();
+#endif
     return 1;
 }
 
@@ -57,60 +145,70 @@ int PASER_timer_queue::timer_remove(PASER_timer_packet *t){
 	if(!t){
 		return 0;
 	}
-	if(t->handler == KDC_REQUEST){
-        for (std::list<PASER_timer_packet *>::iterator it=timer_queue.begin(); it!=timer_queue.end(); it++){
-            PASER_timer_packet *temp = (PASER_timer_packet *)*it;
-            if(temp->handler == KDC_REQUEST){
-                timer_queue.erase(it);
-                //We need to delete the package here, because no other pointer points to the object.
-                delete temp;
-                return 1;
-            }
-        }
+	// the timer itself is queued
+	if (is_queued(t)) {
+	    heap_erase(t->queueIndex);
+#ifdef PASER_TIMER_QUEUE_CHECK
+	    timer_check();
+#endif
+	    return 1;
 	}
-	if(t->handler == SSL_timer){
-        for (std::list<PASER_timer_packet *>::iterator it=timer_queue.begin(); it!=timer_queue.end(); it++){
-            PASER_timer_packet *temp = (PASER_timer_packet *)*it;
-            if(temp->handler == SSL_timer && temp->sslFD == t->sslFD){
-                timer_queue.erase(it);
-                //We need to delete the package here, because no other pointer points to the object.
-                delete temp;
-                return 1;
-            }
-        }
+	// search for a queued timer with the same key
+	boost::unordered_map<timer_key, PASER_timer_packet *>::iterator it = timer_index.find(get_key(t));
+	if (it == timer_index.end()) {
+	    return 0;
 	}
-	else{
-        for (std::list<PASER_timer_packet *>::iterator it=timer_queue.begin(); it!=timer_queue.end(); it++){
-            PASER_timer_packet *temp = (PASER_timer_packet *)*it;
-            if(temp->handler == ROUTINGTABLE_DELETE_ENTRY ||
-                    temp->handler == ROUTINGTABLE_VALID_ENTRY ||
-                    temp->handler == NEIGHBORTABLE_DELETE_ENTRY ||
-                    temp->handler == NEIGHBORTABLE_VALID_ENTRY
-                    ){
-                if( temp->destAddr.s_addr == t->destAddr.s_addr &&
-                    temp->handler == t->handler){
-                    timer_queue.erase(it);
-                    return 1;
-                }
-            }
-            else{
-                if( temp->destAddr.s_addr == t->destAddr.s_addr &&
-                    temp->handler == t->handler){
-                    timer_queue.erase(it);
-                    return 1;
-                }
-            }
-        }
-        return 0;
+	PASER_timer_packet *temp = it->second;
+	heap_erase(temp->queueIndex);
+	if (temp->handler == KDC_REQUEST || temp->handler == SSL_timer) {
+	    //We need to delete the package here, because no other pointer points to the object.
+	    delete temp;
 	}
-	return 0;
+#ifdef PASER_TIMER_QUEUE_CHECK
+	timer_check();
+#endif
+	return 1;
+}
+
+void PASER_timer_queue::timer_clear(){
+    for (u_int32_t i = 0; i < timer_heap.size(); i++) {
+        PASER_timer_packet *temp = timer_heap[i];
+        temp->queueIndex = -1;
+        delete temp;
+    }
+    timer_heap.clear();
+    timer_index.clear();
+}
+
+void PASER_timer_queue::timer_check(){
+    if (timer_index.size() != timer_heap.size()) {
+        fprintf(stderr, "PASER_timer_queue: index size %u != heap size %u\n",
+                (u_int32_t) timer_index.size(), (u_int32_t) timer_heap.size());
+        abort();
+    }
+    for (u_int32_t i = 0; i < timer_heap.size(); i++) {
+        PASER_timer_packet *temp = timer_heap[i];
+        if (temp->queueIndex != (int32_t) i) {
+            fprintf(stderr, "PASER_timer_queue: timer at %u has queueIndex %d\n", i, temp->queueIndex);
+            abort();
+        }
+        if (i > 0 && compare_list(temp, timer_heap[(i - 1) / 2])) {
+            fprintf(stderr, "PASER_timer_queue: heap order violated at %u\n", i);
+            abort();
+        }
+        boost::unordered_map<timer_key, PASER_timer_packet *>::iterator it = timer_index.find(get_key(temp));
+        if (it == timer_index.end() || it->second != temp) {
+            fprintf(stderr, "PASER_timer_queue: timer at %u is not indexed\n", i);
+            abort();
+        }
+    }
 }
 
 PASER_timer_packet *PASER_timer_queue::timer_get_next_timer(){
-    if(timer_queue.size() == 0){
+    if(timer_heap.size() == 0){
         return NULL;
     }
-    return timer_queue.front();
+    return timer_heap[0];
 }
 
 long PASER_timer_queue::timeval_diff(struct timeval *t1, struct timeval *t2)
@@ -128,7 +226,10 @@ long PASER_timer_queue::timeval_diff(struct timeval *t1, struct timeval *t2)
 std::string PASER_timer_queue::shortInfo(){
     std::stringstream out;
     out << "Timer Queue:\n";
-    for (std::list<PASER_timer_packet *>::iterator it = timer_queue.begin(); it != timer_queue.end(); it++) {
+    // print timers in order of their timeouts
+    std::vector<PASER_timer_packet *> sorted(timer_heap);
+    std::sort(sorted.begin(), sorted.end(), compare_list);
+    for (std::vector<PASER_timer_packet *>::iterator it = sorted.begin(); it != sorted.end(); it++) {
         PASER_timer_packet *timerEntry = (PASER_timer_packet *)*it;
         out << " Timer Type: ";
         switch(timerEntry->handler){
@@ -24,18 +24,49 @@
 #define PASER_TIMER_QUEUE_H_
 
 #include "PASER_timer_packet.h"
-#include <list>
+#include <vector>
+#include <boost/unordered_map.hpp>
 
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * Key of a timer in the timer queue. The queue holds at most one timer per key.
+ * KDC_REQUEST timers share one key, SSL_timer timers are keyed by the SSL
+ * socket and all other timers by their type and address.
+ */
+struct timer_key{
+    int handler;
+    u_int32_t destAddr;
+    int sslFD;
+
+    bool operator==(const timer_key &other) const{
+        return handler == other.handler && destAddr == other.destAddr && sslFD == other.sslFD;
+    }
+};
+
+std::size_t hash_value(const timer_key &key);
+
+/**
+ * Timer queue of the node.
+ * The queue is a binary min-heap ordered by the timeout. Each queued
+ * PASER_timer_packet stores its position in the heap (queueIndex), so
+ * a timer can be re-armed or canceled without searching the queue.
+ * Timers are additionally indexed by their timer_key.
+ * If PASER_TIMER_QUEUE_CHECK is defined, the heap and the index are
+ * cross-checked after each modification of the queue.
+ */
 class PASER_timer_queue{
-public:
+private:
     /**
-     * List of node's timer.
+     * Heap of node's timer. timer_heap[0] is the next timeout.
      */
-	std::list<PASER_timer_packet *> timer_queue;
+    std::vector<PASER_timer_packet *> timer_heap;
+    /**
+     * Index of queued timers by their key.
+     */
+    boost::unordered_map<timer_key, PASER_timer_packet *> timer_index;
 
 public:
 	~PASER_timer_queue();
@@ -43,12 +74,9 @@ public:
 	void init();
 
 	/**
-	 * Sort the list by time
-	 */
-	void timer_sort();
-
-	/**
-	 * Add a new timer timer to the queue (lower to higher timeout order)
+	 * Add a new timer to the queue. If the timer is already in the queue
+	 * then it will be moved according to its new timeout.
+	 * A queued timer with the same type and address will be replaced.
 	 */
 	int timer_add(PASER_timer_packet *t);
 
@@ -57,6 +85,11 @@ public:
 	 */
 	int timer_remove(PASER_timer_packet *t);
 
+	/**
+	 * Remove all timers from the queue and free them.
+	 */
+	void timer_clear();
+
 	/**
 	 * This Function return next Timeout
 	 */
@@ -75,7 +108,7 @@ public:
 	/**
 	 * Get size of timer list
 	 */
-	int getTimerQueueSize(){return timer_queue.size();};
+	int getTimerQueueSize(){return timer_heap.size();};
 
 	std::ostream& operator<<(std::ostream& os)
 	{
@@ -85,6 +118,31 @@ public:
 
     std::string shortInfo();
     std::string detailedInfo();
+
+    /**
+     * Check the consistency of the heap and the index.
+     * Aborts the program if the queue is corrupted.
+     */
+    void timer_check();
+
+private:
+    /**
+     * Get the key of the timer <b>t</b>.
+     */
+    timer_key get_key(PASER_timer_packet *t);
+
+    /**
+     * Check whether the timer <b>t</b> is in the queue.
+     */
+    bool is_queued(PASER_timer_packet *t);
+
+    /**
+     * Remove the timer at position <b>i</b> from the heap.
+     */
+    void heap_erase(u_int32_t i);
+    void heap_up(u_int32_t i);
+    void heap_down(u_int32_t i);
+    void heap_set(u_int32_t i, PASER_timer_packet *t);
 };
 
 #endif /* PASER_TIMER_QUEUE_H_ */